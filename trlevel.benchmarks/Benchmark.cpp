@@ -0,0 +1,40 @@
+#include "Benchmark.h"
+
+namespace trlevel
+{
+    namespace benchmarks
+    {
+        BenchmarkResult run_benchmark(const std::string& name, std::size_t iterations, const std::function<void()>& function)
+        {
+            using namespace std::chrono;
+
+            // Run once first so that the timings don't include any first use costs.
+            function();
+
+            BenchmarkResult result;
+            result.name = name;
+            result.iterations = iterations;
+            result.min_ms = std::numeric_limits<double>::max();
+
+            double total = 0.0;
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                reset_peak_memory();
+                const auto start = high_resolution_clock::now();
+                function();
+                const double elapsed = duration<double, std::milli>(high_resolution_clock::now() - start).count();
+                total += elapsed;
+                result.min_ms = std::min(result.min_ms, elapsed);
+                result.peak_bytes = std::max(result.peak_bytes, peak_memory());
+            }
+            result.mean_ms = iterations ? total / iterations : 0.0;
+            return result;
+        }
+
+        void report(const BenchmarkResult& result)
+        {
+            std::cout << result.name << ": mean " << result.mean_ms << "ms, min " << result.min_ms << "ms, peak "
+                << result.peak_bytes / (1024.0 * 1024.0) << "MB (" << result.iterations << " iterations)" << std::endl;
+        }
+    }
+}
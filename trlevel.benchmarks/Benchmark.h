@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace trlevel
+{
+    namespace benchmarks
+    {
+        /// The timings from running a benchmark.
+        struct BenchmarkResult
+        {
+            std::string name;
+            std::size_t iterations{ 0u };
+            double mean_ms{ 0.0 };
+            double min_ms{ 0.0 };
+            /// The most memory allocated by a single run, above what was allocated before the run.
+            std::size_t peak_bytes{ 0u };
+        };
+
+        /// Start measuring peak memory from the amount that is currently allocated.
+        void reset_peak_memory();
+
+        /// Get the most memory that has been allocated since reset_peak_memory was called.
+        /// @returns The peak in bytes, not including what was allocated when the measurement started.
+        std::size_t peak_memory();
+
+        /// Run a function a number of times and measure how long each run takes and how much memory it allocates.
+        /// @param name The name to report the benchmark with.
+        /// @param iterations The number of times to run the function.
+        /// @param function The function to measure.
+        /// @returns The timings.
+        BenchmarkResult run_benchmark(const std::string& name, std::size_t iterations, const std::function<void()>& function);
+
+        /// Write the timings of a benchmark to the console.
+        /// @param result The timings to write.
+        void report(const BenchmarkResult& result);
+
+        /// Benchmarks for converting textiles to 32 bit colour.
+        void textile_benchmarks();
+
+        /// Benchmarks for loading generated levels of each version from stock size up to ten times larger.
+        void level_benchmarks();
+
+        /// Benchmarks for loading generated world DRM files and decoding their geometry and textures.
+        void drm_benchmarks();
+
+        /// Benchmarks for testing rays against collision triangles one at a time, in batches and through a hierarchy.
+        void picking_benchmarks();
+    }
+}
@@ -0,0 +1,204 @@
+#include "Benchmark.h"
+
+#include <filesystem>
+#include <fstream>
+
+#include <trview.common/Strings.h>
+#include <trview.lau/drm.h>
+#include <trview.lau/Texture.h>
+#include <trview.lau/WorldMesh.h>
+
+namespace trlevel
+{
+    namespace benchmarks
+    {
+        namespace
+        {
+            const std::size_t LoadIterations = 5;
+            const std::size_t AccessIterations = 20;
+
+            const uint32_t Vertices = 100000;
+            const uint32_t Meshes = 1000;
+            const uint32_t MeshIndices = 300;
+            const uint32_t Textures = 16;
+            const uint16_t TextureSize = 512;
+
+            /// A section of a generated DRM file.
+            struct SyntheticSection
+            {
+                trview::lau::SectionType type;
+                std::vector<uint32_t> links;
+                std::vector<uint8_t> payload;
+            };
+
+            template < typename T >
+            void append(std::vector<uint8_t>& data, const T& value)
+            {
+                const auto bytes = reinterpret_cast<const uint8_t*>(&value);
+                data.insert(data.end(), bytes, bytes + sizeof(T));
+            }
+
+            /// Generate a world DRM: the file header, the world vertices, a world mesh that links to every texture and
+            /// the textures, which alternate between DXT1 and DXT5.
+            std::vector<SyntheticSection> synthetic_drm(uint32_t scale, std::mt19937& random)
+            {
+                std::uniform_int_distribution<uint32_t> distribution;
+                std::vector<SyntheticSection> sections;
+
+                SyntheticSection file_header{ trview::lau::SectionType::Section };
+                file_header.payload.resize(16);
+                sections.push_back(file_header);
+
+                SyntheticSection vertices{ trview::lau::SectionType::Section };
+                vertices.payload.resize(Vertices * scale * sizeof(trview::lau::WorldVertex));
+                std::generate(vertices.payload.begin(), vertices.payload.end(), [&]() { return static_cast<uint8_t>(distribution(random)); });
+                sections.push_back(vertices);
+
+                const uint32_t num_textures = Textures * scale;
+                SyntheticSection world_mesh{ trview::lau::SectionType::WorldMesh };
+                for (uint32_t i = 0; i < num_textures; ++i)
+                {
+                    world_mesh.links.push_back(3 + i);
+                }
+                std::uniform_int_distribution<uint32_t> index_distribution(0, Vertices * scale - 1);
+                for (uint32_t m = 0; m < Meshes * scale; ++m)
+                {
+                    trview::lau::WorldMeshHeader header{ MeshIndices, 0xffffffff };
+                    append(world_mesh.payload, header);
+                    for (uint32_t i = 0; i < MeshIndices; ++i)
+                    {
+                        append(world_mesh.payload, static_cast<uint16_t>(index_distribution(random)));
+                    }
+                    append(world_mesh.payload, 0u);
+                }
+                sections.push_back(world_mesh);
+
+                for (uint32_t i = 0; i < num_textures; ++i)
+                {
+                    const auto format = i % 2 ? trview::lau::TextureFormat::DXT5 : trview::lau::TextureFormat::DXT1;
+                    const uint32_t length = (TextureSize / 4) * (TextureSize / 4) * (format == trview::lau::TextureFormat::DXT5 ? 16 : 8);
+
+                    SyntheticSection texture{ trview::lau::SectionType::Texture };
+                    append(texture.payload, 0x39444350u);
+                    append(texture.payload, format);
+                    append(texture.payload, length);
+                    append(texture.payload, 0u);
+                    append(texture.payload, TextureSize);
+                    append(texture.payload, TextureSize);
+                    append(texture.payload, 0u);
+                    for (uint32_t b = 0; b < length; ++b)
+                    {
+                        texture.payload.push_back(static_cast<uint8_t>(distribution(random)));
+                    }
+                    sections.push_back(texture);
+                }
+                return sections;
+            }
+
+            std::string write_synthetic_drm(const std::vector<SyntheticSection>& sections, const std::string& directory, const std::string& name)
+            {
+                std::vector<uint8_t> data;
+                append(data, 14u);
+                append(data, static_cast<uint32_t>(sections.size()));
+                for (uint32_t i = 0; i < sections.size(); ++i)
+                {
+                    const auto& section = sections[i];
+                    trview::lau::SectionHeader header{ static_cast<uint32_t>(section.payload.size()), section.type, static_cast<uint32_t>(section.links.size() * 8 * 32), i, 0 };
+                    append(data, header);
+                }
+                for (const auto& section : sections)
+                {
+                    for (const auto link : section.links)
+                    {
+                        append(data, link << 3);
+                        append(data, 0u);
+                    }
+                    data.insert(data.end(), section.payload.begin(), section.payload.end());
+                }
+
+                const auto filename = (std::filesystem::path(directory) / (name + ".drm")).string();
+                std::ofstream file(filename, std::ios::binary);
+                file.write(reinterpret_cast<const char*>(data.data()), data.size());
+                return filename;
+            }
+
+            double to_megabytes(uint64_t bytes)
+            {
+                return bytes / (1024.0 * 1024.0);
+            }
+
+            /// Write the timings of a benchmark along with the rate that it processed data at.
+            void report(const BenchmarkResult& result, uint64_t bytes)
+            {
+                benchmarks::report(result);
+                std::cout << result.name << ": " << to_megabytes(bytes) / (result.mean_ms / 1000.0) << "MB/s" << std::endl;
+            }
+        }
+
+        void drm_benchmarks()
+        {
+            const auto directory = std::filesystem::temp_directory_path() / "trlevel.benchmarks";
+            std::filesystem::create_directories(directory);
+
+            const uint32_t scales[] = { 1, 10, 40 };
+
+            std::mt19937 random(0);
+            uint64_t sum = 0;
+            for (const auto scale : scales)
+            {
+                const auto name = "DRM x" + std::to_string(scale);
+                const auto filename = write_synthetic_drm(synthetic_drm(scale, random), directory.string(), "world_" + std::to_string(scale));
+                const auto file_size = std::filesystem::file_size(filename);
+                std::cout << name << " (" << to_megabytes(file_size) << "MB)" << std::endl;
+
+                const auto wide_filename = trview::to_utf16(filename);
+                report(run_benchmark(name + " load_drm", LoadIterations, [&]()
+                {
+                    sum += trview::lau::load_drm(wide_filename)->graph.size();
+                }), file_size);
+
+                const auto drm = trview::lau::load_drm(wide_filename);
+                const auto& world_mesh_section = drm->sections[2];
+
+                uint64_t geometry_bytes = 0;
+                const auto world_mesh_result = run_benchmark(name + " load_world_mesh", AccessIterations, [&]()
+                {
+                    const auto mesh = trview::lau::load_world_mesh(*drm, world_mesh_section);
+                    geometry_bytes = mesh.vertices.size() * sizeof(trview::lau::WorldVertex);
+                    for (const auto& vertex : mesh.vertices)
+                    {
+                        sum += vertex.x + vertex.y + vertex.z;
+                    }
+                    for (const auto& indices : mesh.meshes)
+                    {
+                        geometry_bytes += indices.indices.size() * sizeof(uint16_t);
+                        for (const auto index : indices.indices)
+                        {
+                            sum += mesh.vertices[index].x;
+                        }
+                    }
+                    sum += mesh.textures.size();
+                });
+                report(world_mesh_result, geometry_bytes);
+
+                const auto textures = trview::lau::load_world_mesh(*drm, world_mesh_section).textures;
+                uint64_t texture_bytes = 0;
+                for (const auto texture : textures)
+                {
+                    texture_bytes += trview::lau::read_texture(drm->sections[texture]).data.size();
+                }
+                report(run_benchmark(name + " decode_textures (" + std::to_string(textures.size()) + " textures)", LoadIterations, [&]()
+                {
+                    for (const auto& pixels : trview::lau::decode_textures(*drm, textures))
+                    {
+                        sum += pixels[0];
+                    }
+                }), texture_bytes);
+
+                std::filesystem::remove(filename);
+            }
+
+            std::cout << "Checksum: " << sum << std::endl;
+        }
+    }
+}
@@ -0,0 +1,149 @@
+#include "Benchmark.h"
+#include "SyntheticLevel.h"
+
+#include <filesystem>
+
+#include <trlevel/trlevel.h>
+
+namespace trlevel
+{
+    namespace benchmarks
+    {
+        namespace
+        {
+            const std::size_t LoadIterations = 5;
+            const std::size_t AccessIterations = 20;
+            const uint16_t NoAnimation = 0xffff;
+
+            struct FrameReference
+            {
+                uint32_t offset;
+                uint32_t mesh_count;
+            };
+
+            /// Find the default frame and every animation frame of every model.
+            std::vector<FrameReference> model_frames(const ILevel& level)
+            {
+                std::vector<FrameReference> frames;
+                const auto animations = level.animations();
+                const uint32_t num_models = level.num_models();
+                for (uint32_t m = 0; m < num_models; ++m)
+                {
+                    const auto model = level.get_model(m);
+                    frames.push_back({ model.FrameOffset / 2, model.NumMeshes });
+                    if (model.Animation == NoAnimation)
+                    {
+                        continue;
+                    }
+
+                    // The generated models own the animations up to the first animation of the next model.
+                    const uint32_t end = m + 1 < num_models ? level.get_model(m + 1).Animation : static_cast<uint32_t>(animations.size());
+                    for (uint32_t a = model.Animation; a < end && a < animations.size(); ++a)
+                    {
+                        const auto& animation = animations[a];
+                        const uint32_t count = (animation.FrameEnd - animation.FrameStart) / std::max<uint32_t>(animation.FrameRate, 1) + 1;
+                        for (uint32_t f = 0; f < count; ++f)
+                        {
+                            frames.push_back({ animation.FrameOffset / 2 + f * animation.FrameSize, model.NumMeshes });
+                        }
+                    }
+                }
+                return frames;
+            }
+
+            double to_megabytes(uint64_t bytes)
+            {
+                return bytes / (1024.0 * 1024.0);
+            }
+
+            std::string version_name(LevelVersion version)
+            {
+                switch (version)
+                {
+                case LevelVersion::Tomb1:
+                    return "TR1";
+                case LevelVersion::Tomb2:
+                    return "TR2";
+                case LevelVersion::Tomb3:
+                    return "TR3";
+                case LevelVersion::Tomb4:
+                    return "TR4";
+                case LevelVersion::Tomb5:
+                    return "TR5";
+                }
+                return "Unknown";
+            }
+        }
+
+        void level_benchmarks()
+        {
+            const auto directory = std::filesystem::temp_directory_path() / "trlevel.benchmarks";
+            std::filesystem::create_directories(directory);
+
+            const LevelVersion versions[] = { LevelVersion::Tomb1, LevelVersion::Tomb2, LevelVersion::Tomb3, LevelVersion::Tomb4, LevelVersion::Tomb5 };
+            const uint32_t scales[] = { 1, 4, 10 };
+
+            uint64_t sum = 0;
+            for (const auto version : versions)
+            {
+                for (const auto scale : scales)
+                {
+                    const auto name = version_name(version) + " x" + std::to_string(scale);
+                    const auto filename = write_synthetic_level(scaled_level(version, scale), directory.string(), version_name(version) + "_" + std::to_string(scale));
+                    std::cout << name << " (" << to_megabytes(std::filesystem::file_size(filename)) << "MB)" << std::endl;
+
+                    report(run_benchmark(name + " load_level", LoadIterations, [&]()
+                    {
+                        sum += load_level(filename)->num_rooms();
+                    }));
+
+                    // Mesh generation is private to the level, so it is measured with a load that only reads the
+                    // models. Decoding the meshes is most of the cost of that load.
+                    LoadOptions models_only = LoadOptions::none();
+                    models_only.models = true;
+                    report(run_benchmark(name + " load_level (models only)", LoadIterations, [&]()
+                    {
+                        sum += load_level(filename, models_only)->num_models();
+                    }));
+
+                    const auto level = load_level(filename);
+
+                    std::vector<uint32_t> pixels;
+                    report(run_benchmark(name + " get_textile", AccessIterations, [&]()
+                    {
+                        for (uint32_t i = 0; i < level->num_textiles(); ++i)
+                        {
+                            level->get_textile(i, pixels);
+                            sum += pixels[0];
+                        }
+                    }));
+
+                    const auto frames = model_frames(*level);
+                    tr2_frame frame;
+                    report(run_benchmark(name + " get_frame (" + std::to_string(frames.size()) + " frames)", AccessIterations, [&]()
+                    {
+                        for (const auto& reference : frames)
+                        {
+                            level->get_frame(reference.offset, reference.mesh_count, frame);
+                            sum += frame.values.size();
+                        }
+                    }));
+
+                    // The same trim that trview does once the level has been uploaded, followed by releasing the rooms
+                    // once they have been generated.
+                    auto rooms_only = LoadOptions::none();
+                    rooms_only.rooms = true;
+                    std::cout << name << " memory: " << to_megabytes(level->memory_usage()) << "MB loaded, ";
+                    level->trim(rooms_only);
+                    std::cout << to_megabytes(level->memory_usage()) << "MB with rooms only, ";
+                    level->trim(LoadOptions::none());
+                    std::cout << to_megabytes(level->memory_usage()) << "MB trimmed" << std::endl;
+
+                    std::filesystem::remove(filename);
+                }
+            }
+
+            std::cout << "Checksum: " << sum << std::endl;
+        }
+    }
+}
@@ -0,0 +1,10 @@
+#include "Benchmark.h"
+
+int main()
+{
+    trlevel::benchmarks::textile_benchmarks();
+    trlevel::benchmarks::level_benchmarks();
+    trlevel::benchmarks::drm_benchmarks();
+    trlevel::benchmarks::picking_benchmarks();
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include "Benchmark.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// The global allocation functions are replaced so that the benchmarks can report how much memory
+// the code under test allocates, including allocations made on the thread pool. Each block has a
+// header in front of it that holds the size of the block.
+
+namespace
+{
+    // Keeps the memory after the header aligned as malloc would.
+    const std::size_t HeaderSize = alignof(std::max_align_t);
+
+    std::atomic<std::size_t> current_bytes{ 0u };
+    std::atomic<std::size_t> peak_bytes{ 0u };
+    std::atomic<std::size_t> baseline_bytes{ 0u };
+
+    void* allocate(std::size_t size) noexcept
+    {
+        auto block = static_cast<uint8_t*>(std::malloc(size + HeaderSize));
+        if (!block)
+        {
+            return nullptr;
+        }
+
+        *reinterpret_cast<std::size_t*>(block) = size;
+        const std::size_t current = current_bytes.fetch_add(size) + size;
+        std::size_t peak = peak_bytes.load();
+        while (current > peak && !peak_bytes.compare_exchange_weak(peak, current))
+        {
+        }
+        return block + HeaderSize;
+    }
+
+    void deallocate(void* memory) noexcept
+    {
+        if (!memory)
+        {
+            return;
+        }
+
+        auto block = static_cast<uint8_t*>(memory) - HeaderSize;
+        current_bytes.fetch_sub(*reinterpret_cast<std::size_t*>(block));
+        std::free(block);
+    }
+
+    void* allocate_or_throw(std::size_t size)
+    {
+        void* memory = allocate(size);
+        if (!memory)
+        {
+            throw std::bad_alloc();
+        }
+        return memory;
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    return allocate_or_throw(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return allocate_or_throw(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    deallocate(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    deallocate(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    deallocate(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    deallocate(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+    deallocate(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+    deallocate(memory);
+}
+
+namespace trlevel
+{
+    namespace benchmarks
+    {
+        void reset_peak_memory()
+        {
+            const std::size_t current = current_bytes.load();
+            baseline_bytes = current;
+            peak_bytes = current;
+        }
+
+        std::size_t peak_memory()
+        {
+            return peak_bytes.load() - baseline_bytes.load();
+        }
+    }
+}
@@ -0,0 +1,128 @@
+#include "Benchmark.h"
+
+#include <DirectXCollision.h>
+#include <trview.app/Geometry/CollisionTriangles.h>
+#include <trview.app/Geometry/TriangleBVH.h>
+
+using namespace DirectX::SimpleMath;
+
+namespace trlevel
+{
+    namespace benchmarks
+    {
+        namespace
+        {
+            const std::size_t Iterations = 20;
+            const std::size_t Rays = 1000;
+
+            struct Ray
+            {
+                Vector3 position;
+                Vector3 direction;
+            };
+
+            /// Generate a room sized set of small triangles with random orientations.
+            std::vector<trview::Triangle> random_triangles(std::size_t count, std::mt19937& random)
+            {
+                std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+                std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+                std::vector<trview::Triangle> triangles;
+                triangles.reserve(count);
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    const Vector3 v0(position(random), position(random), position(random));
+                    triangles.emplace_back(v0,
+                        v0 + Vector3(offset(random), offset(random), offset(random)),
+                        v0 + Vector3(offset(random), offset(random), offset(random)));
+                }
+                return triangles;
+            }
+
+            std::vector<Ray> random_rays(std::mt19937& random)
+            {
+                std::uniform_real_distribution<float> position(-15.0f, 15.0f);
+                std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+                std::vector<Ray> rays(Rays);
+                for (auto& ray : rays)
+                {
+                    ray.position = Vector3(position(random), position(random), position(random));
+                    ray.direction = Vector3(direction(random), direction(random), direction(random));
+                    ray.direction.Normalize();
+                }
+                return rays;
+            }
+
+            /// The test that Mesh::pick used before the collision triangles were stored for batch testing.
+            bool intersects_per_triangle(const std::vector<trview::Triangle>& triangles, const Ray& ray, float& distance)
+            {
+                using namespace DirectX::TriangleTests;
+
+                bool hit = false;
+                for (const auto& triangle : triangles)
+                {
+                    float triangle_distance = 0;
+                    if (ray.direction.Dot(triangle.normal) < 0 &&
+                        Intersects(ray.position, ray.direction, triangle.v0, triangle.v1, triangle.v2, triangle_distance) &&
+                        triangle_distance < distance)
+                    {
+                        distance = triangle_distance;
+                        hit = true;
+                    }
+                }
+                return hit;
+            }
+        }
+
+        void picking_benchmarks()
+        {
+            std::cout << "Picking (" << Rays << " rays, AVX2 " << (trview::collision_triangles_use_avx2() ? "enabled" : "disabled") << ")" << std::endl;
+
+            std::mt19937 random(0);
+            const auto rays = random_rays(random);
+            const std::size_t counts[] = { 1000, 10000, 50000 };
+
+            uint64_t hits = 0;
+            for (const auto count : counts)
+            {
+                const auto name = std::to_string(count) + " triangles";
+                const auto triangles = random_triangles(count, random);
+
+                report(run_benchmark(name + " per triangle", Iterations, [&]()
+                {
+                    for (const auto& ray : rays)
+                    {
+                        float distance = FLT_MAX;
+                        hits += intersects_per_triangle(triangles, ray, distance);
+                    }
+                }));
+
+                const trview::CollisionTriangles batched(triangles);
+                report(run_benchmark(name + " batched", Iterations, [&]()
+                {
+                    for (const auto& ray : rays)
+                    {
+                        float distance = FLT_MAX;
+                        hits += batched.intersects(ray.position, ray.direction, 0, batched.size(), distance);
+                    }
+                }));
+
+                report(run_benchmark(name + " build hierarchy", Iterations, [&]()
+                {
+                    hits += trview::TriangleBVH(triangles).size();
+                }));
+
+                const trview::TriangleBVH hierarchy(triangles);
+                report(run_benchmark(name + " hierarchy", Iterations, [&]()
+                {
+                    for (const auto& ray : rays)
+                    {
+                        float distance = FLT_MAX;
+                        hits += hierarchy.intersects(ray.position, ray.direction, distance);
+                    }
+                }));
+            }
+
+            std::cout << "Checksum: " << hits << std::endl;
+        }
+    }
+}
@@ -0,0 +1,894 @@
+#include "SyntheticLevel.h"
+
+#include <filesystem>
+#include <fstream>
+
+#include <zlib.h>
+
+#include <trlevel/DataWriter.h>
+#include <trlevel/trtypes.h>
+
+namespace trlevel
+{
+    namespace benchmarks
+    {
+        namespace
+        {
+            const uint32_t Tomb1Version = 0x20;
+            const uint32_t Tomb2Version = 0x2D;
+            const uint32_t Tomb3Version = 0xFF180038;
+            const uint32_t Tomb4Version = 0x00345254;
+            const uint8_t NoRoom = 0xff;
+            const int32_t SectorSize = 1024;
+            const int32_t RoomHeight = 4096;
+            const uint32_t StaticMeshes = 20;
+            const uint32_t SpriteSequences = 4;
+            const uint32_t SpritesPerSequence = 4;
+            const uint32_t SoundSampleSize = 2048;
+            const uint32_t MiscTextiles = 2;
+
+            /// Writes the sections of a level in the order that trlevel::Level reads them.
+            class SyntheticLevelWriter final
+            {
+            public:
+                explicit SyntheticLevelWriter(const SyntheticLevelOptions& options)
+                    : _options(options), _version(options.version), _random(options.seed)
+                {
+                    generate_floor_data();
+                }
+
+                std::vector<uint8_t> write()
+                {
+                    DataWriter file;
+                    if (_version >= LevelVersion::Tomb4)
+                    {
+                        write_tr4_file(file);
+                    }
+                    else
+                    {
+                        write_tr1_3_file(file);
+                    }
+                    return file.data();
+                }
+            private:
+                int32_t random(int32_t min, int32_t max)
+                {
+                    return std::uniform_int_distribution<int32_t>(min, max)(_random);
+                }
+
+                uint16_t random_index(uint32_t count)
+                {
+                    return static_cast<uint16_t>(random(0, static_cast<int32_t>(std::max(count, 1u)) - 1));
+                }
+
+                uint32_t object_textures() const
+                {
+                    return _options.textiles * 64;
+                }
+
+                uint32_t frame_size() const
+                {
+                    return 9 + (_version == LevelVersion::Tomb1 ? 1 : 0) + 2 * _options.model_meshes;
+                }
+
+                int32_t room_x(uint32_t room) const
+                {
+                    return static_cast<int32_t>(room * _options.room_width) * SectorSize;
+                }
+
+                void write_marker(DataWriter& writer, const char* marker, bool null_terminated)
+                {
+                    for (const char* c = marker; *c; ++c)
+                    {
+                        writer.write(static_cast<uint8_t>(*c));
+                    }
+
+                    if (null_terminated)
+                    {
+                        writer.write<uint8_t>(0);
+                    }
+                }
+
+                template < typename T >
+                void write_random_vector(DataWriter& writer, std::size_t count)
+                {
+                    std::vector<T> values(count);
+                    auto bytes = reinterpret_cast<uint8_t*>(values.data());
+                    for (std::size_t i = 0; i < count * sizeof(T); ++i)
+                    {
+                        bytes[i] = static_cast<uint8_t>(_random());
+                    }
+                    writer.write_vector(values);
+                }
+
+                void write_zeros(DataWriter& writer, std::size_t bytes)
+                {
+                    writer.write_vector(std::vector<uint8_t>(bytes));
+                }
+
+                void write_compressed(DataWriter& writer, const std::vector<uint8_t>& data)
+                {
+                    uLongf size = compressBound(static_cast<uLong>(data.size()));
+                    std::vector<uint8_t> compressed(size);
+                    compress2(&compressed[0], &size, data.data(), static_cast<uLong>(data.size()), Z_BEST_SPEED);
+                    compressed.resize(size);
+                    writer.write(static_cast<uint32_t>(data.size()));
+                    writer.write(static_cast<uint32_t>(compressed.size()));
+                    writer.write_vector(compressed);
+                }
+
+                void generate_floor_data()
+                {
+                    // Index 0 is never used by a sector.
+                    _floor_data.push_back(0);
+
+                    // Floor slant.
+                    _slant_index = static_cast<uint16_t>(_floor_data.size());
+                    _floor_data.push_back(0x8002);
+                    _floor_data.push_back(0x0102);
+
+                    // Floor triangulation.
+                    _triangulation_index = static_cast<uint16_t>(_floor_data.size());
+                    _floor_data.push_back(0x8007);
+                    _floor_data.push_back(0x1234);
+
+                    // One trigger per room that activates an entity.
+                    for (uint32_t i = 0; i < _options.rooms; ++i)
+                    {
+                        _trigger_indices.push_back(static_cast<uint16_t>(_floor_data.size()));
+                        _floor_data.push_back(0x8004);
+                        _floor_data.push_back(0x3E00);
+                        _floor_data.push_back(static_cast<uint16_t>(0x8000 | (random_index(_options.entities) & 0x3FF)));
+                    }
+                }
+
+                std::vector<tr_room_sector> generate_sectors(uint32_t room)
+                {
+                    std::vector<tr_room_sector> sectors(_options.room_width * _options.room_width);
+                    for (uint32_t i = 0; i < sectors.size(); ++i)
+                    {
+                        auto& sector = sectors[i];
+                        const uint16_t indices[] = { 0, _slant_index, _triangulation_index, _trigger_indices[room] };
+                        sector.floordata_index = indices[i % 4];
+                        sector.box_index = 0xffff;
+                        sector.room_below = NoRoom;
+                        sector.floor = 0;
+                        sector.room_above = NoRoom;
+                        sector.ceiling = static_cast<int8_t>(-RoomHeight / 256);
+                    }
+                    return sectors;
+                }
+
+                std::vector<tr_room_portal> generate_portals(uint32_t room)
+                {
+                    std::vector<tr_room_portal> portals;
+                    const int16_t edge = static_cast<int16_t>(_options.room_width * SectorSize);
+                    if (room + 1 < _options.rooms)
+                    {
+                        portals.push_back({ static_cast<uint16_t>(room + 1), { -1, 0, 0 }, { { edge, 0, 0 }, { edge, -1024, 0 }, { edge, -1024, 1024 }, { edge, 0, 1024 } } });
+                    }
+                    if (room > 0)
+                    {
+                        portals.push_back({ static_cast<uint16_t>(room - 1), { 1, 0, 0 }, { { 0, 0, 0 }, { 0, -1024, 0 }, { 0, -1024, 1024 }, { 0, 0, 1024 } } });
+                    }
+                    return portals;
+                }
+
+                tr_vertex random_room_vertex()
+                {
+                    const int32_t edge = static_cast<int32_t>(_options.room_width) * SectorSize;
+                    return { static_cast<int16_t>(random(0, edge)), static_cast<int16_t>(random(-RoomHeight, 0)), static_cast<int16_t>(random(0, edge)) };
+                }
+
+                template < typename Face >
+                Face random_face(uint32_t vertices)
+                {
+                    Face face{};
+                    for (auto& v : face.vertices)
+                    {
+                        v = random_index(vertices);
+                    }
+                    face.texture = random_index(object_textures());
+                    return face;
+                }
+
+                tr3_room_staticmesh random_room_static_mesh(uint32_t room)
+                {
+                    const auto position = random_room_vertex();
+                    return { room_x(room) + position.x, 0, position.z, 0, 0x7fff, 0, static_cast<uint16_t>(random_index(StaticMeshes)) };
+                }
+
+                void write_tr1_4_room(DataWriter& writer, uint32_t room)
+                {
+                    writer.write(tr1_4_room_info{ room_x(room), 0, 0, -RoomHeight });
+
+                    const uint32_t num_vertices = _options.room_faces + 4;
+                    DataWriter data;
+                    data.write(static_cast<int16_t>(num_vertices));
+                    for (uint32_t i = 0; i < num_vertices; ++i)
+                    {
+                        if (_version == LevelVersion::Tomb1)
+                        {
+                            data.write(tr_room_vertex{ random_room_vertex(), 4096 });
+                        }
+                        else
+                        {
+                            data.write(tr3_room_vertex{ random_room_vertex(), 4096, 0, 0x7fff });
+                        }
+                    }
+                    data.write(static_cast<int16_t>(_options.room_faces));
+                    for (uint32_t i = 0; i < _options.room_faces; ++i)
+                    {
+                        data.write(random_face<tr_face4>(num_vertices));
+                    }
+                    data.write(static_cast<int16_t>(_options.room_faces / 4));
+                    for (uint32_t i = 0; i < _options.room_faces / 4; ++i)
+                    {
+                        data.write(random_face<tr_face3>(num_vertices));
+                    }
+                    data.write<int16_t>(0);
+
+                    writer.write(static_cast<uint32_t>(data.data().size() / 2));
+                    writer.write_vector(data.data());
+
+                    writer.write_sized_vector<uint16_t>(generate_portals(room));
+                    writer.write(static_cast<uint16_t>(_options.room_width));
+                    writer.write(static_cast<uint16_t>(_options.room_width));
+                    writer.write_vector(generate_sectors(room));
+
+                    if (_version == LevelVersion::Tomb4)
+                    {
+                        writer.write<uint32_t>(0xff808080);
+                    }
+                    else
+                    {
+                        writer.write<int16_t>(4096);
+                        if (_version > LevelVersion::Tomb1)
+                        {
+                            writer.write<int16_t>(4096);
+                        }
+                    }
+
+                    if (_version == LevelVersion::Tomb2)
+                    {
+                        writer.write<int16_t>(0);
+                    }
+
+                    writer.write<uint16_t>(1);
+                    if (_version == LevelVersion::Tomb1)
+                    {
+                        writer.write(tr_room_light{ room_x(room), -1024, 1024, 4096, 2048 });
+                    }
+                    else if (_version == LevelVersion::Tomb4)
+                    {
+                        writer.write(tr4_room_light{ room_x(room), -1024, 1024, { 255, 255, 255 }, 1, 0, 255, 512.0f, 2048.0f, 0.0f, 0.0f, 0.0f, -1.0f, 0.0f });
+                    }
+                    else
+                    {
+                        writer.write(tr3_room_light{ room_x(room), -1024, 1024, { 255, 255, 255, 0 }, 4096, 2048 });
+                    }
+
+                    const uint16_t num_static_meshes = 2;
+                    writer.write(num_static_meshes);
+                    for (uint16_t i = 0; i < num_static_meshes; ++i)
+                    {
+                        const auto mesh = random_room_static_mesh(room);
+                        if (_version == LevelVersion::Tomb1)
+                        {
+                            writer.write(tr_room_staticmesh{ mesh.x, mesh.y, mesh.z, mesh.rotation, 4096, mesh.mesh_id });
+                        }
+                        else
+                        {
+                            writer.write(mesh);
+                        }
+                    }
+
+                    writer.write<int16_t>(-1);
+                    writer.write<int16_t>(0);
+
+                    if (_version >= LevelVersion::Tomb3)
+                    {
+                        writer.write<uint8_t>(0);
+                        writer.write<uint8_t>(0);
+                        writer.write<uint8_t>(0);
+                    }
+                }
+
+                void write_tr5_room(DataWriter& writer, uint32_t room)
+                {
+                    const auto sectors = generate_sectors(room);
+                    const auto portals = generate_portals(room);
+
+                    // Split the room geometry into two layers. The face vertex indices are relative to their layer.
+                    const uint32_t rectangles[] = { _options.room_faces / 2, _options.room_faces - _options.room_faces / 2 };
+                    const uint32_t triangles[] = { _options.room_faces / 8, _options.room_faces / 4 - _options.room_faces / 8 };
+                    const uint32_t vertices[] = { rectangles[0] + 4, rectangles[1] + 4 };
+
+                    DataWriter body;
+                    body.write(tr5_room_light{});
+
+                    tr5_room_header header{};
+                    header.start_sd_offset = static_cast<uint32_t>(body.data().size());
+                    body.write_vector(sectors);
+                    header.end_sd_offset = static_cast<uint32_t>(body.data().size());
+                    body.write_sized_vector<uint16_t>(portals);
+                    body.write<uint16_t>(0xcdcd);
+                    header.end_portal_offset = static_cast<uint32_t>(body.data().size());
+
+                    header.num_static_meshes = 2;
+                    for (uint16_t i = 0; i < header.num_static_meshes; ++i)
+                    {
+                        body.write(random_room_static_mesh(room));
+                    }
+
+                    header.num_layers = 2;
+                    header.layer_offset = static_cast<uint32_t>(body.data().size());
+                    for (uint32_t l = 0; l < header.num_layers; ++l)
+                    {
+                        tr5_room_layer layer{};
+                        layer.num_vertices = static_cast<uint16_t>(vertices[l]);
+                        layer.num_rectangles = static_cast<uint16_t>(rectangles[l]);
+                        layer.num_triangles = static_cast<uint16_t>(triangles[l]);
+                        body.write(layer);
+                    }
+
+                    header.poly_offset = static_cast<uint32_t>(body.data().size());
+                    header.poly_offset2 = header.poly_offset;
+                    for (uint32_t l = 0; l < header.num_layers; ++l)
+                    {
+                        for (uint32_t i = 0; i < rectangles[l]; ++i)
+                        {
+                            body.write(random_face<tr4_mesh_face4>(vertices[l]));
+                        }
+                        for (uint32_t i = 0; i < triangles[l]; ++i)
+                        {
+                            body.write(random_face<tr4_mesh_face3>(vertices[l]));
+                        }
+                    }
+
+                    header.vertices_offset = static_cast<uint32_t>(body.data().size());
+                    for (uint32_t l = 0; l < header.num_layers; ++l)
+                    {
+                        for (uint32_t i = 0; i < vertices[l]; ++i)
+                        {
+                            const auto v = random_room_vertex();
+                            body.write(tr5_room_vertex{ { static_cast<float>(v.x), static_cast<float>(v.y), static_cast<float>(v.z) }, { 0.0f, -1.0f, 0.0f }, 0xffffffff });
+                        }
+                    }
+                    header.vertices_size = static_cast<uint32_t>(body.data().size()) - header.vertices_offset;
+
+                    header.info = { room_x(room), 0, 0, 0, -RoomHeight };
+                    header.num_z_sectors = static_cast<uint16_t>(_options.room_width);
+                    header.num_x_sectors = static_cast<uint16_t>(_options.room_width);
+                    header.colour = 0xff808080;
+                    header.num_lights = 1;
+                    header.num_lights2 = 1;
+                    header.alternate_room = 0xffff;
+                    header.room_x = static_cast<float>(room_x(room));
+                    header.room_y_top = static_cast<float>(-RoomHeight);
+                    header.num_room_rectangles = _options.room_faces;
+                    header.num_room_triangles = _options.room_faces / 4;
+
+                    write_marker(writer, "XELA", false);
+                    writer.write(static_cast<uint32_t>(sizeof(header) + body.data().size()));
+                    writer.write(header);
+                    writer.write_vector(body.data());
+                }
+
+                void write_mesh(DataWriter& writer, uint32_t index)
+                {
+                    writer.write(tr_vertex{ 0, 0, 0 });
+                    writer.write<int32_t>(512);
+
+                    const uint32_t num_vertices = _options.mesh_faces + 4;
+                    writer.write(static_cast<int16_t>(num_vertices));
+                    for (uint32_t i = 0; i < num_vertices; ++i)
+                    {
+                        writer.write(tr_vertex{ static_cast<int16_t>(random(-512, 512)), static_cast<int16_t>(random(-512, 512)), static_cast<int16_t>(random(-512, 512)) });
+                    }
+
+                    // Meshes have either normals or lights.
+                    if (index % 2)
+                    {
+                        writer.write(static_cast<int16_t>(-static_cast<int16_t>(num_vertices)));
+                        for (uint32_t i = 0; i < num_vertices; ++i)
+                        {
+                            writer.write<int16_t>(4096);
+                        }
+                    }
+                    else
+                    {
+                        writer.write(static_cast<int16_t>(num_vertices));
+                        for (uint32_t i = 0; i < num_vertices; ++i)
+                        {
+                            writer.write(tr_vertex{ 0, -16384, 0 });
+                        }
+                    }
+
+                    writer.write(static_cast<int16_t>(_options.mesh_faces));
+                    for (uint32_t i = 0; i < _options.mesh_faces; ++i)
+                    {
+                        if (_version >= LevelVersion::Tomb4)
+                        {
+                            writer.write(random_face<tr4_mesh_face4>(num_vertices));
+                        }
+                        else
+                        {
+                            writer.write(random_face<tr_face4>(num_vertices));
+                        }
+                    }
+
+                    writer.write(static_cast<int16_t>(_options.mesh_faces));
+                    for (uint32_t i = 0; i < _options.mesh_faces; ++i)
+                    {
+                        if (_version >= LevelVersion::Tomb4)
+                        {
+                            writer.write(random_face<tr4_mesh_face3>(num_vertices));
+                        }
+                        else
+                        {
+                            writer.write(random_face<tr_face3>(num_vertices));
+                        }
+                    }
+
+                    if (_version < LevelVersion::Tomb4)
+                    {
+                        // No coloured rectangles or triangles.
+                        writer.write<int16_t>(0);
+                        writer.write<int16_t>(0);
+                    }
+                }
+
+                void write_frame(std::vector<uint16_t>& frames)
+                {
+                    const uint16_t header[] = { 0xff00, 0x0100, 0xfe00, 0x0100, 0x0000, 0x0200, 0, 0xfc00, 0 };
+                    frames.insert(frames.end(), std::begin(header), std::end(header));
+                    if (_version == LevelVersion::Tomb1)
+                    {
+                        frames.push_back(static_cast<uint16_t>(_options.model_meshes));
+                    }
+
+                    for (uint32_t i = 0; i < _options.model_meshes; ++i)
+                    {
+                        const uint16_t x = random_index(1024);
+                        const uint16_t y = random_index(1024);
+                        const uint16_t z = random_index(1024);
+                        const uint16_t data = static_cast<uint16_t>((x << 4) | (y >> 6));
+                        const uint16_t next = static_cast<uint16_t>(((y & 0x3f) << 10) | z);
+
+                        // Tomb Raider I has the words the other way around.
+                        if (_version == LevelVersion::Tomb1)
+                        {
+                            frames.push_back(next);
+                            frames.push_back(data);
+                        }
+                        else
+                        {
+                            frames.push_back(data);
+                            frames.push_back(next);
+                        }
+                    }
+                }
+
+                template < typename Animation >
+                void write_animations(DataWriter& writer, std::vector<uint16_t>& frames, std::vector<uint32_t>& model_frames)
+                {
+                    std::vector<Animation> animations;
+                    for (uint32_t m = 0; m < _options.models; ++m)
+                    {
+                        model_frames.push_back(static_cast<uint32_t>(frames.size() * 2));
+                        for (uint32_t a = 0; a < _options.animations_per_model; ++a)
+                        {
+                            Animation animation{};
+                            animation.FrameOffset = static_cast<uint32_t>(frames.size() * 2);
+                            animation.FrameRate = 1;
+                            animation.FrameSize = static_cast<uint8_t>(frame_size());
+                            animation.FrameStart = 0;
+                            animation.FrameEnd = static_cast<uint16_t>(_options.frames_per_animation - 1);
+                            animation.NextAnimation = static_cast<uint16_t>(m * _options.animations_per_model + (a + 1) % _options.animations_per_model);
+                            animations.push_back(animation);
+
+                            for (uint32_t f = 0; f < _options.frames_per_animation; ++f)
+                            {
+                                write_frame(frames);
+                            }
+                        }
+                    }
+                    writer.write_sized_vector<uint32_t>(animations);
+                }
+
+                void write_models(DataWriter& writer, const std::vector<uint32_t>& model_frames)
+                {
+                    writer.write(_options.models);
+                    for (uint32_t m = 0; m < _options.models; ++m)
+                    {
+                        tr_model model{};
+                        model.ID = m;
+                        model.NumMeshes = static_cast<uint16_t>(_options.model_meshes);
+                        model.StartingMesh = static_cast<uint16_t>((m * _options.model_meshes) % std::max(1u, _options.mesh_pointers - _options.model_meshes));
+                        model.MeshTree = m * (_options.model_meshes - 1) * 4;
+                        model.FrameOffset = model_frames[m];
+                        model.Animation = static_cast<uint16_t>(m * _options.animations_per_model);
+                        writer.write(model);
+                        if (_version == LevelVersion::Tomb5)
+                        {
+                            writer.write<uint16_t>(0xffff);
+                        }
+                    }
+                }
+
+                void write_object_textures(DataWriter& writer)
+                {
+                    writer.write(object_textures());
+                    for (uint32_t i = 0; i < object_textures(); ++i)
+                    {
+                        const uint8_t x = static_cast<uint8_t>((i % 4) * 64);
+                        const uint8_t y = static_cast<uint8_t>(((i / 4) % 4) * 64);
+                        const tr_object_texture_vert vertices[] = { { 1, x, 1, y }, { -1, static_cast<uint8_t>(x + 63), 1, y }, { -1, static_cast<uint8_t>(x + 63), -1, static_cast<uint8_t>(y + 63) }, { 1, x, -1, static_cast<uint8_t>(y + 63) } };
+                        const uint16_t tile = static_cast<uint16_t>(i % _options.textiles);
+                        if (_version < LevelVersion::Tomb4)
+                        {
+                            tr_object_texture texture{ 0, tile };
+                            std::copy(std::begin(vertices), std::end(vertices), texture.Vertices);
+                            writer.write(texture);
+                        }
+                        else
+                        {
+                            tr4_object_texture texture{ 0, tile, 0 };
+                            std::copy(std::begin(vertices), std::end(vertices), texture.Vertices);
+                            texture.Width = 63;
+                            texture.Height = 63;
+                            writer.write(texture);
+                            if (_version == LevelVersion::Tomb5)
+                            {
+                                writer.write<uint16_t>(0);
+                            }
+                        }
+                    }
+                }
+
+                void write_entities(DataWriter& writer)
+                {
+                    writer.write(_options.entities);
+                    for (uint32_t i = 0; i < _options.entities; ++i)
+                    {
+                        // The first entity is Lara in the first room.
+                        const uint32_t room = i ? random_index(_options.rooms) : 0;
+                        const int16_t type = !_options.entity_types.empty() ? _options.entity_types[i % _options.entity_types.size()] :
+                            static_cast<int16_t>(i ? 1 + random_index(_options.models - 1) : 0);
+                        const auto position = random_room_vertex();
+                        const int16_t angle = static_cast<int16_t>(random_index(4) * 16384);
+                        if (_version == LevelVersion::Tomb1)
+                        {
+                            writer.write(tr_entity{ type, static_cast<int16_t>(room), room_x(room) + position.x, 0, position.z, angle, -1, 0x3E00 });
+                        }
+                        else
+                        {
+                            writer.write(tr2_entity{ type, static_cast<int16_t>(room), room_x(room) + position.x, 0, position.z, angle, -1, -1, 0x3E00 });
+                        }
+                    }
+                }
+
+                std::vector<uint8_t> write_level_data()
+                {
+                    DataWriter writer;
+
+                    // Unused value.
+                    writer.write<uint32_t>(0);
+
+                    if (_version == LevelVersion::Tomb5)
+                    {
+                        writer.write(_options.rooms);
+                    }
+                    else
+                    {
+                        writer.write(static_cast<uint16_t>(_options.rooms));
+                    }
+
+                    for (uint32_t i = 0; i < _options.rooms; ++i)
+                    {
+                        if (_version == LevelVersion::Tomb5)
+                        {
+                            write_tr5_room(writer, i);
+                        }
+                        else
+                        {
+                            write_tr1_4_room(writer, i);
+                        }
+                    }
+
+                    writer.write_sized_vector<uint32_t>(_floor_data);
+
+                    // Meshes. Pointers past the number of meshes reuse the earlier meshes, as the stock levels do.
+                    DataWriter mesh_data;
+                    std::vector<uint32_t> mesh_offsets;
+                    for (uint32_t i = 0; i < _options.meshes; ++i)
+                    {
+                        mesh_offsets.push_back(static_cast<uint32_t>(mesh_data.data().size()));
+                        write_mesh(mesh_data, i);
+                    }
+                    writer.write(static_cast<uint32_t>(mesh_data.data().size() / 2));
+                    writer.write_vector(mesh_data.data());
+
+                    std::vector<uint32_t> mesh_pointers(_options.mesh_pointers);
+                    for (uint32_t i = 0; i < _options.mesh_pointers; ++i)
+                    {
+                        mesh_pointers[i] = mesh_offsets[i % mesh_offsets.size()];
+                    }
+                    writer.write_sized_vector<uint32_t>(mesh_pointers);
+
+                    std::vector<uint16_t> frames;
+                    std::vector<uint32_t> model_frames;
+                    if (_version >= LevelVersion::Tomb4)
+                    {
+                        write_animations<tr4_animation>(writer, frames, model_frames);
+                    }
+                    else
+                    {
+                        write_animations<tr_animation>(writer, frames, model_frames);
+                    }
+
+                    // No state changes, anim dispatches or anim commands.
+                    writer.write<uint32_t>(0);
+                    writer.write<uint32_t>(0);
+                    writer.write<uint32_t>(0);
+
+                    // Mesh tree. Every third node pushes the parent and the node after it pops it again.
+                    std::vector<uint32_t> mesh_tree;
+                    for (uint32_t m = 0; m < _options.models; ++m)
+                    {
+                        for (uint32_t n = 0; n + 1 < _options.model_meshes; ++n)
+                        {
+                            const uint32_t flags = n % 3 == 0 ? 2 : (n % 3 == 1 ? 1 : 0);
+                            mesh_tree.insert(mesh_tree.end(), { flags, 0, static_cast<uint32_t>(-128), 64 });
+                        }
+                    }
+                    writer.write_sized_vector<uint32_t>(mesh_tree);
+                    writer.write_sized_vector<uint32_t>(frames);
+
+                    write_models(writer, model_frames);
+
+                    writer.write(StaticMeshes);
+                    for (uint32_t i = 0; i < StaticMeshes; ++i)
+                    {
+                        const tr_bounding_box box{ -256, 256, -512, 0, -256, 256 };
+                        writer.write(tr_staticmesh{ i, static_cast<uint16_t>(i % _options.mesh_pointers), box, box, 2 });
+                    }
+
+                    if (_version < LevelVersion::Tomb3)
+                    {
+                        write_object_textures(writer);
+                    }
+
+                    if (_version >= LevelVersion::Tomb4)
+                    {
+                        // Tomb Raider V markers have a trailing null.
+                        write_marker(writer, "SPR", _version == LevelVersion::Tomb5);
+                    }
+
+                    writer.write(SpriteSequences * SpritesPerSequence);
+                    for (uint32_t i = 0; i < SpriteSequences * SpritesPerSequence; ++i)
+                    {
+                        writer.write(tr_sprite_texture{ static_cast<uint16_t>(i % _options.textiles), 0, 0, 255 + 256 * 32, 255 + 256 * 32, -128, -256, 128, 0 });
+                    }
+
+                    writer.write(SpriteSequences);
+                    for (uint32_t i = 0; i < SpriteSequences; ++i)
+                    {
+                        // Sprite sequence IDs start after the model IDs.
+                        writer.write(tr_sprite_sequence{ static_cast<int32_t>(_options.models + i), static_cast<int16_t>(-static_cast<int16_t>(SpritesPerSequence)), static_cast<int16_t>(i * SpritesPerSequence) });
+                    }
+
+                    // No cameras, flyby cameras, sound sources, boxes, overlaps, zones or animated textures.
+                    writer.write<uint32_t>(0);
+                    if (_version >= LevelVersion::Tomb4)
+                    {
+                        writer.write<uint32_t>(0);
+                    }
+                    writer.write<uint32_t>(0);
+                    writer.write<uint32_t>(0);
+                    writer.write<uint32_t>(0);
+                    writer.write<uint32_t>(0);
+
+                    if (_version >= LevelVersion::Tomb4)
+                    {
+                        // Animated texture uv count.
+                        writer.write<uint8_t>(0);
+                        write_marker(writer, "TEX", _version == LevelVersion::Tomb5);
+                    }
+
+                    if (_version >= LevelVersion::Tomb3)
+                    {
+                        write_object_textures(writer);
+                    }
+
+                    write_entities(writer);
+
+                    if (_version < LevelVersion::Tomb4)
+                    {
+                        // Light map.
+                        write_zeros(writer, 32 * 256);
+                    }
+
+                    if (_version == LevelVersion::Tomb1)
+                    {
+                        write_random_vector<tr_colour>(writer, 256);
+                    }
+
+                    if (_version >= LevelVersion::Tomb4)
+                    {
+                        // No AI objects.
+                        writer.write<uint32_t>(0);
+                    }
+
+                    if (_version < LevelVersion::Tomb4)
+                    {
+                        // No cinematic frames.
+                        writer.write<uint16_t>(0);
+                    }
+
+                    // No demo data.
+                    writer.write<uint16_t>(0);
+
+                    // Sound map.
+                    if (_version == LevelVersion::Tomb1)
+                    {
+                        write_zeros(writer, 256 * sizeof(int16_t));
+                    }
+                    else if (_version < LevelVersion::Tomb5)
+                    {
+                        write_zeros(writer, 370 * sizeof(int16_t));
+                    }
+                    else
+                    {
+                        write_zeros(writer, 450 * sizeof(int16_t));
+                    }
+
+                    // No sound details, sample data or sample indices.
+                    writer.write<uint32_t>(0);
+                    if (_version == LevelVersion::Tomb1)
+                    {
+                        writer.write<int32_t>(0);
+                    }
+                    writer.write<uint32_t>(0);
+
+                    return writer.data();
+                }
+
+                void write_tr1_3_file(DataWriter& file)
+                {
+                    switch (_version)
+                    {
+                    case LevelVersion::Tomb1:
+                        file.write(Tomb1Version);
+                        break;
+                    case LevelVersion::Tomb2:
+                        file.write(Tomb2Version);
+                        break;
+                    default:
+                        file.write(Tomb3Version);
+                        break;
+                    }
+
+                    if (_version > LevelVersion::Tomb1)
+                    {
+                        write_random_vector<tr_colour>(file, 256);
+                        write_random_vector<tr_colour4>(file, 256);
+                    }
+
+                    file.write(_options.textiles);
+                    write_random_vector<tr_textile8>(file, _options.textiles);
+                    if (_version > LevelVersion::Tomb1)
+                    {
+                        write_random_vector<tr_textile16>(file, _options.textiles);
+                    }
+
+                    file.write_vector(write_level_data());
+                }
+
+                void write_tr4_file(DataWriter& file)
+                {
+                    file.write(Tomb4Version);
+                    file.write(static_cast<uint16_t>(_options.textiles));
+                    file.write<uint16_t>(0);
+                    file.write<uint16_t>(0);
+
+                    DataWriter textile32;
+                    write_random_vector<tr_textile32>(textile32, _options.textiles);
+                    write_compressed(file, textile32.data());
+
+                    DataWriter textile16;
+                    write_random_vector<tr_textile16>(textile16, _options.textiles);
+                    write_compressed(file, textile16.data());
+
+                    DataWriter misc;
+                    write_random_vector<tr_textile32>(misc, MiscTextiles);
+                    write_compressed(file, misc.data());
+
+                    const auto level_data = write_level_data();
+                    if (_version == LevelVersion::Tomb4)
+                    {
+                        write_compressed(file, level_data);
+                    }
+                    else
+                    {
+                        // Lara type, weather type and padding.
+                        file.write<uint16_t>(0);
+                        file.write<uint16_t>(0);
+                        write_zeros(file, 28);
+
+                        // Tomb Raider V level data isn't compressed but still has both sizes.
+                        file.write(static_cast<uint32_t>(level_data.size()));
+                        file.write(static_cast<uint32_t>(level_data.size()));
+                        file.write_vector(level_data);
+                        write_zeros(file, 6);
+                    }
+
+                    file.write(_options.sound_samples);
+                    for (uint32_t i = 0; i < _options.sound_samples; ++i)
+                    {
+                        DataWriter sample;
+                        write_random_vector<uint8_t>(sample, SoundSampleSize);
+                        write_compressed(file, sample.data());
+                    }
+                }
+
+                SyntheticLevelOptions _options;
+                LevelVersion _version;
+                std::mt19937 _random;
+                std::vector<uint16_t> _floor_data;
+                uint16_t _slant_index{ 0 };
+                uint16_t _triangulation_index{ 0 };
+                std::vector<uint16_t> _trigger_indices;
+            };
+
+            std::string extension(LevelVersion version)
+            {
+                switch (version)
+                {
+                case LevelVersion::Tomb1:
+                    return ".PHD";
+                case LevelVersion::Tomb4:
+                    return ".TR4";
+                case LevelVersion::Tomb5:
+                    return ".TRC";
+                default:
+                    return ".TR2";
+                }
+            }
+        }
+
+        SyntheticLevelOptions scaled_level(LevelVersion version, uint32_t scale)
+        {
+            SyntheticLevelOptions options;
+            options.version = version;
+            options.seed = scale;
+            options.rooms *= scale;
+            options.meshes *= scale;
+            options.mesh_pointers *= scale;
+            options.models *= scale;
+            options.entities *= scale;
+            options.textiles *= scale;
+            options.sound_samples *= scale;
+            return options;
+        }
+
+        std::vector<uint8_t> write_synthetic_level(const SyntheticLevelOptions& options)
+        {
+            return SyntheticLevelWriter(options).write();
+        }
+
+        std::string write_synthetic_level(const SyntheticLevelOptions& options, const std::string& directory, const std::string& name)
+        {
+            const auto path = (std::filesystem::path(directory) / (name + extension(options.version))).string();
+            const auto data = write_synthetic_level(options);
+            std::ofstream file(path, std::ios::binary);
+            file.write(reinterpret_cast<const char*>(data.data()), data.size());
+            if (!file)
+            {
+                throw std::runtime_error("Failed to write synthetic level " + path);
+            }
+            return path;
+        }
+    }
+}
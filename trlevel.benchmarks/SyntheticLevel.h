@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <trlevel/LevelVersion.h>
+
+namespace trlevel
+{
+    namespace benchmarks
+    {
+        /// The contents of a generated level. The defaults are roughly the size of a stock level.
+        struct SyntheticLevelOptions
+        {
+            LevelVersion version{ LevelVersion::Tomb2 };
+            /// The number of rooms. Each room has a portal to the next room.
+            uint32_t rooms{ 100 };
+            /// The number of sectors along each side of a room.
+            uint32_t room_width{ 8 };
+            /// The number of rectangles in each room. There are a quarter as many triangles.
+            uint32_t room_faces{ 300 };
+            /// The number of distinct meshes in the mesh data.
+            uint32_t meshes{ 300 };
+            /// The number of mesh pointers. Pointers past the number of meshes reuse earlier meshes.
+            uint32_t mesh_pointers{ 900 };
+            /// The number of rectangles in each mesh. There are as many triangles.
+            uint32_t mesh_faces{ 20 };
+            /// The number of models. Model 0 is Lara.
+            uint32_t models{ 60 };
+            /// The number of meshes in each model.
+            uint32_t model_meshes{ 8 };
+            /// The number of animations for each model.
+            uint32_t animations_per_model{ 8 };
+            /// The number of frames in each animation.
+            uint32_t frames_per_animation{ 16 };
+            /// The number of entities. The first entity is Lara.
+            uint32_t entities{ 200 };
+            /// The types of the entities, used in turn. When this is empty the types are random models.
+            std::vector<int16_t> entity_types;
+            /// The number of textiles.
+            uint32_t textiles{ 12 };
+            /// The number of sound samples. Only stored in Tomb Raider IV and V levels.
+            uint32_t sound_samples{ 64 };
+            /// The seed for the random values in the level.
+            uint32_t seed{ 0 };
+        };
+
+        /// Get the options for a level of the specified version that is a multiple of the size of a stock level.
+        /// @param version The version of the level.
+        /// @param scale The multiple of the stock level size.
+        /// @returns The options.
+        SyntheticLevelOptions scaled_level(LevelVersion version, uint32_t scale);
+
+        /// Generate a level file.
+        /// @param options The contents of the level.
+        /// @returns The bytes of the level file.
+        std::vector<uint8_t> write_synthetic_level(const SyntheticLevelOptions& options);
+
+        /// Generate a level file and write it to disk.
+        /// @param options The contents of the level.
+        /// @param directory The directory to write the level to.
+        /// @param name The name of the file without an extension. The extension is chosen based on the version.
+        /// @returns The path to the level file.
+        std::string write_synthetic_level(const SyntheticLevelOptions& options, const std::string& directory, const std::string& name);
+    }
+}
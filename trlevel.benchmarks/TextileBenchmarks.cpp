@@ -0,0 +1,138 @@
+#include "Benchmark.h"
+
+#include <trlevel/trtypes.h>
+#include <trlevel/TextileConversion.h>
+
+namespace trlevel
+{
+    namespace benchmarks
+    {
+        namespace
+        {
+            const std::size_t Textiles = 16;
+            const std::size_t Pixels = 256 * 256;
+            const std::size_t Iterations = 20;
+
+            template < typename T >
+            std::vector<T> random_pixels(std::mt19937& random)
+            {
+                std::vector<T> pixels(Textiles * Pixels);
+                std::uniform_int_distribution<uint32_t> distribution;
+                std::generate(pixels.begin(), pixels.end(), [&]() { return static_cast<T>(distribution(random)); });
+                return pixels;
+            }
+
+            /// Checksum the output so the conversions can't be optimised away.
+            uint32_t checksum(const std::vector<uint32_t>& pixels)
+            {
+                uint32_t sum = 0;
+                for (auto pixel : pixels)
+                {
+                    sum ^= pixel;
+                }
+                return sum;
+            }
+        }
+
+        void textile_benchmarks()
+        {
+            std::cout << "Textile conversion (" << Textiles << " textiles, AVX2 " << (textile_conversion_uses_avx2() ? "enabled" : "disabled") << ")" << std::endl;
+
+            std::mt19937 random(0);
+            const auto pixels32 = random_pixels<uint32_t>(random);
+            const auto pixels16 = random_pixels<uint16_t>(random);
+            const auto pixels8 = random_pixels<uint8_t>(random);
+
+            std::vector<tr_colour4> palette(256);
+            std::uniform_int_distribution<uint32_t> distribution(0, 255);
+            for (auto& entry : palette)
+            {
+                entry = { static_cast<uint8_t>(distribution(random)), static_cast<uint8_t>(distribution(random)), static_cast<uint8_t>(distribution(random)), 0 };
+            }
+
+            std::vector<uint32_t> palette32(256);
+            for (uint32_t i = 1; i < 256; ++i)
+            {
+                palette32[i] = 0xff000000 | palette[i].Blue << 16 | palette[i].Green << 8 | palette[i].Red;
+            }
+
+            uint32_t sum = 0;
+
+            // The per pixel conversion that Level::get_textile used to do - a new vector per textile
+            // filled through a back inserter.
+            report(run_benchmark("32 bit per pixel", Iterations, [&]()
+            {
+                for (std::size_t t = 0; t < Textiles; ++t)
+                {
+                    std::vector<uint32_t> results;
+                    results.reserve(Pixels);
+                    const uint32_t* start = &pixels32[t * Pixels];
+                    std::transform(start, start + Pixels, std::back_inserter(results), [](uint32_t p) { return convert_textile32(p); });
+                    sum += checksum(results);
+                }
+            }));
+
+            std::vector<uint32_t> output(Pixels);
+            report(run_benchmark("32 bit kernel", Iterations, [&]()
+            {
+                for (std::size_t t = 0; t < Textiles; ++t)
+                {
+                    convert_textile32(&pixels32[t * Pixels], output.data(), Pixels);
+                    sum += checksum(output);
+                }
+            }));
+
+            report(run_benchmark("16 bit per pixel", Iterations, [&]()
+            {
+                for (std::size_t t = 0; t < Textiles; ++t)
+                {
+                    std::vector<uint32_t> results;
+                    results.reserve(Pixels);
+                    const uint16_t* start = &pixels16[t * Pixels];
+                    std::transform(start, start + Pixels, std::back_inserter(results), [](uint16_t p) { return convert_textile16(p); });
+                    sum += checksum(results);
+                }
+            }));
+
+            report(run_benchmark("16 bit kernel", Iterations, [&]()
+            {
+                for (std::size_t t = 0; t < Textiles; ++t)
+                {
+                    convert_textile16(&pixels16[t * Pixels], output.data(), Pixels);
+                    sum += checksum(output);
+                }
+            }));
+
+            report(run_benchmark("8 bit per pixel", Iterations, [&]()
+            {
+                for (std::size_t t = 0; t < Textiles; ++t)
+                {
+                    std::vector<uint32_t> results;
+                    results.reserve(Pixels);
+                    const uint8_t* start = &pixels8[t * Pixels];
+                    std::transform(start, start + Pixels, std::back_inserter(results), [&](uint8_t index)
+                    {
+                        if (index == 0)
+                        {
+                            return 0x00000000u;
+                        }
+                        const auto& entry = palette[index];
+                        return 0xff000000u | entry.Blue << 16 | entry.Green << 8 | entry.Red;
+                    });
+                    sum += checksum(results);
+                }
+            }));
+
+            report(run_benchmark("8 bit kernel", Iterations, [&]()
+            {
+                for (std::size_t t = 0; t < Textiles; ++t)
+                {
+                    convert_textile8(&pixels8[t * Pixels], palette32.data(), output.data(), Pixels);
+                    sum += checksum(output);
+                }
+            }));
+
+            std::cout << "Checksum: " << sum << std::endl;
+        }
+    }
+}
@@ -0,0 +1,166 @@
+#include <trlevel/IdIndex.h>
+#include <trlevel/Level.h>
+#include <trlevel.benchmarks/SyntheticLevel.h>
+
+using namespace trlevel;
+using namespace trlevel::benchmarks;
+
+namespace
+{
+    /// A level with entities of the specified types, in order.
+    std::unique_ptr<Level> level_with_entity_types(const std::vector<int16_t>& types)
+    {
+        SyntheticLevelOptions options;
+        options.rooms = 2;
+        options.room_faces = 10;
+        options.meshes = 4;
+        options.mesh_pointers = 8;
+        options.models = 4;
+        options.animations_per_model = 1;
+        options.frames_per_animation = 1;
+        options.entities = static_cast<uint32_t>(types.size());
+        options.entity_types = types;
+        options.textiles = 1;
+        options.sound_samples = 0;
+
+        const auto directory = std::filesystem::temp_directory_path() / "trlevel.tests";
+        std::filesystem::create_directories(directory);
+        return std::make_unique<Level>(write_synthetic_level(options, directory.string(), "entity_types"));
+    }
+
+    std::vector<uint32_t> to_vector(Span<uint32_t> span)
+    {
+        return std::vector<uint32_t>(span.begin(), span.end());
+    }
+}
+
+// Tests that IDs in the flat array and in the map can both be found, and that IDs that were never added are not found.
+TEST(IdIndex, DenseAndSparse)
+{
+    IdIndex index;
+    index.add(0, 10);
+    index.add(7, 11);
+    index.add(4095, 12);
+    index.add(4096, 13);
+    index.add(100000, 14);
+
+    uint32_t found = 0;
+    ASSERT_TRUE(index.find(0, found));
+    ASSERT_EQ(10u, found);
+    ASSERT_TRUE(index.find(7, found));
+    ASSERT_EQ(11u, found);
+    ASSERT_TRUE(index.find(4095, found));
+    ASSERT_EQ(12u, found);
+    ASSERT_TRUE(index.find(4096, found));
+    ASSERT_EQ(13u, found);
+    ASSERT_TRUE(index.find(100000, found));
+    ASSERT_EQ(14u, found);
+
+    found = 99;
+    ASSERT_FALSE(index.find(1, found));
+    ASSERT_FALSE(index.find(4094, found));
+    ASSERT_FALSE(index.find(4097, found));
+    ASSERT_FALSE(index.find(100001, found));
+    ASSERT_EQ(99u, found);
+}
+
+// Tests that the first index added for an ID is the one that is found, in both the flat array and the map.
+TEST(IdIndex, FirstIdWins)
+{
+    IdIndex index;
+    index.add(5, 1);
+    index.add(5, 2);
+    index.add(5000, 3);
+    index.add(5000, 4);
+
+    uint32_t found = 0;
+    ASSERT_TRUE(index.find(5, found));
+    ASSERT_EQ(1u, found);
+    ASSERT_TRUE(index.find(5000, found));
+    ASSERT_EQ(3u, found);
+}
+
+// Tests that negative IDs, which are stored as large unsigned values, go in the map and can be found.
+TEST(IdIndex, NegativeIds)
+{
+    IdIndex index;
+    index.add(static_cast<uint32_t>(-1), 1);
+    index.add(static_cast<uint32_t>(-200), 2);
+    index.add(static_cast<uint16_t>(-3), 3);
+
+    uint32_t found = 0;
+    ASSERT_TRUE(index.find(static_cast<uint32_t>(-1), found));
+    ASSERT_EQ(1u, found);
+    ASSERT_TRUE(index.find(static_cast<uint32_t>(-200), found));
+    ASSERT_EQ(2u, found);
+    ASSERT_TRUE(index.find(static_cast<uint16_t>(-3), found));
+    ASSERT_EQ(3u, found);
+    ASSERT_FALSE(index.find(static_cast<uint32_t>(-3), found));
+}
+
+// Tests that clearing the index removes IDs from both the flat array and the map.
+TEST(IdIndex, Clear)
+{
+    IdIndex index;
+    index.add(3, 1);
+    index.add(10000, 2);
+    index.clear();
+
+    uint32_t found = 0;
+    ASSERT_FALSE(index.find(3, found));
+    ASSERT_FALSE(index.find(10000, found));
+
+    index.add(3, 4);
+    ASSERT_TRUE(index.find(3, found));
+    ASSERT_EQ(4u, found);
+}
+
+// Tests that entities are grouped by type in the order that they are in the level, including types that are
+// repeated, types that are not next to each other and types that are too large or negative for the flat array.
+TEST(IdIndex, EntitiesByType)
+{
+    const std::vector<int16_t> types{ 0, 5, 5, -1, 5000, 5, -1, 2, 0 };
+    const auto level = level_with_entity_types(types);
+    ASSERT_EQ(types.size(), level->num_entities());
+
+    ASSERT_EQ((std::vector<uint32_t>{ 0, 8 }), to_vector(level->entities_by_type(0)));
+    ASSERT_EQ((std::vector<uint32_t>{ 1, 2, 5 }), to_vector(level->entities_by_type(5)));
+    ASSERT_EQ((std::vector<uint32_t>{ 3, 6 }), to_vector(level->entities_by_type(-1)));
+    ASSERT_EQ((std::vector<uint32_t>{ 4 }), to_vector(level->entities_by_type(5000)));
+    ASSERT_EQ((std::vector<uint32_t>{ 7 }), to_vector(level->entities_by_type(2)));
+    ASSERT_TRUE(level->entities_by_type(1).empty());
+    ASSERT_TRUE(level->entities_by_type(-2).empty());
+    ASSERT_TRUE(level->entities_by_type(5001).empty());
+
+    for (uint32_t i = 0; i < types.size(); ++i)
+    {
+        ASSERT_EQ(types[i], level->get_entity(i).TypeID);
+    }
+}
+
+// Tests that the first entity of a type is the first one in the level with that type.
+TEST(IdIndex, FindFirstEntityByType)
+{
+    const std::vector<int16_t> types{ 3, 5, -1, 5, 5000, -1, 3 };
+    const auto level = level_with_entity_types(types);
+
+    const auto expect_first = [&](int16_t type, uint32_t index)
+    {
+        tr2_entity entity;
+        ASSERT_TRUE(level->find_first_entity_by_type(type, entity));
+        const auto expected = level->get_entity(index);
+        ASSERT_EQ(expected.TypeID, entity.TypeID);
+        ASSERT_EQ(expected.x, entity.x);
+        ASSERT_EQ(expected.z, entity.z);
+        ASSERT_EQ(expected.Angle, entity.Angle);
+    };
+
+    expect_first(3, 0);
+    expect_first(5, 1);
+    expect_first(-1, 2);
+    expect_first(5000, 4);
+
+    tr2_entity entity;
+    ASSERT_FALSE(level->find_first_entity_by_type(0, entity));
+    ASSERT_FALSE(level->find_first_entity_by_type(4, entity));
+}
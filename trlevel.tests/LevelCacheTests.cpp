@@ -0,0 +1,315 @@
+#include <trlevel/LevelCache.h>
+#include <trlevel/Level.h>
+#include <trlevel.benchmarks/SyntheticLevel.h>
+
+using namespace trlevel;
+using namespace trlevel::benchmarks;
+
+namespace
+{
+    SyntheticLevelOptions small_level(LevelVersion version, uint32_t seed = 0)
+    {
+        SyntheticLevelOptions options;
+        options.version = version;
+        options.rooms = 5;
+        options.room_faces = 20;
+        options.meshes = 10;
+        options.mesh_pointers = 30;
+        options.models = 6;
+        options.animations_per_model = 2;
+        options.frames_per_animation = 4;
+        options.entities = 12;
+        options.textiles = 3;
+        options.sound_samples = 4;
+        options.seed = seed;
+        return options;
+    }
+
+    /// An empty directory for a test to use.
+    std::string directory(const std::string& name)
+    {
+        const auto path = std::filesystem::temp_directory_path() / "trlevel.tests" / name;
+        std::filesystem::remove_all(path);
+        std::filesystem::create_directories(path);
+        return path.string();
+    }
+
+    std::vector<std::filesystem::path> entries(const std::string& directory)
+    {
+        std::vector<std::filesystem::path> files;
+        for (const auto& item : std::filesystem::directory_iterator(directory))
+        {
+            files.push_back(item.path());
+        }
+        return files;
+    }
+
+    template <typename T>
+    bool same_bytes(const T& left, const T& right)
+    {
+        return std::memcmp(&left, &right, sizeof(T)) == 0;
+    }
+
+    void expect_same_level(const ILevel& expected, const ILevel& actual)
+    {
+        ASSERT_EQ(expected.get_version(), actual.get_version());
+
+        ASSERT_EQ(expected.num_textiles(), actual.num_textiles());
+        for (uint32_t i = 0; i < expected.num_textiles(); ++i)
+        {
+            ASSERT_EQ(expected.get_textile(i), actual.get_textile(i));
+        }
+
+        ASSERT_EQ(expected.num_rooms(), actual.num_rooms());
+        for (uint32_t i = 0; i < expected.num_rooms(); ++i)
+        {
+            const auto& expected_room = expected.room(i);
+            const auto& actual_room = actual.room(i);
+            ASSERT_TRUE(same_bytes(expected_room.info, actual_room.info));
+            ASSERT_EQ(expected_room.num_x_sectors, actual_room.num_x_sectors);
+            ASSERT_EQ(expected_room.num_z_sectors, actual_room.num_z_sectors);
+            ASSERT_EQ(expected_room.data.vertices.size(), actual_room.data.vertices.size());
+            ASSERT_EQ(expected_room.data.rectangles.size(), actual_room.data.rectangles.size());
+            ASSERT_EQ(expected_room.data.triangles.size(), actual_room.data.triangles.size());
+            ASSERT_EQ(expected_room.portals.size(), actual_room.portals.size());
+            ASSERT_EQ(expected_room.sector_list.size(), actual_room.sector_list.size());
+        }
+
+        ASSERT_EQ(expected.floor_data(), actual.floor_data());
+
+        ASSERT_EQ(expected.num_entities(), actual.num_entities());
+        for (uint32_t i = 0; i < expected.num_entities(); ++i)
+        {
+            ASSERT_TRUE(same_bytes(expected.get_entity(i), actual.get_entity(i)));
+        }
+
+        ASSERT_EQ(expected.num_models(), actual.num_models());
+        for (uint32_t i = 0; i < expected.num_models(); ++i)
+        {
+            ASSERT_TRUE(same_bytes(expected.get_model(i), actual.get_model(i)));
+        }
+
+        ASSERT_EQ(expected.num_mesh_pointers(), actual.num_mesh_pointers());
+        for (uint32_t i = 0; i < expected.num_mesh_pointers(); ++i)
+        {
+            const auto& expected_mesh = expected.mesh(i);
+            const auto& actual_mesh = actual.mesh(i);
+            ASSERT_EQ(expected_mesh.vertices.size(), actual_mesh.vertices.size());
+            ASSERT_EQ(expected_mesh.textured_rectangles.size(), actual_mesh.textured_rectangles.size());
+            ASSERT_EQ(expected_mesh.textured_triangles.size(), actual_mesh.textured_triangles.size());
+        }
+
+        ASSERT_EQ(expected.num_object_textures(), actual.num_object_textures());
+        ASSERT_EQ(expected.num_static_meshes(), actual.num_static_meshes());
+        ASSERT_EQ(expected.num_sound_samples(), actual.num_sound_samples());
+    }
+
+    /// Change one byte in the middle of a file.
+    void corrupt(const std::filesystem::path& path)
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekg(std::filesystem::file_size(path) / 2);
+        const char value = static_cast<char>(file.get());
+        file.seekp(std::filesystem::file_size(path) / 2);
+        file.put(static_cast<char>(value ^ 0x5A));
+    }
+}
+
+// Tests that a level loaded from the cache is the same as the level loaded from the file, for every version.
+TEST(LevelCache, SaveThenLoadGivesSameLevel)
+{
+    for (const auto version : { LevelVersion::Tomb1, LevelVersion::Tomb2, LevelVersion::Tomb3, LevelVersion::Tomb4, LevelVersion::Tomb5 })
+    {
+        const auto cache_directory = directory("cache");
+        const auto filename = write_synthetic_level(small_level(version), directory("levels"), "level");
+        SCOPED_TRACE(filename);
+
+        LevelCache cache(cache_directory, "build");
+        ASSERT_FALSE(cache.contains(filename));
+        const auto parsed = cache.load(filename);
+        ASSERT_TRUE(cache.contains(filename));
+        ASSERT_EQ(1u, entries(cache_directory).size());
+
+        const auto cached = cache.load(filename);
+        expect_same_level(*parsed, *cached);
+        expect_same_level(Level(filename), *cached);
+    }
+}
+
+// Tests that an entry written by a different build is not used.
+TEST(LevelCache, DifferentBuildMisses)
+{
+    const auto cache_directory = directory("cache");
+    const auto filename = write_synthetic_level(small_level(LevelVersion::Tomb2), directory("levels"), "level");
+
+    LevelCache cache(cache_directory, "build");
+    cache.load(filename);
+    ASSERT_TRUE(cache.contains(filename));
+
+    LevelCache other(cache_directory, "other build");
+    ASSERT_FALSE(other.contains(filename));
+    other.load(filename);
+    ASSERT_TRUE(other.contains(filename));
+    ASSERT_FALSE(cache.contains(filename));
+}
+
+// Tests that an entry written with different load options is not used.
+TEST(LevelCache, DifferentOptionsMisses)
+{
+    const auto cache_directory = directory("cache");
+    const auto filename = write_synthetic_level(small_level(LevelVersion::Tomb4), directory("levels"), "level");
+
+    LoadOptions options;
+    options.sound_samples = false;
+
+    LevelCache cache(cache_directory, "build");
+    cache.load(filename, options);
+    ASSERT_TRUE(cache.contains(filename, options));
+    ASSERT_FALSE(cache.contains(filename));
+
+    const auto level = cache.load(filename);
+    ASSERT_EQ(4u, level->num_sound_samples());
+    cache.wait();
+    ASSERT_EQ(2u, entries(cache_directory).size());
+}
+
+// Tests that a damaged entry is not used and that the level is loaded from the file and the entry replaced.
+TEST(LevelCache, CorruptedEntryFallsBackToParse)
+{
+    const auto cache_directory = directory("cache");
+    const auto filename = write_synthetic_level(small_level(LevelVersion::Tomb3), directory("levels"), "level");
+
+    LevelCache cache(cache_directory, "build");
+    cache.load(filename);
+    cache.wait();
+    ASSERT_EQ(1u, entries(cache_directory).size());
+    corrupt(entries(cache_directory)[0]);
+    ASSERT_FALSE(cache.contains(filename));
+
+    const auto level = cache.load(filename);
+    expect_same_level(Level(filename), *level);
+    ASSERT_TRUE(cache.contains(filename));
+}
+
+// Tests that a truncated entry is not used.
+TEST(LevelCache, TruncatedEntryFallsBackToParse)
+{
+    const auto cache_directory = directory("cache");
+    const auto filename = write_synthetic_level(small_level(LevelVersion::Tomb5), directory("levels"), "level");
+
+    LevelCache cache(cache_directory, "build");
+    cache.load(filename);
+    cache.wait();
+    const auto entry = entries(cache_directory)[0];
+    std::filesystem::resize_file(entry, std::filesystem::file_size(entry) / 2);
+    ASSERT_FALSE(cache.contains(filename));
+
+    const auto level = cache.load(filename);
+    expect_same_level(Level(filename), *level);
+}
+
+// Tests that geometry stored with an entry is loaded with the level and that storing it again replaces it.
+TEST(LevelCache, StoresGeometryWithLevel)
+{
+    const auto cache_directory = directory("cache");
+    const auto filename = write_synthetic_level(small_level(LevelVersion::Tomb3), directory("levels"), "level");
+
+    LevelCache cache(cache_directory, "build");
+    LevelCache::Entry entry;
+    std::vector<uint8_t> geometry{ 1 };
+    cache.load(filename, LoadOptions(), entry, geometry);
+    ASSERT_TRUE(geometry.empty());
+
+    cache.store_geometry(entry, { 1, 2, 3, 4, 5 });
+    cache.wait();
+    ASSERT_EQ(1u, entries(cache_directory).size());
+
+    LevelCache::Entry cached_entry;
+    const auto level = cache.load(filename, LoadOptions(), cached_entry, geometry);
+    expect_same_level(Level(filename), *level);
+    ASSERT_EQ(std::vector<uint8_t>({ 1, 2, 3, 4, 5 }), geometry);
+    ASSERT_EQ(entry.path, cached_entry.path);
+    ASSERT_EQ(entry.key, cached_entry.key);
+
+    cache.store_geometry(cached_entry, { 6, 7 });
+    cache.wait();
+    cache.load(filename, LoadOptions(), cached_entry, geometry);
+    ASSERT_EQ(std::vector<uint8_t>({ 6, 7 }), geometry);
+
+    // Loading without asking for the geometry still uses the entry.
+    expect_same_level(Level(filename), *cache.load(filename));
+}
+
+// Tests that geometry is not stored for a level that has no entry and that damaged geometry is not used.
+TEST(LevelCache, StoreGeometryNeedsValidEntry)
+{
+    const auto cache_directory = directory("cache");
+    const auto filename = write_synthetic_level(small_level(LevelVersion::Tomb4), directory("levels"), "level");
+
+    LevelCache cache(cache_directory, "build");
+    LevelCache::Entry entry;
+    std::vector<uint8_t> geometry;
+    cache.load(filename, LoadOptions(), entry, geometry);
+    cache.wait();
+    std::filesystem::remove(entries(cache_directory)[0]);
+
+    cache.store_geometry(entry, { 1, 2, 3 });
+    cache.wait();
+    ASSERT_TRUE(entries(cache_directory).empty());
+
+    cache.load(filename, LoadOptions(), entry, geometry);
+    cache.store_geometry(entry, std::vector<uint8_t>(64, 0x33));
+    cache.wait();
+
+    // Change the last byte, which is part of the geometry.
+    const auto path = entries(cache_directory)[0];
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(-1, std::ios::end);
+        file.put(0x44);
+    }
+    ASSERT_FALSE(cache.contains(filename));
+
+    cache.load(filename, LoadOptions(), entry, geometry);
+    ASSERT_TRUE(geometry.empty());
+}
+
+// Tests that the least recently used entries are removed when the cache is over the maximum size.
+TEST(LevelCache, EvictsLeastRecentlyUsed)
+{
+    const auto cache_directory = directory("cache");
+    const auto levels = directory("levels");
+    const auto first = write_synthetic_level(small_level(LevelVersion::Tomb2, 1), levels, "first");
+    const auto second = write_synthetic_level(small_level(LevelVersion::Tomb2, 2), levels, "second");
+    const auto third = write_synthetic_level(small_level(LevelVersion::Tomb2, 3), levels, "third");
+
+    // Find out how big an entry is so that the cache can be made to hold two of them.
+    const auto sizing_directory = directory("sizing");
+    uint64_t entry_size = 0;
+    {
+        LevelCache sizing(sizing_directory, "build");
+        sizing.load(first);
+        sizing.wait();
+        entry_size = std::filesystem::file_size(entries(sizing_directory)[0]);
+    }
+
+    LevelCache cache(cache_directory, "build", entry_size * 2 + entry_size / 2);
+    cache.load(first);
+    cache.wait();
+    cache.load(second);
+    cache.wait();
+
+    // Use the first level again so that the second level is the least recently used.
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_TRUE(cache.contains(first));
+    cache.load(first);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    cache.load(third);
+    cache.wait();
+
+    ASSERT_EQ(2u, entries(cache_directory).size());
+    ASSERT_TRUE(cache.contains(first));
+    ASSERT_FALSE(cache.contains(second));
+    ASSERT_TRUE(cache.contains(third));
+}
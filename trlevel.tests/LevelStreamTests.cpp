@@ -0,0 +1,216 @@
+#include <trlevel/LevelStream.h>
+#include <trlevel/LevelCache.h>
+#include <trlevel/LevelLoadException.h>
+#include <trlevel/trlevel.h>
+#include <trlevel.benchmarks/SyntheticLevel.h>
+
+#include <future>
+#include <numeric>
+
+using namespace trlevel;
+using namespace trlevel::benchmarks;
+
+namespace
+{
+    SyntheticLevelOptions small_level(LevelVersion version)
+    {
+        SyntheticLevelOptions options;
+        options.version = version;
+        options.rooms = 5;
+        options.room_faces = 20;
+        options.meshes = 10;
+        options.mesh_pointers = 30;
+        options.models = 6;
+        options.animations_per_model = 2;
+        options.frames_per_animation = 4;
+        options.entities = 12;
+        options.textiles = 3;
+        options.sound_samples = 4;
+        return options;
+    }
+
+    /// An empty directory for a test to use.
+    std::string directory(const std::string& name)
+    {
+        const auto path = std::filesystem::temp_directory_path() / "trlevel.tests" / name;
+        std::filesystem::remove_all(path);
+        std::filesystem::create_directories(path);
+        return path.string();
+    }
+
+    /// Take rooms from the stream until it has finished and then take whatever is left.
+    std::vector<uint32_t> take_all_rooms(LevelStream& stream)
+    {
+        std::vector<uint32_t> taken;
+        auto take = [&](const ILevel&, const std::vector<uint32_t>& rooms)
+        {
+            taken.insert(taken.end(), rooms.begin(), rooms.end());
+        };
+
+        while (!stream.finished())
+        {
+            stream.take_rooms(take);
+            std::this_thread::yield();
+        }
+        stream.take_rooms(take);
+        std::sort(taken.begin(), taken.end());
+        return taken;
+    }
+
+    std::vector<uint32_t> all_rooms(uint32_t count)
+    {
+        std::vector<uint32_t> rooms(count);
+        std::iota(rooms.begin(), rooms.end(), 0u);
+        return rooms;
+    }
+
+    const LevelVersion Versions[] =
+    {
+        LevelVersion::Tomb1, LevelVersion::Tomb2, LevelVersion::Tomb3, LevelVersion::Tomb4, LevelVersion::Tomb5
+    };
+}
+
+// Tests that every room is queued once for every version and that the queued rooms are the rooms of the loaded level.
+TEST(LevelStream, QueuesEveryRoom)
+{
+    const auto path = directory("stream");
+    for (const auto version : Versions)
+    {
+        const auto filename = write_synthetic_level(small_level(version), path, "stream");
+        SCOPED_TRACE(filename);
+
+        LevelStream stream([&](const LoadCallbacks& callbacks) { return load_level(filename, LoadOptions(), callbacks); });
+        ASSERT_EQ(all_rooms(5), take_all_rooms(stream));
+
+        const auto level = stream.level();
+        ASSERT_EQ(5u, level->num_rooms());
+    }
+}
+
+// Tests that the rooms can be taken once the floordata has been read, while the rest of the level is still loading,
+// and that they are the rooms that end up in the level.
+TEST(LevelStream, RoomsCanBeTakenBeforeLevelHasLoaded)
+{
+    const auto path = directory("stream_early");
+    for (const auto version : Versions)
+    {
+        const auto filename = write_synthetic_level(small_level(version), path, "stream");
+        SCOPED_TRACE(filename);
+
+        std::promise<void> rooms_ready;
+        std::promise<void> release;
+        auto released = release.get_future().share();
+
+        LevelStream stream([&, released](const LoadCallbacks& callbacks)
+        {
+            auto paused = callbacks;
+            paused.rooms_loaded = [&, released](const ILevel& level)
+            {
+                callbacks.rooms_loaded(level);
+                rooms_ready.set_value();
+                released.wait();
+            };
+            return load_level(filename, LoadOptions(), paused);
+        });
+
+        rooms_ready.get_future().wait();
+        const bool finished_early = stream.finished();
+        std::vector<uint32_t> taken;
+        std::vector<const tr3_room*> addresses(5, nullptr);
+        const bool took_rooms = stream.take_rooms([&](const ILevel& level, const std::vector<uint32_t>& rooms)
+        {
+            taken = rooms;
+            for (const auto room : rooms)
+            {
+                addresses[room] = &level.room(room);
+            }
+        });
+        release.set_value();
+
+        ASSERT_FALSE(finished_early);
+        ASSERT_TRUE(took_rooms);
+        std::sort(taken.begin(), taken.end());
+        ASSERT_EQ(all_rooms(5), taken);
+
+        const auto level = stream.level();
+        for (uint32_t i = 0; i < 5; ++i)
+        {
+            ASSERT_EQ(addresses[i], &level->room(i));
+        }
+    }
+}
+
+// Tests that rooms stay in the queue until the floordata has been read.
+TEST(LevelStream, RoomsAreQueuedUntilFloorDataHasBeenRead)
+{
+    const auto filename = write_synthetic_level(small_level(LevelVersion::Tomb2), directory("stream_queued"), "stream");
+    std::promise<void> rooms_parsed;
+    std::promise<void> release;
+    auto released = release.get_future().share();
+
+    LevelStream stream([&, released](const LoadCallbacks& callbacks)
+    {
+        auto level = load_level(filename);
+        callbacks.room_loaded(1, level->room(1));
+        callbacks.room_loaded(3, level->room(3));
+        rooms_parsed.set_value();
+        released.wait();
+        callbacks.rooms_loaded(*level);
+        return level;
+    });
+
+    rooms_parsed.get_future().wait();
+    const bool took_rooms = stream.take_rooms([](const auto&, const auto&) {});
+    release.set_value();
+
+    ASSERT_FALSE(took_rooms);
+    ASSERT_EQ(std::vector<uint32_t>({ 1, 3 }), take_all_rooms(stream));
+}
+
+// Tests that the rooms can't be taken once loading has failed and that the failure is passed on by level.
+TEST(LevelStream, LoadFailure)
+{
+    const auto filename = write_synthetic_level(small_level(LevelVersion::Tomb3), directory("stream_failure"), "stream");
+    LevelStream stream([&](const LoadCallbacks& callbacks) -> std::unique_ptr<ILevel>
+    {
+        auto level = load_level(filename);
+        callbacks.room_loaded(0, level->room(0));
+        callbacks.rooms_loaded(*level);
+        callbacks.load_failed();
+        throw LevelLoadException();
+    });
+
+    take_all_rooms(stream);
+    ASSERT_FALSE(stream.take_rooms([](const auto&, const auto&) {}));
+    ASSERT_THROW(stream.level(), LevelLoadException);
+}
+
+// Tests that a level that can't be read is reported by level.
+TEST(LevelStream, LoadFailureFromFile)
+{
+    const auto path = directory("stream_truncated");
+    const auto filename = write_synthetic_level(small_level(LevelVersion::Tomb4), path, "stream");
+    std::filesystem::resize_file(filename, std::filesystem::file_size(filename) / 2);
+
+    LevelStream stream([&](const LoadCallbacks& callbacks) { return load_level(filename, LoadOptions(), callbacks); });
+    ASSERT_THROW(stream.level(), LevelLoadException);
+    ASSERT_FALSE(stream.take_rooms([](const auto&, const auto&) {}));
+}
+
+// Tests that the rooms are queued when the level is loaded from the level cache as well as when it is parsed.
+TEST(LevelStream, QueuesRoomsFromLevelCache)
+{
+    const auto filename = write_synthetic_level(small_level(LevelVersion::Tomb5), directory("stream_source"), "stream");
+    LevelCache cache(directory("stream_cache"), "test");
+    for (int i = 0; i < 2; ++i)
+    {
+        SCOPED_TRACE(i);
+        LevelCache::Entry entry;
+        std::vector<uint8_t> geometry;
+        LevelStream stream([&](const LoadCallbacks& callbacks) { return cache.load(filename, LoadOptions(), entry, geometry, callbacks); });
+        ASSERT_EQ(all_rooms(5), take_all_rooms(stream));
+        ASSERT_EQ(5u, stream.level()->num_rooms());
+        cache.wait();
+    }
+    ASSERT_TRUE(cache.contains(filename));
+}
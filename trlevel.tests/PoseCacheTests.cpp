@@ -0,0 +1,325 @@
+#include <trlevel/PoseCache.h>
+#include <trlevel/Level.h>
+#include <trlevel.benchmarks/SyntheticLevel.h>
+
+using namespace trlevel;
+using namespace trlevel::benchmarks;
+using namespace DirectX::SimpleMath;
+
+namespace
+{
+    const float PiMul2 = 6.283185307179586476925286766559f;
+
+    void write_header(std::vector<uint16_t>& frames, int16_t offset_y)
+    {
+        const int16_t header[9] = { -10, -20, -30, 10, 20, 30, 5, offset_y, -5 };
+        frames.insert(frames.end(), std::begin(header), std::end(header));
+    }
+
+    /// Encode a rotation in the two word format used for rotations on all three axes.
+    void write_three_axis(std::vector<uint16_t>& frames, uint16_t x, uint16_t y, uint16_t z, bool reversed)
+    {
+        const uint16_t data = static_cast<uint16_t>((x << 4) | (y >> 6));
+        const uint16_t next = static_cast<uint16_t>(((y & 0x3f) << 10) | z);
+        if (reversed)
+        {
+            frames.push_back(next);
+            frames.push_back(data);
+        }
+        else
+        {
+            frames.push_back(data);
+            frames.push_back(next);
+        }
+    }
+
+    tr_model model(uint16_t meshes, uint32_t frame_offset, uint16_t animation)
+    {
+        tr_model result{};
+        result.NumMeshes = meshes;
+        result.FrameOffset = frame_offset * 2;
+        result.Animation = animation;
+        return result;
+    }
+
+    tr4_animation animation(uint32_t frame_offset, uint8_t frame_size, uint16_t frames)
+    {
+        tr4_animation result{};
+        result.FrameOffset = frame_offset * 2;
+        result.FrameRate = 1;
+        result.FrameSize = frame_size;
+        result.FrameStart = 0;
+        result.FrameEnd = static_cast<uint16_t>(frames - 1);
+        return result;
+    }
+
+    void expect_same_frame(const tr2_frame& expected, const tr2_frame& actual)
+    {
+        ASSERT_EQ(expected.bb1x, actual.bb1x);
+        ASSERT_EQ(expected.bb2z, actual.bb2z);
+        ASSERT_EQ(expected.offsetx, actual.offsetx);
+        ASSERT_EQ(expected.offsety, actual.offsety);
+        ASSERT_EQ(expected.offsetz, actual.offsetz);
+        ASSERT_EQ(expected.values.size(), actual.values.size());
+        for (std::size_t i = 0; i < expected.values.size(); ++i)
+        {
+            ASSERT_EQ(expected.values[i].x, actual.values[i].x);
+            ASSERT_EQ(expected.values[i].y, actual.values[i].y);
+            ASSERT_EQ(expected.values[i].z, actual.values[i].z);
+        }
+    }
+
+    void expect_near(const Matrix& expected, const Matrix& actual)
+    {
+        for (int r = 0; r < 4; ++r)
+        {
+            for (int c = 0; c < 4; ++c)
+            {
+                ASSERT_NEAR(expected.m[r][c], actual.m[r][c], 1e-4f);
+            }
+        }
+    }
+
+    /// The transforms of a frame built directly from the decoded angles, in the same way as an entity.
+    std::vector<Matrix> reference_transforms(const tr2_frame& frame, const std::vector<tr_meshtree_node>& nodes, const Matrix& world)
+    {
+        std::vector<Matrix> transforms;
+        Matrix previous = Matrix::CreateFromYawPitchRoll(frame.values[0].y, frame.values[0].x, frame.values[0].z) * Matrix::CreateTranslation(frame.position());
+        transforms.push_back(previous * world);
+
+        std::vector<Matrix> stack;
+        for (std::size_t i = 0; i < nodes.size(); ++i)
+        {
+            Matrix parent = previous;
+            if ((nodes[i].Flags & 0x1) && !stack.empty())
+            {
+                parent = stack.back();
+                stack.pop_back();
+            }
+            if (nodes[i].Flags & 0x2)
+            {
+                stack.push_back(parent);
+            }
+
+            const auto& rotation = frame.values[i + 1];
+            previous = Matrix::CreateFromYawPitchRoll(rotation.y, rotation.x, rotation.z) * Matrix::CreateTranslation(nodes[i].position()) * parent;
+            transforms.push_back(previous * world);
+        }
+        return transforms;
+    }
+
+    /// A small level with a few animated models.
+    SyntheticLevelOptions pose_level_options(LevelVersion version)
+    {
+        SyntheticLevelOptions options;
+        options.version = version;
+        options.rooms = 2;
+        options.room_faces = 10;
+        options.meshes = 10;
+        options.mesh_pointers = 40;
+        options.models = 4;
+        options.model_meshes = 6;
+        options.animations_per_model = 2;
+        options.frames_per_animation = 3;
+        options.entities = 4;
+        options.textiles = 1;
+        options.sound_samples = 0;
+        return options;
+    }
+
+    /// Write a level for posing models and return the path to it.
+    std::string write_pose_level(const SyntheticLevelOptions& options)
+    {
+        const auto directory = std::filesystem::temp_directory_path() / "trlevel.tests";
+        std::filesystem::create_directories(directory);
+        return write_synthetic_level(options, directory.string(), "poses");
+    }
+}
+
+// Tests that rotations around one axis are decoded the same as reading the frame directly.
+TEST(PoseCache, SingleAxisRotations)
+{
+    std::vector<uint16_t> frames;
+    write_header(frames, 100);
+    frames.push_back(0x4000 | 100);
+    frames.push_back(0x8000 | 200);
+    frames.push_back(0xC000 | 1023);
+
+    const std::vector<tr_model> models{ model(3, 0, 0xffff) };
+    const std::vector<tr4_animation> animations;
+    const PoseCache cache(LevelVersion::Tomb2, frames, models, animations);
+    ASSERT_EQ(1u, cache.num_model_frames(0));
+
+    tr2_frame expected;
+    ASSERT_TRUE(decode_frame(LevelVersion::Tomb2, frames, 0, 3, expected));
+    tr2_frame actual;
+    cache.get_frame(0, 0, actual);
+    expect_same_frame(expected, actual);
+
+    ASSERT_FLOAT_EQ(100 * PiMul2 / 1024.0f, actual.values[0].x);
+    ASSERT_FLOAT_EQ(0.0f, actual.values[0].y);
+    ASSERT_FLOAT_EQ(200 * PiMul2 / 1024.0f, actual.values[1].y);
+    ASSERT_FLOAT_EQ(1023 * PiMul2 / 1024.0f, actual.values[2].z);
+}
+
+// Tests that rotations around all three axes are decoded the same as reading the frame directly, for both word orders.
+TEST(PoseCache, ThreeAxisRotations)
+{
+    for (const auto version : { LevelVersion::Tomb1, LevelVersion::Tomb3 })
+    {
+        std::vector<uint16_t> frames;
+        write_header(frames, 100);
+        if (version == LevelVersion::Tomb1)
+        {
+            frames.push_back(2);
+        }
+        write_three_axis(frames, 10, 700, 30, version == LevelVersion::Tomb1);
+        write_three_axis(frames, 1023, 1, 512, version == LevelVersion::Tomb1);
+
+        const std::vector<tr_model> models{ model(2, 0, 0xffff) };
+        const std::vector<tr4_animation> animations;
+        const PoseCache cache(version, frames, models, animations);
+
+        tr2_frame expected;
+        ASSERT_TRUE(decode_frame(version, frames, 0, 2, expected));
+        tr2_frame actual;
+        cache.get_frame(0, 0, actual);
+        expect_same_frame(expected, actual);
+
+        ASSERT_FLOAT_EQ(10 * PiMul2 / 1024.0f, actual.values[0].x);
+        ASSERT_FLOAT_EQ(700 * PiMul2 / 1024.0f, actual.values[0].y);
+        ASSERT_FLOAT_EQ(30 * PiMul2 / 1024.0f, actual.values[0].z);
+        ASSERT_FLOAT_EQ(1023 * PiMul2 / 1024.0f, actual.values[1].x);
+        ASSERT_FLOAT_EQ(1 * PiMul2 / 1024.0f, actual.values[1].y);
+        ASSERT_FLOAT_EQ(512 * PiMul2 / 1024.0f, actual.values[1].z);
+    }
+}
+
+// Tests that the 12 bit single axis rotations used from Tomb Raider IV on are decoded the same as reading the frame directly.
+TEST(PoseCache, CompactRotations)
+{
+    std::vector<uint16_t> frames;
+    write_header(frames, 100);
+    frames.push_back(0x4000 | 3000);
+    write_three_axis(frames, 1, 2, 3, false);
+    frames.push_back(0xC000 | 4095);
+
+    const std::vector<tr_model> models{ model(3, 0, 0xffff) };
+    const std::vector<tr4_animation> animations;
+    const PoseCache cache(LevelVersion::Tomb4, frames, models, animations);
+
+    tr2_frame expected;
+    ASSERT_TRUE(decode_frame(LevelVersion::Tomb4, frames, 0, 3, expected));
+    tr2_frame actual;
+    cache.get_frame(0, 0, actual);
+    expect_same_frame(expected, actual);
+
+    ASSERT_FLOAT_EQ(3000 * PiMul2 / 4096.0f, actual.values[0].x);
+    ASSERT_FLOAT_EQ(2 * PiMul2 / 1024.0f, actual.values[1].y);
+    ASSERT_FLOAT_EQ(4095 * PiMul2 / 4096.0f, actual.values[2].z);
+}
+
+// Tests that the animation frames of a model follow the default frame, and that a frame shared by models
+// with different numbers of meshes is decoded for each of them.
+TEST(PoseCache, AnimationFramesAndSharedFrames)
+{
+    std::vector<uint16_t> frames;
+    for (uint16_t f = 0; f < 3; ++f)
+    {
+        write_header(frames, static_cast<int16_t>(f * 10));
+        frames.push_back(0x4000 | f);
+        frames.push_back(0x8000 | f);
+        frames.push_back(0xC000 | f);
+    }
+
+    const std::vector<tr_model> models{ model(3, 0, 0), model(2, 0, 0xffff) };
+    const std::vector<tr4_animation> animations{ animation(12, 12, 2) };
+    const PoseCache cache(LevelVersion::Tomb2, frames, models, animations);
+
+    ASSERT_EQ(3u, cache.num_model_frames(0));
+    ASSERT_EQ(1u, cache.num_model_frames(1));
+
+    const uint32_t offsets[3] = { 0, 12, 24 };
+    for (uint32_t f = 0; f < 3; ++f)
+    {
+        tr2_frame expected;
+        ASSERT_TRUE(decode_frame(LevelVersion::Tomb2, frames, offsets[f], 3, expected));
+        tr2_frame actual;
+        cache.get_frame(0, f, actual);
+        expect_same_frame(expected, actual);
+    }
+
+    tr2_frame expected;
+    ASSERT_TRUE(decode_frame(LevelVersion::Tomb2, frames, 0, 2, expected));
+    tr2_frame actual;
+    cache.get_frame(1, 0, actual);
+    expect_same_frame(expected, actual);
+}
+
+// Tests that posing the models of a level gives the same transforms as building them from get_frame.
+TEST(PoseCache, WorldTransformsMatchGetFrame)
+{
+    for (const auto version : { LevelVersion::Tomb1, LevelVersion::Tomb2, LevelVersion::Tomb3, LevelVersion::Tomb4, LevelVersion::Tomb5 })
+    {
+        const auto options = pose_level_options(version);
+        const Level level(write_pose_level(options));
+        SCOPED_TRACE(static_cast<int>(version));
+
+        const Matrix world = Matrix::CreateRotationY(0.5f) * Matrix::CreateTranslation(1, 2, 3);
+        for (uint32_t m = 0; m < level.num_models(); ++m)
+        {
+            const auto model = level.get_model(m);
+            ASSERT_EQ(1u + options.animations_per_model * options.frames_per_animation, level.num_model_frames(m));
+
+            const auto nodes = level.get_meshtree(model.MeshTree, model.NumMeshes - 1u);
+            for (uint32_t f = 0; f < level.num_model_frames(m); ++f)
+            {
+                // Frame 0 is the frame the model points to and the animation frames follow on from it.
+                uint32_t frame_offset = model.FrameOffset / 2;
+                if (f > 0)
+                {
+                    const auto& animation = level.animations()[model.Animation + (f - 1) / options.frames_per_animation];
+                    frame_offset = animation.FrameOffset / 2 + ((f - 1) % options.frames_per_animation) * animation.FrameSize;
+                }
+                const auto expected = reference_transforms(level.get_frame(frame_offset, model.NumMeshes), nodes, world);
+
+                const PoseInstance instance{ m, f, world };
+                std::vector<Matrix> actual;
+                level.get_world_transforms(Span<PoseInstance>(&instance, 1), actual);
+                ASSERT_EQ(expected.size(), actual.size());
+                for (std::size_t i = 0; i < expected.size(); ++i)
+                {
+                    expect_near(expected[i], actual[i]);
+                }
+            }
+        }
+    }
+}
+
+// Tests that posing a model that is not in the level throws instead of reading past the models.
+TEST(PoseCache, WorldTransformsBadModel)
+{
+    const auto options = pose_level_options(LevelVersion::Tomb2);
+    const Level level(write_pose_level(options));
+
+    const PoseInstance instances[2] = { { 0, 0, Matrix::Identity }, { level.num_models(), 0, Matrix::Identity } };
+    std::vector<Matrix> transforms;
+    ASSERT_THROW(level.get_world_transforms(Span<PoseInstance>(instances, 2), transforms), std::out_of_range);
+}
+
+// Tests that posing a model after the models have been trimmed throws, as the models are no longer there.
+TEST(PoseCache, WorldTransformsAfterTrim)
+{
+    const auto options = pose_level_options(LevelVersion::Tomb2);
+    Level level(write_pose_level(options));
+
+    const PoseInstance instance{ 0, 0, Matrix::Identity };
+    std::vector<Matrix> transforms;
+    level.get_world_transforms(Span<PoseInstance>(&instance, 1), transforms);
+    ASSERT_EQ(options.model_meshes, transforms.size());
+
+    LoadOptions rooms_only = LoadOptions::none();
+    rooms_only.rooms = true;
+    level.trim(rooms_only);
+    ASSERT_THROW(level.get_world_transforms(Span<PoseInstance>(&instance, 1), transforms), std::out_of_range);
+}
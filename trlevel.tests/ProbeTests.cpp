@@ -0,0 +1,123 @@
+#include <trlevel/trlevel.h>
+#include <trlevel/Level.h>
+#include <trlevel/LevelLoadException.h>
+#include <trlevel.benchmarks/SyntheticLevel.h>
+
+using namespace trlevel;
+using namespace trlevel::benchmarks;
+
+namespace
+{
+    SyntheticLevelOptions small_level(LevelVersion version)
+    {
+        SyntheticLevelOptions options;
+        options.version = version;
+        options.rooms = 5;
+        options.room_faces = 20;
+        options.meshes = 10;
+        options.mesh_pointers = 30;
+        options.models = 6;
+        options.animations_per_model = 2;
+        options.frames_per_animation = 4;
+        options.entities = 12;
+        options.textiles = 3;
+        options.sound_samples = 4;
+        return options;
+    }
+
+    std::string directory()
+    {
+        const auto path = std::filesystem::temp_directory_path() / "trlevel.tests";
+        std::filesystem::create_directories(path);
+        return path.string();
+    }
+
+    /// Write a level and then cut it short.
+    std::string write_truncated_level(const SyntheticLevelOptions& options, const std::string& name)
+    {
+        const auto filename = write_synthetic_level(options, directory(), name);
+        std::filesystem::resize_file(filename, std::filesystem::file_size(filename) / 2);
+        return filename;
+    }
+
+    const LevelVersion Versions[] =
+    {
+        LevelVersion::Tomb1, LevelVersion::Tomb2, LevelVersion::Tomb3, LevelVersion::Tomb4, LevelVersion::Tomb5
+    };
+}
+
+// Tests that probing a level gives the same counts as loading the whole level, for every version.
+TEST(Probe, SummaryMatchesLoadedLevel)
+{
+    for (const auto version : Versions)
+    {
+        const auto options = small_level(version);
+        const auto filename = write_synthetic_level(options, directory(), "probe");
+        const auto summary = probe_level(filename);
+        const Level level(filename);
+
+        SCOPED_TRACE(filename);
+        ASSERT_EQ(version, summary.version);
+        ASSERT_EQ(options.rooms, summary.num_rooms);
+        ASSERT_EQ(level.num_rooms(), summary.num_rooms);
+        ASSERT_EQ(level.num_textiles(), summary.num_textiles);
+        ASSERT_EQ(level.num_entities(), summary.num_entities);
+        ASSERT_EQ(level.num_models(), summary.num_models);
+        ASSERT_EQ(level.num_static_meshes(), summary.num_static_meshes);
+        ASSERT_EQ(level.num_object_textures(), summary.num_object_textures);
+        ASSERT_EQ(level.num_sound_samples(), summary.num_sound_samples);
+        ASSERT_EQ(options.entities, summary.num_entities);
+        ASSERT_EQ(options.models, summary.num_models);
+        if (version >= LevelVersion::Tomb4)
+        {
+            ASSERT_EQ(options.sound_samples, summary.num_sound_samples);
+        }
+    }
+}
+
+// Tests that the level used for probing skips the rooms and textiles rather than reading them.
+TEST(Probe, RoomsAndTextilesNotRead)
+{
+    for (const auto version : Versions)
+    {
+        const auto filename = write_synthetic_level(small_level(version), directory(), "probe");
+        const Level level(filename, LoadOptions::none());
+
+        SCOPED_TRACE(filename);
+        ASSERT_GT(level.summary().num_rooms, 0u);
+        ASSERT_GT(level.summary().num_textiles, 0u);
+        ASSERT_EQ(0u, level.num_rooms());
+        ASSERT_EQ(0u, level.num_textiles());
+        ASSERT_EQ(0u, level.num_entities());
+        ASSERT_EQ(0u, level.num_models());
+        ASSERT_EQ(0u, level.num_object_textures());
+        ASSERT_EQ(0u, level.num_sound_samples());
+    }
+}
+
+// Tests that probing a truncated level throws.
+TEST(Probe, TruncatedLevelThrows)
+{
+    for (const auto version : Versions)
+    {
+        const auto filename = write_truncated_level(small_level(version), "truncated");
+        SCOPED_TRACE(filename);
+        ASSERT_THROW(probe_level(filename), LevelLoadException);
+    }
+}
+
+// Tests that probing a set of levels gives the summaries in the same order as the files and no value for a level that can't be read.
+TEST(Probe, ProbeLevelsKeepsOrder)
+{
+    const auto first = write_synthetic_level(small_level(LevelVersion::Tomb1), directory(), "first");
+    const auto truncated = write_truncated_level(small_level(LevelVersion::Tomb2), "truncated");
+    const auto last = write_synthetic_level(small_level(LevelVersion::Tomb4), directory(), "last");
+
+    const auto summaries = probe_levels({ first, truncated, last });
+    ASSERT_EQ(3u, summaries.size());
+    ASSERT_TRUE(summaries[0].has_value());
+    ASSERT_EQ(LevelVersion::Tomb1, summaries[0]->version);
+    ASSERT_FALSE(summaries[1].has_value());
+    ASSERT_TRUE(summaries[2].has_value());
+    ASSERT_EQ(LevelVersion::Tomb4, summaries[2]->version);
+}
@@ -0,0 +1,133 @@
+#include <trlevel/TextileConversion.h>
+#include <trlevel/trtypes.h>
+
+using namespace trlevel;
+
+namespace
+{
+    /// Puts the conversion functions back to choosing their own path when a test finishes.
+    struct ForcedPath
+    {
+        ~ForcedPath()
+        {
+            force_textile_conversion_path(TextileConversionPath::Default);
+        }
+    };
+
+    /// Lengths that are not a multiple of the four or eight pixels converted at once, as well as some that are.
+    const std::size_t Lengths[] = { 0, 1, 3, 4, 5, 7, 8, 9, 15, 17, 31, 100, 257, 1021 };
+
+    const TextileConversionPath Paths[] = { TextileConversionPath::Scalar, TextileConversionPath::Sse2, TextileConversionPath::Avx2 };
+
+    template <typename T>
+    std::vector<T> random_values(std::size_t count, std::mt19937& random)
+    {
+        std::uniform_int_distribution<uint32_t> distribution(0, std::numeric_limits<T>::max());
+        std::vector<T> values(count);
+        std::generate(values.begin(), values.end(), [&]() { return static_cast<T>(distribution(random)); });
+        return values;
+    }
+}
+
+// Tests that every path converts 32 bit pixels the same as converting them one at a time. Paths that this machine
+// can't use are skipped. The input starts one pixel in so that it is not aligned.
+TEST(TextileConversion, Textile32PathsMatchScalar)
+{
+    ForcedPath forced;
+    std::mt19937 random(1234);
+    for (const auto path : Paths)
+    {
+        if (!force_textile_conversion_path(path))
+        {
+            continue;
+        }
+
+        for (const auto length : Lengths)
+        {
+            SCOPED_TRACE(testing::Message() << "Path " << static_cast<int>(path) << ", length " << length);
+            const auto input = random_values<uint32_t>(length + 1, random);
+            std::vector<uint32_t> output(length + 1, 0xdeadbeef);
+            convert_textile32(input.data() + 1, output.data(), length);
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                ASSERT_EQ(convert_textile32(input[i + 1]), output[i]) << "Pixel " << i;
+            }
+            ASSERT_EQ(0xdeadbeef, output[length]);
+        }
+    }
+}
+
+// Tests that every path converts 16 bit pixels the same as converting them one at a time. Paths that this machine
+// can't use are skipped. The input starts one pixel in so that it is not aligned.
+TEST(TextileConversion, Textile16PathsMatchScalar)
+{
+    ForcedPath forced;
+    std::mt19937 random(1234);
+    for (const auto path : Paths)
+    {
+        if (!force_textile_conversion_path(path))
+        {
+            continue;
+        }
+
+        for (const auto length : Lengths)
+        {
+            SCOPED_TRACE(testing::Message() << "Path " << static_cast<int>(path) << ", length " << length);
+            const auto input = random_values<uint16_t>(length + 1, random);
+            std::vector<uint32_t> output(length + 1, 0xdeadbeef);
+            convert_textile16(input.data() + 1, output.data(), length);
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                ASSERT_EQ(convert_textile16(input[i + 1]), output[i]) << "Pixel " << i;
+            }
+            ASSERT_EQ(0xdeadbeef, output[length]);
+        }
+    }
+}
+
+// Tests that every path converts 8 bit pixels to the palette entries that they index. Paths that this machine
+// can't use are skipped. The input starts one pixel in so that it is not aligned.
+TEST(TextileConversion, Textile8PathsMatchPalette)
+{
+    ForcedPath forced;
+    std::mt19937 random(1234);
+    const auto palette = random_values<uint32_t>(256, random);
+    for (const auto path : Paths)
+    {
+        if (!force_textile_conversion_path(path))
+        {
+            continue;
+        }
+
+        for (const auto length : Lengths)
+        {
+            SCOPED_TRACE(testing::Message() << "Path " << static_cast<int>(path) << ", length " << length);
+            auto input = random_values<uint8_t>(length + 1, random);
+            if (length >= 2)
+            {
+                // Make sure that both ends of the palette are used.
+                input[1] = 0;
+                input[2] = 255;
+            }
+            std::vector<uint32_t> output(length + 1, 0xdeadbeef);
+            convert_textile8(input.data() + 1, palette.data(), output.data(), length);
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                ASSERT_EQ(palette[input[i + 1]], output[i]) << "Pixel " << i;
+            }
+            ASSERT_EQ(0xdeadbeef, output[length]);
+        }
+    }
+}
+
+// Tests that forcing a path changes whether AVX2 is reported as being in use.
+TEST(TextileConversion, ForcedPathIsReported)
+{
+    ForcedPath forced;
+    ASSERT_TRUE(force_textile_conversion_path(TextileConversionPath::Scalar));
+    ASSERT_FALSE(textile_conversion_uses_avx2());
+    if (force_textile_conversion_path(TextileConversionPath::Avx2))
+    {
+        ASSERT_TRUE(textile_conversion_uses_avx2());
+    }
+}
@@ -0,0 +1,60 @@
+#include "DataReader.h"
+
+namespace trlevel
+{
+    DataReader::DataReader(const uint8_t* data, std::size_t size)
+        : _data(data), _size(size)
+    {
+    }
+
+    DataReader::DataReader(const std::vector<uint8_t>& data)
+        : _data(data.data()), _size(data.size())
+    {
+    }
+
+    void DataReader::skip(std::size_t bytes)
+    {
+        require(bytes);
+        _position += bytes;
+    }
+
+    DataReader DataReader::read_block(std::size_t bytes)
+    {
+        require(bytes);
+        DataReader block(_data + _position, bytes);
+        _position += bytes;
+        return block;
+    }
+
+    void DataReader::seek(std::size_t position)
+    {
+        if (position > _size)
+        {
+            throw std::out_of_range("Attempted to seek past the end of the level data");
+        }
+        _position = position;
+    }
+
+    std::size_t DataReader::position() const
+    {
+        return _position;
+    }
+
+    std::size_t DataReader::size() const
+    {
+        return _size;
+    }
+
+    const uint8_t* DataReader::current() const
+    {
+        return _data + _position;
+    }
+
+    void DataReader::require(std::size_t bytes) const
+    {
+        if (bytes > _size - _position)
+        {
+            throw std::out_of_range("Attempted to read past the end of the level data");
+        }
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <type_traits>
+
+namespace trlevel
+{
+    /// Bounds checked cursor over a block of level data. The reader does not own the data
+    /// that it reads from, so the data must outlive the reader.
+    class DataReader final
+    {
+    public:
+        /// Create a reader over the specified data.
+        /// @param data The start of the data.
+        /// @param size The number of bytes that can be read.
+        DataReader(const uint8_t* data, std::size_t size);
+
+        /// Create a reader over the specified buffer.
+        /// @param data The buffer to read from.
+        explicit DataReader(const std::vector<uint8_t>& data);
+
+        /// Read a value and advance the cursor.
+        /// @returns The value that was read.
+        template < typename T >
+        T read();
+
+        /// Read a value and advance the cursor.
+        /// @param value The value to populate.
+        template < typename T >
+        void read(T& value);
+
+        /// Read a value without advancing the cursor.
+        /// @returns The value at the cursor.
+        template < typename T >
+        T peek() const;
+
+        /// Read a number of values with a single copy and advance the cursor.
+        /// @param size The number of elements to read.
+        /// @returns The elements that were read.
+        template < typename DataType, typename SizeType >
+        std::vector<DataType> read_vector(SizeType size);
+
+        /// Read a size value followed by that number of values.
+        /// @returns The elements that were read.
+        template < typename SizeType, typename DataType >
+        std::vector<DataType> read_vector();
+
+        /// Read a number of values into existing storage with a single copy and advance the cursor.
+        /// @param output The storage to write to. Must have space for size elements.
+        /// @param size The number of elements to read.
+        template < typename DataType, typename SizeType >
+        void read_into(DataType* output, SizeType size);
+
+        /// Create a reader over the next block of data and advance the cursor past it.
+        /// @param bytes The size of the block in bytes.
+        /// @returns A reader over the block.
+        DataReader read_block(std::size_t bytes);
+
+        /// Advance the cursor past a number of values without reading them.
+        /// @param size The number of elements to skip.
+        template < typename DataType, typename SizeType >
+        void skip_vector(SizeType size);
+
+        /// Read a size value and advance the cursor past that number of values without reading them.
+        /// @returns The number of elements that were skipped.
+        template < typename SizeType, typename DataType >
+        SizeType skip_vector();
+
+        /// Advance the cursor without reading.
+        /// @param bytes The number of bytes to skip.
+        void skip(std::size_t bytes);
+
+        /// Move the cursor to an absolute position.
+        /// @param position The position, in bytes, from the start of the data.
+        void seek(std::size_t position);
+
+        /// Get the position of the cursor.
+        /// @returns The position, in bytes, from the start of the data.
+        std::size_t position() const;
+
+        /// Get the total size of the data.
+        /// @returns The size in bytes.
+        std::size_t size() const;
+
+        /// Get a pointer to the data at the cursor.
+        /// @returns The data at the cursor.
+        const uint8_t* current() const;
+    private:
+        /// Throw if the specified number of bytes can't be read from the cursor.
+        void require(std::size_t bytes) const;
+
+        /// Throw if the specified number of elements can't be read from the cursor.
+        template < typename DataType >
+        void require_elements(std::size_t count) const;
+
+        const uint8_t* _data;
+        std::size_t _size;
+        std::size_t _position{ 0u };
+    };
+}
+
+#include "DataReader.inl"
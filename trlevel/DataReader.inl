@@ -0,0 +1,92 @@
+#pragma once
+
+namespace trlevel
+{
+    template < typename T >
+    T DataReader::read()
+    {
+        T value;
+        read<T>(value);
+        return value;
+    }
+
+    template < typename T >
+    void DataReader::read(T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read");
+        require(sizeof(T));
+        std::memcpy(&value, _data + _position, sizeof(T));
+        _position += sizeof(T);
+    }
+
+    template < typename T >
+    T DataReader::peek() const
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read");
+        require(sizeof(T));
+        T value;
+        std::memcpy(&value, _data + _position, sizeof(T));
+        return value;
+    }
+
+    template < typename DataType, typename SizeType >
+    std::vector<DataType> DataReader::read_vector(SizeType size)
+    {
+        static_assert(std::is_trivially_copyable<DataType>::value, "Only trivially copyable types can be read");
+        const std::size_t count = static_cast<std::size_t>(size);
+        // Check the size before allocating so that a corrupt count fails instead of allocating a huge vector.
+        require_elements<DataType>(count);
+        std::vector<DataType> data(count);
+        if (count)
+        {
+            std::memcpy(&data[0], _data + _position, count * sizeof(DataType));
+            _position += count * sizeof(DataType);
+        }
+        return data;
+    }
+
+    template < typename DataType, typename SizeType >
+    void DataReader::read_into(DataType* output, SizeType size)
+    {
+        static_assert(std::is_trivially_copyable<DataType>::value, "Only trivially copyable types can be read");
+        const std::size_t count = static_cast<std::size_t>(size);
+        require_elements<DataType>(count);
+        if (count)
+        {
+            std::memcpy(output, _data + _position, count * sizeof(DataType));
+            _position += count * sizeof(DataType);
+        }
+    }
+
+    template < typename SizeType, typename DataType >
+    std::vector<DataType> DataReader::read_vector()
+    {
+        auto size = read<SizeType>();
+        return read_vector<DataType, SizeType>(size);
+    }
+
+    template < typename DataType, typename SizeType >
+    void DataReader::skip_vector(SizeType size)
+    {
+        const std::size_t count = static_cast<std::size_t>(size);
+        require_elements<DataType>(count);
+        _position += count * sizeof(DataType);
+    }
+
+    template < typename SizeType, typename DataType >
+    SizeType DataReader::skip_vector()
+    {
+        auto size = read<SizeType>();
+        skip_vector<DataType, SizeType>(size);
+        return size;
+    }
+
+    template < typename DataType >
+    void DataReader::require_elements(std::size_t count) const
+    {
+        if (count > (_size - _position) / sizeof(DataType))
+        {
+            throw std::out_of_range("Attempted to read past the end of the level data");
+        }
+    }
+}
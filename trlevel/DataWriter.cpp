@@ -0,0 +1,15 @@
+#include "DataWriter.h"
+
+namespace trlevel
+{
+    const std::vector<uint8_t>& DataWriter::data() const
+    {
+        return _data;
+    }
+
+    void DataWriter::write_bytes(const void* data, std::size_t size)
+    {
+        const auto bytes = static_cast<const uint8_t*>(data);
+        _data.insert(_data.end(), bytes, bytes + size);
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <type_traits>
+
+namespace trlevel
+{
+    /// Appends values to a block of binary data. The layout matches what DataReader expects,
+    /// so anything written with a DataWriter can be read back with a DataReader.
+    class DataWriter final
+    {
+    public:
+        /// Append a value.
+        /// @param value The value to write.
+        template < typename T >
+        void write(const T& value);
+
+        /// Append a number of values with a single copy.
+        /// @param data The values to write.
+        template < typename DataType >
+        void write_vector(const std::vector<DataType>& data);
+
+        /// Append a size value followed by that number of values.
+        /// @param data The values to write.
+        template < typename SizeType, typename DataType >
+        void write_sized_vector(const std::vector<DataType>& data);
+
+        /// Get the data that has been written.
+        /// @returns The data.
+        const std::vector<uint8_t>& data() const;
+    private:
+        /// Append raw bytes.
+        void write_bytes(const void* data, std::size_t size);
+
+        std::vector<uint8_t> _data;
+    };
+}
+
+#include "DataWriter.inl"
@@ -0,0 +1,25 @@
+#pragma once
+
+namespace trlevel
+{
+    template < typename T >
+    void DataWriter::write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written");
+        write_bytes(&value, sizeof(T));
+    }
+
+    template < typename DataType >
+    void DataWriter::write_vector(const std::vector<DataType>& data)
+    {
+        static_assert(std::is_trivially_copyable<DataType>::value, "Only trivially copyable types can be written");
+        write_bytes(data.data(), data.size() * sizeof(DataType));
+    }
+
+    template < typename SizeType, typename DataType >
+    void DataWriter::write_sized_vector(const std::vector<DataType>& data)
+    {
+        write(static_cast<SizeType>(data.size()));
+        write_vector(data);
+    }
+}
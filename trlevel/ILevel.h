@@ -1,11 +1,37 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include "trtypes.h"
 #include "LevelVersion.h"
+#include "LoadOptions.h"
+#include "Span.h"
+#include "PoseInstance.h"
 
 namespace trlevel
 {
+    struct ILevel;
+
+    /// Functions that are called on the loading thread while a level is loading, so that the rooms can be used
+    /// before the rest of the level has been read.
+    struct LoadCallbacks
+    {
+        /// Called as each room is parsed. Tomb Raider V rooms are parsed at the same time, so this can be called from
+        /// more than one thread at once.
+        /// @param index The index of the room.
+        /// @param room The room. This is only valid for the duration of the call.
+        std::function<void (uint32_t index, const tr3_room& room)> room_loaded;
+
+        /// Called once every room and the floordata have been read. Until loading has finished only get_version,
+        /// num_rooms, room and floor_data can be used, as the rest of the level is still being read.
+        /// @param level The level that is loading.
+        std::function<void (const ILevel& level)> rooms_loaded;
+
+        /// Called if loading fails after rooms_loaded, before the rooms are released. The level must not be used
+        /// once this has returned.
+        std::function<void ()> load_failed;
+    };
+
     // Interface that defines a level.
     struct ILevel
     {
@@ -49,6 +75,11 @@ namespace trlevel
         // Returns: The colours for this index.
         virtual std::vector<uint32_t> get_textile(uint32_t index) const = 0;
 
+        /// Get the 8 or 16 bit textile with the specified index, converted to 32 bit colours.
+        /// @param index The index of the textile.
+        /// @param output The buffer to write the colours to. This is resized to fit the textile.
+        virtual void get_textile(uint32_t index, std::vector<uint32_t>& output) const = 0;
+
         // Gets the number of rooms in the level.
         // Returns: The number of rooms.
         virtual uint32_t num_rooms() const = 0;
@@ -57,6 +88,11 @@ namespace trlevel
         // Returns: The room.
         virtual tr3_room get_room(uint32_t index) const = 0;
 
+        /// Get the room at the specified index without copying it.
+        /// @param index The index of the room.
+        /// @returns The room. This is valid for as long as the level exists.
+        virtual const tr3_room& room(uint32_t index) const = 0;
+
         // Get the number of object textures in the level.
         // Returns: The number of object textures.
         virtual uint32_t num_object_textures() const = 0;
@@ -79,6 +115,10 @@ namespace trlevel
         // Returns: The floor data.
         virtual std::vector<std::uint16_t> get_floor_data_all() const = 0;
 
+        /// Get all of the floor data without copying it.
+        /// @returns The floor data. This is valid for as long as the level exists.
+        virtual const std::vector<std::uint16_t>& floor_data() const = 0;
+
         // Get the number of entities in the level.
         // Returns: The number of entities.
         virtual uint32_t num_entities() const = 0;
@@ -120,18 +160,75 @@ namespace trlevel
         // Returns: The mesh.
         virtual tr_mesh get_mesh_by_pointer(uint32_t mesh_pointer) const = 0;
 
+        /// Get the mesh referenced by the specified mesh pointer without copying it.
+        /// @param mesh_pointer The mesh pointer index.
+        /// @returns The mesh. This is valid for as long as the level exists.
+        virtual const tr_mesh& mesh(uint32_t mesh_pointer) const = 0;
+
         // Get the mesh tree node at the specified index.
         // index: The starting mesh tree index.
         // node_count: The number of nodes to read.
         // Returns: The mesh tree node.
         virtual std::vector<tr_meshtree_node> get_meshtree(uint32_t starting_index, uint32_t node_count) const = 0;
 
+        /// Get a range of mesh tree nodes without copying them.
+        /// @param starting_index The starting mesh tree index.
+        /// @param node_count The number of nodes in the range.
+        /// @returns The mesh tree nodes. These are valid for as long as the level exists.
+        virtual Span<tr_meshtree_node> meshtree(uint32_t starting_index, uint32_t node_count) const = 0;
+
         // Get the frame at the specified index. Read the specified number of meshes.
         // frame_offset: The frame offset.
         // mesh_count: The number of meshes to read.
         // Returns: The frame.
         virtual tr2_frame get_frame(uint32_t frame_offset, uint32_t mesh_count) const = 0;
 
+        /// Get the frame at the specified offset into an existing frame so that the rotation
+        /// storage can be reused.
+        /// @param frame_offset The frame offset.
+        /// @param mesh_count The number of meshes to read.
+        /// @param frame The frame to populate.
+        virtual void get_frame(uint32_t frame_offset, uint32_t mesh_count, tr2_frame& frame) const = 0;
+
+        /// Get the animations in the level. Tomb Raider I-III animations are converted to the Tomb Raider IV
+        /// layout with no lateral movement.
+        /// @returns The animations. These are valid for as long as the level exists.
+        virtual Span<tr4_animation> animations() const = 0;
+
+        /// Get the animation state changes in the level.
+        /// @returns The state changes. These are valid for as long as the level exists.
+        virtual Span<tr_state_change> state_changes() const = 0;
+
+        /// Get the animation dispatches in the level.
+        /// @returns The dispatches. These are valid for as long as the level exists.
+        virtual Span<tr_anim_dispatch> anim_dispatches() const = 0;
+
+        /// Get the animation commands in the level.
+        /// @returns The commands. These are valid for as long as the level exists.
+        virtual Span<tr_anim_command> anim_commands() const = 0;
+
+        /// Get the number of frames that can be used to pose a model. This is the frame that the model
+        /// points to followed by the frames of its animations.
+        /// @param model_index The index of the model.
+        /// @returns The number of frames.
+        virtual uint32_t num_model_frames(uint32_t model_index) const = 0;
+
+        /// Calculate the world transform of every mesh of a number of posed models at once.
+        /// @param instances The models to pose.
+        /// @param transforms Receives the transforms of each instance in turn, one per mesh of the model.
+        /// @remarks Throws std::out_of_range if a model or frame is not in the level, which includes after the models have been trimmed.
+        virtual void get_world_transforms(Span<PoseInstance> instances, std::vector<DirectX::SimpleMath::Matrix>& transforms) const = 0;
+
+        /// Get the number of sound samples that were loaded. Sound samples are only stored in
+        /// Tomb Raider IV and V levels and are only loaded if requested in the load options.
+        /// @returns The number of sound samples.
+        virtual uint32_t num_sound_samples() const = 0;
+
+        /// Get the sound sample at the specified index.
+        /// @param index The index of the sample.
+        /// @returns The uncompressed sample data.
+        virtual std::vector<uint8_t> get_sound_sample(uint32_t index) const = 0;
+
         // Get the version of the game that the level was built for.
         // Returns: The level version.
         virtual LevelVersion get_version() const = 0;
@@ -153,9 +250,23 @@ namespace trlevel
         /// @returns Whether the entity was found.
         virtual bool find_first_entity_by_type(int16_t type, tr2_entity& entity) const = 0;
 
+        /// Get the indices of all of the entities with the specified type.
+        /// @param type The type ID of the entities.
+        /// @returns The entity indices in ascending order. These are valid for as long as the level exists.
+        virtual Span<uint32_t> entities_by_type(int16_t type) const = 0;
+
         /// Get the true mesh from a type id. For example Lara's skin.
         /// @param type The type id to check.
         /// @returns The mesh index for the type.
         virtual int16_t get_mesh_from_type_id(int16_t type) const = 0;
+
+        /// Release the loaded sections of the level that are no longer needed, for example once they have been
+        /// uploaded to the GPU. The released sections are empty afterwards, as if they had not been loaded.
+        /// @param sections The sections to keep. Sections that are not set are released.
+        virtual void trim(const LoadOptions& sections) = 0;
+
+        /// Get the approximate amount of memory used by the loaded sections of the level.
+        /// @returns The number of bytes.
+        virtual std::size_t memory_usage() const = 0;
     };
 }
\ No newline at end of file
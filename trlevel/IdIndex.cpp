@@ -0,0 +1,57 @@
+#include "IdIndex.h"
+
+namespace trlevel
+{
+    namespace
+    {
+        // The largest ID that is stored in the flat array. This covers every model and sprite ID used by the games.
+        const uint32_t MaxDenseId = 4095;
+        const uint32_t NoIndex = 0xffffffff;
+    }
+
+    void IdIndex::add(uint32_t id, uint32_t index)
+    {
+        if (id > MaxDenseId)
+        {
+            _sparse.insert({ id, index });
+            return;
+        }
+
+        if (id >= _dense.size())
+        {
+            _dense.resize(id + 1, NoIndex);
+        }
+
+        if (_dense[id] == NoIndex)
+        {
+            _dense[id] = index;
+        }
+    }
+
+    bool IdIndex::find(uint32_t id, uint32_t& index) const
+    {
+        if (id < _dense.size())
+        {
+            if (_dense[id] == NoIndex)
+            {
+                return false;
+            }
+            index = _dense[id];
+            return true;
+        }
+
+        const auto found = _sparse.find(id);
+        if (found == _sparse.end())
+        {
+            return false;
+        }
+        index = found->second;
+        return true;
+    }
+
+    void IdIndex::clear()
+    {
+        _dense.clear();
+        _sparse.clear();
+    }
+}
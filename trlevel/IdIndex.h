@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace trlevel
+{
+    /// Maps the IDs used by the level (model IDs, sprite IDs and entity types) to indices. IDs are
+    /// small and mostly contiguous, so they are stored in a flat array. IDs that are too large for
+    /// the array go into a hash map instead.
+    class IdIndex final
+    {
+    public:
+        /// Add an ID to the index. If the ID is already in the index the existing index is kept, so
+        /// that lookups find the first item with the ID.
+        /// @param id The ID to add.
+        /// @param index The index that the ID maps to.
+        void add(uint32_t id, uint32_t index);
+
+        /// Find the index for an ID.
+        /// @param id The ID to look for.
+        /// @param index Receives the index if the ID was found.
+        /// @returns Whether the ID was found.
+        bool find(uint32_t id, uint32_t& index) const;
+
+        /// Remove all IDs from the index.
+        void clear();
+    private:
+        std::vector<uint32_t> _dense;
+        std::unordered_map<uint32_t, uint32_t> _sparse;
+    };
+}
@@ -1,11 +1,17 @@
 #include "Level.h"
 #include "LevelLoadException.h"
+#include "DataReader.h"
+#include "DataWriter.h"
+#include "TextileConversion.h"
+#include "PoseCache.h"
+
+#include <trview.common/MappedFile.h>
+#include <trview.common/ThreadPool.h>
 
 namespace trlevel
 {
     namespace
     {
-        const float PiMul2 = 6.283185307179586476925286766559f;
         const int16_t Lara = 0;
         const int16_t LaraSkinTR3 = 315;
         const int16_t LaraSkinPostTR3 = 8;
@@ -13,179 +19,206 @@ namespace trlevel
 
     namespace
     {
-        template <typename T>
-        T read(std::istream& file)
+        /// A zlib compressed block of data in the level file.
+        struct CompressedChunk
         {
-            T value;
-            read<T>(file, value);
-            return value;
-        }
+            uint32_t uncompressed_size{ 0u };
+            uint32_t compressed_size{ 0u };
+            const uint8_t* data{ nullptr };
+        };
 
-        template < typename T >
-        void read(std::istream& file, T& value)
-        {
-            file.read(reinterpret_cast<char*>(&value), sizeof(value));
-        }
-
-        template < typename DataType, typename SizeType >
-        std::vector<DataType> read_vector(std::istream& file, SizeType size)
-        {
-            std::vector<DataType> data(size);
-            for (SizeType i = 0; i < size; ++i)
-            {
-                read<DataType>(file, data[i]);
-            }
-            return data;
-        }
-
-        template < typename SizeType, typename DataType >
-        std::vector<DataType> read_vector(std::istream& file)
+        /// Read the header of a compressed chunk and skip past the compressed data.
+        CompressedChunk read_compressed_chunk(DataReader& reader)
         {
-            auto size = read<SizeType>(file);
-            return read_vector<DataType, SizeType>(file, size);
+            CompressedChunk chunk;
+            chunk.uncompressed_size = reader.read<uint32_t>();
+            chunk.compressed_size = reader.read<uint32_t>();
+            chunk.data = reader.current();
+            reader.skip(chunk.compressed_size);
+            return chunk;
         }
 
-        std::vector<uint8_t> read_compressed(std::istream& file)
+        void inflate_chunk(const CompressedChunk& chunk, uint8_t* output, uint32_t output_size)
         {
-            auto uncompressed_size = read<uint32_t>(file);
-            auto compressed_size = read<uint32_t>(file);
-            auto compressed = read_vector<uint8_t>(file, compressed_size);
-            std::vector<uint8_t> uncompressed_data(uncompressed_size);
-
             z_stream stream;
             memset(&stream, 0, sizeof(stream));
-            int result = inflateInit(&stream);
-            // Exception...
-            stream.avail_in = compressed_size;
-            stream.next_in = &compressed[0];
-            stream.avail_out = uncompressed_size;
-            stream.next_out = &uncompressed_data[0];
-            result = inflate(&stream, Z_NO_FLUSH);
+            inflateInit(&stream);
+            stream.avail_in = chunk.compressed_size;
+            stream.next_in = const_cast<Bytef*>(chunk.data);
+            stream.avail_out = output_size;
+            stream.next_out = output;
+            inflate(&stream, Z_NO_FLUSH);
             inflateEnd(&stream);
+        }
 
+        std::vector<uint8_t> decompress(const CompressedChunk& chunk)
+        {
+            std::vector<uint8_t> uncompressed_data(chunk.uncompressed_size);
+            inflate_chunk(chunk, uncompressed_data.data(), chunk.uncompressed_size);
             return uncompressed_data;
         }
 
         template < typename DataType >
-        std::vector<DataType> read_vector_compressed(std::istream& file, uint32_t elements)
+        std::vector<DataType> decompress_vector(const CompressedChunk& chunk, uint32_t elements)
         {
-            auto uncompressed_data = read_compressed(file);
-            std::string data(reinterpret_cast<char*>(&uncompressed_data[0]), uncompressed_data.size());
-            std::istringstream data_stream(data, std::ios::binary);
-            data_stream.exceptions(std::ifstream::failbit | std::ifstream::badbit | std::ifstream::eofbit);
-            return read_vector<DataType>(data_stream, elements);
+            static_assert(std::is_trivially_copyable<DataType>::value, "Only trivially copyable types can be read");
+            if (static_cast<uint64_t>(elements) * sizeof(DataType) > chunk.uncompressed_size)
+            {
+                throw std::out_of_range("Compressed chunk is too small for the requested elements");
+            }
+
+            // Inflate straight into the output so that there is no intermediate copy.
+            std::vector<DataType> data(elements);
+            if (elements)
+            {
+                inflate_chunk(chunk, reinterpret_cast<uint8_t*>(&data[0]), static_cast<uint32_t>(elements * sizeof(DataType)));
+            }
+            return data;
         }
 
-        bool is_tr5(LevelVersion version, const std::wstring& filename)
+        bool is_tr5(LevelVersion version, const std::string& filename)
         {
             if (version != LevelVersion::Tomb4)
             {
                 return false;
             }
 
-            std::wstring transformed;
-            std::transform(filename.begin(), filename.end(), std::back_inserter(transformed), towupper);
-            return transformed.find(L".TRC") != filename.npos;
+            std::string transformed;
+            std::transform(filename.begin(), filename.end(), std::back_inserter(transformed),
+                [](char c) { return static_cast<char>(std::toupper(static_cast<unsigned char>(c))); });
+            return transformed.find(".TRC") != filename.npos;
         }
 
-        void skip(std::istream& file, uint32_t size)
+        void skip_xela(DataReader& reader)
         {
-            file.seekg(size, std::ios::cur);
+            reader.skip(4);
         }
 
-        void skip_xela(std::istream& file)
+        /// Read a vector if the section it belongs to is being loaded, otherwise skip past it.
+        /// @param reader The reader to use.
+        /// @param load Whether to load the vector.
+        /// @returns The vector, or an empty vector if it was skipped.
+        template < typename SizeType, typename DataType >
+        std::vector<DataType> read_or_skip_vector(DataReader& reader, bool load)
         {
-            skip(file, 4);
+            if (load)
+            {
+                return reader.read_vector<SizeType, DataType>();
+            }
+            reader.skip_vector<SizeType, DataType>();
+            return std::vector<DataType>();
         }
 
-        void load_tr1_4_room(std::istream& file, tr3_room& room, LevelVersion version)
+        void load_tr1_4_room(DataReader& reader, tr3_room& room, LevelVersion version)
         {
-            room.info = convert_room_info(read<tr1_4_room_info>(file));
+            room.info = convert_room_info(reader.read<tr1_4_room_info>());
 
-            uint32_t NumDataWords = read<uint32_t>(file);
+            uint32_t NumDataWords = reader.read<uint32_t>();
 
             // Read actual room data.
             if (NumDataWords > 0)
             {
                 if (version == LevelVersion::Tomb1)
                 {
-                    room.data.vertices = convert_vertices(read_vector<int16_t, tr_room_vertex>(file));
+                    room.data.vertices = convert_vertices(reader.read_vector<int16_t, tr_room_vertex>());
                 }
                 else
                 {
-                    room.data.vertices = read_vector<int16_t, tr3_room_vertex>(file);
+                    room.data.vertices = reader.read_vector<int16_t, tr3_room_vertex>();
                 }
-                room.data.rectangles = convert_rectangles(read_vector<int16_t, tr_face4>(file));
-                room.data.triangles = convert_triangles(read_vector<int16_t, tr_face3>(file));
-                room.data.sprites = read_vector<int16_t, tr_room_sprite>(file);
+                room.data.rectangles = convert_rectangles(reader.read_vector<int16_t, tr_face4>());
+                room.data.triangles = convert_triangles(reader.read_vector<int16_t, tr_face3>());
+                room.data.sprites = reader.read_vector<int16_t, tr_room_sprite>();
             }
 
-            room.portals = read_vector<uint16_t, tr_room_portal>(file);
+            room.portals = reader.read_vector<uint16_t, tr_room_portal>();
 
-            room.num_z_sectors = read<uint16_t>(file);
-            room.num_x_sectors = read<uint16_t>(file);
-            room.sector_list = read_vector<tr_room_sector>(file, room.num_z_sectors * room.num_x_sectors);
+            room.num_z_sectors = reader.read<uint16_t>();
+            room.num_x_sectors = reader.read<uint16_t>();
+            room.sector_list = reader.read_vector<tr_room_sector>(room.num_z_sectors * room.num_x_sectors);
 
             if (version == LevelVersion::Tomb4)
             {
-                room.room_colour = read<uint32_t>(file);
+                room.room_colour = reader.read<uint32_t>();
             }
             else
             {
-                room.ambient_intensity_1 = read<int16_t>(file);
+                room.ambient_intensity_1 = reader.read<int16_t>();
 
                 if (version > LevelVersion::Tomb1)
                 {
-                    room.ambient_intensity_2 = read<int16_t>(file);
+                    room.ambient_intensity_2 = reader.read<int16_t>();
                 }
             }
 
             if (version == LevelVersion::Tomb2)
             {
-                room.light_mode = read<int16_t>(file);
+                room.light_mode = reader.read<int16_t>();
             }
 
             if (version == LevelVersion::Tomb1)
             {
-                room.lights = convert_lights(read_vector<uint16_t, tr_room_light>(file));
+                room.lights = convert_lights(reader.read_vector<uint16_t, tr_room_light>());
             }
             else if (version == LevelVersion::Tomb4)
             {
-                auto lights = read_vector<uint16_t, tr4_room_light>(file);
+                auto lights = reader.read_vector<uint16_t, tr4_room_light>();
             }
             else
             {
-                room.lights = read_vector<uint16_t, tr3_room_light>(file);
+                room.lights = reader.read_vector<uint16_t, tr3_room_light>();
             }
 
             if (version == LevelVersion::Tomb1)
             {
-                room.static_meshes = convert_room_static_meshes(read_vector<uint16_t, tr_room_staticmesh>(file));
+                room.static_meshes = convert_room_static_meshes(reader.read_vector<uint16_t, tr_room_staticmesh>());
             }
             else
             {
-                room.static_meshes = read_vector<uint16_t, tr3_room_staticmesh>(file);
+                room.static_meshes = reader.read_vector<uint16_t, tr3_room_staticmesh>();
             }
 
-            room.alternate_room = read<int16_t>(file);
-            room.flags = read<int16_t>(file);
+            room.alternate_room = reader.read<int16_t>();
+            room.flags = reader.read<int16_t>();
 
             if (version >= LevelVersion::Tomb3)
             {
-                room.water_scheme = read<uint8_t>(file);
-                room.reverb_info = read<uint8_t>(file);
-                room.alternate_group = read<uint8_t>(file);
+                room.water_scheme = reader.read<uint8_t>();
+                room.reverb_info = reader.read<uint8_t>();
+                room.alternate_group = reader.read<uint8_t>();
+            }
+        }
+
+        /// Add the vertex offset of a layer to the vertex indices of the faces from that layer.
+        template < typename Face >
+        void rebase_faces(Face* faces, std::size_t count, uint16_t vertex_offset)
+        {
+            if (!vertex_offset)
+            {
+                return;
+            }
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                for (auto& v : faces[i].vertices)
+                {
+                    v += vertex_offset;
+                }
             }
         }
 
-        void load_tr5_room(std::istream& file, tr3_room& room)
+        /// Read the size of a room and return a reader over the room data.
+        DataReader read_tr5_room_block(DataReader& reader)
         {
-            skip_xela(file);
-            uint32_t room_data_size = read<uint32_t>(file);
-            const uint32_t room_start = static_cast<uint32_t>(file.tellg());
-            const uint32_t room_end = room_start + room_data_size;
+            skip_xela(reader);
+            const uint32_t room_data_size = reader.read<uint32_t>();
+            return reader.read_block(room_data_size);
+        }
 
-            const auto header = read<tr5_room_header>(file);
+        /// Parse a room from the block returned by read_tr5_room_block.
+        void load_tr5_room(DataReader& reader, tr3_room& room)
+        {
+            const auto header = reader.read<tr5_room_header>();
 
             // Copy useful data from the header to the room.
             room.info = header.info;
@@ -199,112 +232,350 @@ namespace trlevel
             room.flags = header.flags;
 
             // The offsets start measuring from this position, after all the header information.
-            const uint32_t data_start = static_cast<uint32_t>(file.tellg());
-
-            // Discard lights as they are not currently used:
-            skip(file, sizeof(tr5_room_light) * header.num_lights);
+            // Lights are skipped as they are not currently used.
+            const uint32_t data_start = static_cast<uint32_t>(reader.position());
 
-            file.seekg(data_start + header.start_sd_offset, std::ios::beg);
-            room.sector_list = read_vector<tr_room_sector>(file, room.num_z_sectors * room.num_x_sectors);
-            room.portals = read_vector<uint16_t, tr_room_portal>(file);
+            reader.seek(data_start + header.start_sd_offset);
+            room.sector_list = reader.read_vector<tr_room_sector>(room.num_z_sectors * room.num_x_sectors);
+            room.portals = reader.read_vector<uint16_t, tr_room_portal>();
 
-            // Separator
-            skip(file, 2);
+            reader.seek(data_start + header.end_portal_offset);
+            room.static_meshes = reader.read_vector<tr3_room_staticmesh>(header.num_static_meshes);
 
-            file.seekg(data_start + header.end_portal_offset, std::ios::beg);
-            room.static_meshes = read_vector<tr3_room_staticmesh>(file, header.num_static_meshes);
+            reader.seek(data_start + header.layer_offset);
+            const auto layers = reader.read_vector<tr5_room_layer>(header.num_layers);
 
-            file.seekg(data_start + header.layer_offset, std::ios::beg);
-            auto layers = read_vector<tr5_room_layer>(file, header.num_layers);
+            std::size_t num_rectangles = 0;
+            std::size_t num_triangles = 0;
+            std::size_t num_vertices = 0;
+            for (const auto& layer : layers)
+            {
+                num_rectangles += layer.num_rectangles;
+                num_triangles += layer.num_triangles;
+                num_vertices += layer.num_vertices;
+            }
 
-            file.seekg(data_start + header.poly_offset, std::ios::beg);
+            // The faces of each layer are stored together, rectangles then triangles, so copy them
+            // straight into place and then add the vertex offset of the layer.
+            room.data.rectangles.resize(num_rectangles);
+            room.data.triangles.resize(num_triangles);
+            reader.seek(data_start + header.poly_offset);
+            std::size_t rectangle = 0;
+            std::size_t triangle = 0;
             uint16_t vertex_offset = 0;
             for (const auto& layer : layers)
             {
-                auto rects = read_vector<tr4_mesh_face4>(file, layer.num_rectangles);
-                for (auto& rect : rects)
+                tr4_mesh_face4* rectangles = room.data.rectangles.data() + rectangle;
+                tr4_mesh_face3* triangles = room.data.triangles.data() + triangle;
+                reader.read_into(rectangles, layer.num_rectangles);
+                reader.read_into(triangles, layer.num_triangles);
+                rebase_faces(rectangles, layer.num_rectangles, vertex_offset);
+                rebase_faces(triangles, layer.num_triangles, vertex_offset);
+                rectangle += layer.num_rectangles;
+                triangle += layer.num_triangles;
+                vertex_offset += layer.num_vertices;
+            }
+
+            // The vertices of all of the layers are contiguous.
+            reader.seek(data_start + header.vertices_offset);
+            room.data.vertices = convert_vertices(reader.read_vector<tr5_room_vertex>(num_vertices));
+        }
+
+        void skip_tr1_4_room(DataReader& reader, LevelVersion version)
+        {
+            reader.skip(sizeof(tr1_4_room_info));
+
+            uint32_t NumDataWords = reader.read<uint32_t>();
+            if (NumDataWords > 0)
+            {
+                if (version == LevelVersion::Tomb1)
                 {
-                    for (auto& v : rect.vertices)
-                    {
-                        v += vertex_offset;
-                    }
+                    reader.skip_vector<int16_t, tr_room_vertex>();
                 }
-                std::copy(rects.begin(), rects.end(), std::back_inserter(room.data.rectangles));
+                else
+                {
+                    reader.skip_vector<int16_t, tr3_room_vertex>();
+                }
+                reader.skip_vector<int16_t, tr_face4>();
+                reader.skip_vector<int16_t, tr_face3>();
+                reader.skip_vector<int16_t, tr_room_sprite>();
+            }
+
+            reader.skip_vector<uint16_t, tr_room_portal>();
 
-                auto tris = read_vector<tr4_mesh_face3>(file, layer.num_triangles);
-                for (auto& tri : tris)
+            const uint16_t num_z_sectors = reader.read<uint16_t>();
+            const uint16_t num_x_sectors = reader.read<uint16_t>();
+            reader.skip_vector<tr_room_sector>(num_z_sectors * num_x_sectors);
+
+            if (version == LevelVersion::Tomb4)
+            {
+                reader.skip(sizeof(uint32_t));
+            }
+            else
+            {
+                reader.skip(sizeof(int16_t));
+                if (version > LevelVersion::Tomb1)
                 {
-                    for (auto& v : tri.vertices)
-                    {
-                        v += vertex_offset;
-                    }
+                    reader.skip(sizeof(int16_t));
                 }
-                std::copy(tris.begin(), tris.end(), std::back_inserter(room.data.triangles));
+            }
 
-                vertex_offset += layer.num_vertices;
+            if (version == LevelVersion::Tomb2)
+            {
+                reader.skip(sizeof(int16_t));
             }
 
-            file.seekg(data_start + header.vertices_offset, std::ios::beg);
-            for (const auto& layer : layers)
+            if (version == LevelVersion::Tomb1)
+            {
+                reader.skip_vector<uint16_t, tr_room_light>();
+                reader.skip_vector<uint16_t, tr_room_staticmesh>();
+            }
+            else
+            {
+                if (version == LevelVersion::Tomb4)
+                {
+                    reader.skip_vector<uint16_t, tr4_room_light>();
+                }
+                else
+                {
+                    reader.skip_vector<uint16_t, tr3_room_light>();
+                }
+                reader.skip_vector<uint16_t, tr3_room_staticmesh>();
+            }
+
+            // Alternate room and flags.
+            reader.skip(sizeof(int16_t) * 2);
+
+            if (version >= LevelVersion::Tomb3)
+            {
+                // Water scheme, reverb and alternate group.
+                reader.skip(3);
+            }
+        }
+
+        void skip_tr5_room(DataReader& reader)
+        {
+            skip_xela(reader);
+            reader.skip(reader.read<uint32_t>());
+        }
+
+        void write_room(DataWriter& writer, const tr3_room& room)
+        {
+            writer.write(room.info);
+            writer.write_sized_vector<uint32_t>(room.data.vertices);
+            writer.write_sized_vector<uint32_t>(room.data.rectangles);
+            writer.write_sized_vector<uint32_t>(room.data.triangles);
+            writer.write_sized_vector<uint32_t>(room.data.sprites);
+            writer.write_sized_vector<uint32_t>(room.portals);
+            writer.write(room.num_z_sectors);
+            writer.write(room.num_x_sectors);
+            writer.write_sized_vector<uint32_t>(room.sector_list);
+            writer.write(room.colour);
+            writer.write(room.ambient_intensity_1);
+            writer.write(room.ambient_intensity_2);
+            writer.write(room.light_mode);
+            writer.write_sized_vector<uint32_t>(room.lights);
+            writer.write_sized_vector<uint32_t>(room.static_meshes);
+            writer.write(room.alternate_room);
+            writer.write(room.flags);
+            writer.write(room.water_scheme);
+            writer.write(room.reverb_info);
+            writer.write(room.alternate_group);
+            writer.write(room.room_colour);
+        }
+
+        tr3_room read_room(DataReader& reader)
+        {
+            tr3_room room;
+            reader.read(room.info);
+            room.data.vertices = reader.read_vector<uint32_t, tr3_room_vertex>();
+            room.data.rectangles = reader.read_vector<uint32_t, tr4_mesh_face4>();
+            room.data.triangles = reader.read_vector<uint32_t, tr4_mesh_face3>();
+            room.data.sprites = reader.read_vector<uint32_t, tr_room_sprite>();
+            room.portals = reader.read_vector<uint32_t, tr_room_portal>();
+            reader.read(room.num_z_sectors);
+            reader.read(room.num_x_sectors);
+            room.sector_list = reader.read_vector<uint32_t, tr_room_sector>();
+            reader.read(room.colour);
+            reader.read(room.ambient_intensity_1);
+            reader.read(room.ambient_intensity_2);
+            reader.read(room.light_mode);
+            room.lights = reader.read_vector<uint32_t, tr3_room_light>();
+            room.static_meshes = reader.read_vector<uint32_t, tr3_room_staticmesh>();
+            reader.read(room.alternate_room);
+            reader.read(room.flags);
+            reader.read(room.water_scheme);
+            reader.read(room.reverb_info);
+            reader.read(room.alternate_group);
+            reader.read(room.room_colour);
+            return room;
+        }
+
+        void write_mesh(DataWriter& writer, const tr_mesh& mesh)
+        {
+            writer.write(mesh.centre);
+            writer.write(mesh.coll_radius);
+            writer.write_sized_vector<uint32_t>(mesh.vertices);
+            writer.write_sized_vector<uint32_t>(mesh.normals);
+            writer.write_sized_vector<uint32_t>(mesh.lights);
+            writer.write_sized_vector<uint32_t>(mesh.textured_rectangles);
+            writer.write_sized_vector<uint32_t>(mesh.textured_triangles);
+            writer.write_sized_vector<uint32_t>(mesh.coloured_rectangles);
+            writer.write_sized_vector<uint32_t>(mesh.coloured_triangles);
+        }
+
+        tr_mesh read_mesh(DataReader& reader)
+        {
+            tr_mesh mesh;
+            reader.read(mesh.centre);
+            reader.read(mesh.coll_radius);
+            mesh.vertices = reader.read_vector<uint32_t, tr_vertex>();
+            mesh.normals = reader.read_vector<uint32_t, tr_vertex>();
+            mesh.lights = reader.read_vector<uint32_t, int16_t>();
+            mesh.textured_rectangles = reader.read_vector<uint32_t, tr4_mesh_face4>();
+            mesh.textured_triangles = reader.read_vector<uint32_t, tr4_mesh_face3>();
+            mesh.coloured_rectangles = reader.read_vector<uint32_t, tr_face4>();
+            mesh.coloured_triangles = reader.read_vector<uint32_t, tr_face3>();
+            return mesh;
+        }
+
+        /// Decode a mesh from the mesh data.
+        /// @param reader The reader positioned at the start of the mesh.
+        /// @param version The version of the level.
+        /// @returns The mesh.
+        tr_mesh decode_mesh(DataReader& reader, LevelVersion version)
+        {
+            tr_mesh mesh;
+            mesh.centre = reader.read<tr_vertex>();
+            mesh.coll_radius = reader.read<int32_t>();
+            mesh.vertices = reader.read_vector<int16_t, tr_vertex>();
+
+            int16_t normals = reader.read<int16_t>();
+            if (normals > 0)
+            {
+                mesh.normals = reader.read_vector<tr_vertex>(normals);
+            }
+            else
+            {
+                mesh.lights = reader.read_vector<int16_t>(abs(normals));
+            }
+
+            if (version < LevelVersion::Tomb4)
             {
-                auto verts = convert_vertices(read_vector<tr5_room_vertex>(file, layer.num_vertices));
-                std::copy(verts.begin(), verts.end(), std::back_inserter(room.data.vertices));
+                mesh.textured_rectangles = convert_rectangles(reader.read_vector<int16_t, tr_face4>());
+                mesh.textured_triangles = convert_triangles(reader.read_vector<int16_t, tr_face3>());
+                mesh.coloured_rectangles = reader.read_vector<int16_t, tr_face4>();
+                mesh.coloured_triangles = reader.read_vector<int16_t, tr_face3>();
             }
+            else
+            {
+                mesh.textured_rectangles = reader.read_vector<int16_t, tr4_mesh_face4>();
+                mesh.textured_triangles = reader.read_vector<int16_t, tr4_mesh_face3>();
+            }
+            return mesh;
+        }
+
+        /// Free the memory used by a vector.
+        template <typename T>
+        void release(std::vector<T>& values)
+        {
+            std::vector<T>().swap(values);
+        }
+
+        /// Get the number of bytes allocated by a vector.
+        template <typename T>
+        std::size_t allocated_bytes(const std::vector<T>& values)
+        {
+            return values.capacity() * sizeof(T);
+        }
 
-            file.seekg(room_end, std::ios::beg);
+        std::size_t allocated_bytes(const tr3_room& room)
+        {
+            return allocated_bytes(room.data.vertices) + allocated_bytes(room.data.rectangles) + allocated_bytes(room.data.triangles) +
+                allocated_bytes(room.data.sprites) + allocated_bytes(room.portals) + allocated_bytes(room.sector_list) +
+                allocated_bytes(room.lights) + allocated_bytes(room.static_meshes);
+        }
+
+        std::size_t allocated_bytes(const tr_mesh& mesh)
+        {
+            return allocated_bytes(mesh.vertices) + allocated_bytes(mesh.normals) + allocated_bytes(mesh.lights) +
+                allocated_bytes(mesh.textured_rectangles) + allocated_bytes(mesh.textured_triangles) +
+                allocated_bytes(mesh.coloured_rectangles) + allocated_bytes(mesh.coloured_triangles);
         }
     }
 
-    Level::Level(const std::string& filename)
+    Level::Level(const std::string& filename, const LoadOptions& options, const LoadCallbacks& callbacks)
+        : _options(options)
     {
         // Load the level from the file.
         try
         {
-            // Convert the filename to UTF-16
-            auto converted = trview::to_utf16(filename);
-
-            std::ifstream file;
-            file.exceptions(std::ifstream::failbit | std::ifstream::badbit | std::ifstream::eofbit);
-            file.open(converted.c_str(), std::ios::binary);
+            trview::MappedFile file(filename);
+            DataReader reader(file.data(), file.size());
 
-            _version = convert_level_version(read<uint32_t>(file));
-            if (is_tr5(_version, converted))
+            _version = convert_level_version(reader.read<uint32_t>());
+            if (is_tr5(_version, filename))
             {
                 _version = LevelVersion::Tomb5;
             }
+            _summary.version = _version;
 
             if (_version >= LevelVersion::Tomb4)
             {
-                load_tr4(file);
+                load_tr4(reader, callbacks);
                 return;
             }
 
-            if (_version > LevelVersion::Tomb1)
+            if (_options.textures)
             {
-                _palette = read_vector<tr_colour>(file, 256);
-                _palette16 = read_vector<tr_colour4>(file, 256);
-            }
+                if (_version > LevelVersion::Tomb1)
+                {
+                    _palette = reader.read_vector<tr_colour>(256);
+                    _palette16 = reader.read_vector<tr_colour4>(256);
+                }
 
-            _num_textiles = read<uint32_t>(file);
-            for (uint32_t i = 0; i < _num_textiles; ++i)
-            {
-                _textile8.emplace_back(read<tr_textile8>(file));
-            }
+                _num_textiles = reader.read<uint32_t>();
+                _summary.num_textiles = _num_textiles;
+                _textile8 = reader.read_vector<tr_textile8>(_num_textiles);
 
-            if (_version > LevelVersion::Tomb1)
+                if (_version > LevelVersion::Tomb1)
+                {
+                    _textile16 = reader.read_vector<tr_textile16>(_num_textiles);
+                }
+            }
+            else
             {
-                for (uint32_t i = 0; i < _num_textiles; ++i)
+                if (_version > LevelVersion::Tomb1)
                 {
-                    _textile16.emplace_back(read<tr_textile16>(file));
+                    reader.skip_vector<tr_colour>(256);
+                    reader.skip_vector<tr_colour4>(256);
+                }
+
+                const uint32_t num_textiles = reader.read<uint32_t>();
+                _summary.num_textiles = num_textiles;
+                reader.skip_vector<tr_textile8>(num_textiles);
+                if (_version > LevelVersion::Tomb1)
+                {
+                    reader.skip_vector<tr_textile16>(num_textiles);
                 }
             }
 
-            load_level_data(file);
+            load_level_data(reader, callbacks);
 
-            generate_meshes(_mesh_data);
+            if (_options.models)
+            {
+                generate_meshes(_mesh_data);
+                release(_mesh_data);
+                _poses = PoseCache(_version, _frames, _models, _animations);
+            }
         }
         catch(const std::exception&)
         {
+            // Anything using the rooms has to stop before they are released.
+            if (callbacks.load_failed)
+            {
+                callbacks.load_failed();
+            }
             throw LevelLoadException();
         }
     }
@@ -315,52 +586,25 @@ namespace trlevel
 
     void Level::generate_meshes(const std::vector<uint16_t>& mesh_data)
     {
-        // As well as reading the actual mesh data, generate a map of mesh_pointer to 
-        // mesh. It seems that a lot of the pointers point to the same mesh.
-
-        std::string data(reinterpret_cast<const char*>(&mesh_data[0]), mesh_data.size() * sizeof(uint16_t));
-        std::istringstream stream(data, std::ios::binary);
-        stream.exceptions(std::istream::failbit | std::istream::badbit | std::istream::eofbit);
-        for (auto pointer : _mesh_pointers)
+        // A lot of the mesh pointers point to the same mesh, so find the distinct pointers first
+        // and only decode each mesh once.
+        std::vector<uint32_t> pointers(_mesh_pointers);
+        std::sort(pointers.begin(), pointers.end());
+        pointers.erase(std::unique(pointers.begin(), pointers.end()), pointers.end());
+
+        _meshes.resize(pointers.size());
+        trview::parallel_for(trview::ThreadPool::shared(), pointers.size(), [&](std::size_t index)
         {
-            // Does the map already contain this mesh? If so, don't bother reading it again.
-            auto found = _meshes.find(pointer);
-            if (found != _meshes.end())
-            {
-                continue;
-            }
-
-            stream.seekg(pointer, std::ios::beg);
-
-            tr_mesh mesh;
-            mesh.centre = read<tr_vertex>(stream);
-            mesh.coll_radius = read<int32_t>(stream);
-            mesh.vertices = read_vector<int16_t, tr_vertex>(stream);
-
-            int16_t normals = read<int16_t>(stream);
-            if (normals > 0)
-            {
-                mesh.normals = read_vector<tr_vertex>(stream, normals);
-            }
-            else
-            {
-                mesh.lights = read_vector<int16_t>(stream, abs(normals));
-            }
-
-            if (_version < LevelVersion::Tomb4)
-            {
-                mesh.textured_rectangles = convert_rectangles(read_vector<int16_t, tr_face4>(stream));
-                mesh.textured_triangles = convert_triangles(read_vector<int16_t, tr_face3>(stream));
-                mesh.coloured_rectangles = read_vector<int16_t, tr_face4>(stream);
-                mesh.coloured_triangles = read_vector<int16_t, tr_face3>(stream);
-            }
-            else
-            {
-                mesh.textured_rectangles = read_vector<int16_t, tr4_mesh_face4>(stream);
-                mesh.textured_triangles = read_vector<int16_t, tr4_mesh_face3>(stream);
-            }
+            DataReader reader(reinterpret_cast<const uint8_t*>(mesh_data.data()), mesh_data.size() * sizeof(uint16_t));
+            reader.seek(pointers[index]);
+            _meshes[index] = decode_mesh(reader, _version);
+        });
 
-            _meshes.insert({ pointer, mesh });
+        _mesh_indices.resize(_mesh_pointers.size());
+        for (std::size_t i = 0; i < _mesh_pointers.size(); ++i)
+        {
+            const auto found = std::lower_bound(pointers.begin(), pointers.end(), _mesh_pointers[i]);
+            _mesh_indices[i] = static_cast<uint32_t>(found - pointers.begin());
         }
     }
 
@@ -410,45 +654,42 @@ namespace trlevel
     std::vector<uint32_t> Level::get_textile(uint32_t index) const
     {
         std::vector<uint32_t> results;
-        results.reserve(256 * 256);
+        get_textile(index, results);
+        return results;
+    }
 
+    void Level::get_textile(uint32_t index, std::vector<uint32_t>& output) const
+    {
         if (index < _textile32.size())
         {
             const auto& textile = _textile32[index];
-            std::transform(textile.Tile,
-                textile.Tile + sizeof(textile.Tile) / sizeof(uint32_t),
-                std::back_inserter(results),
-                convert_textile32);
+            const auto pixels = sizeof(textile.Tile) / sizeof(uint32_t);
+            output.resize(pixels);
+            convert_textile32(textile.Tile, output.data(), pixels);
         }
         else if (index < _textile16.size())
         {
             const auto& textile = _textile16[index];
-            std::transform(textile.Tile, 
-                textile.Tile + sizeof(textile.Tile) / sizeof(uint16_t),  
-                std::back_inserter(results),
-                convert_textile16);
+            const auto pixels = sizeof(textile.Tile) / sizeof(uint16_t);
+            output.resize(pixels);
+            convert_textile16(textile.Tile, output.data(), pixels);
         }
         else
         {
+            // The first entry in the 8 bit palette is the transparent colour, so just use
+            // fully transparent instead of replacing it later.
+            std::array<uint32_t, 256> palette{};
+            for (uint32_t i = 1; i < palette.size(); ++i)
+            {
+                auto entry = get_palette_entry(i);
+                palette[i] = 0xff000000 | entry.Blue << 16 | entry.Green << 8 | entry.Red;
+            }
+
             const auto& textile = _textile8[index];
-            std::transform(textile.Tile,
-                textile.Tile + sizeof(textile.Tile) / sizeof(uint8_t),
-                std::back_inserter(results),
-                [&](uint8_t entry_index)
-            {
-                // The first entry in the 8 bit palette is the transparent colour, so just return 
-                // fully transparent instead of replacing it later.
-                if (entry_index == 0)
-                {
-                    return 0x00000000u;
-                }
-                auto entry = get_palette_entry(entry_index);
-                uint32_t value = 0xff000000 | entry.Blue << 16 | entry.Green << 8 | entry.Red;
-                return value;
-            });
+            const auto pixels = sizeof(textile.Tile) / sizeof(uint8_t);
+            output.resize(pixels);
+            convert_textile8(textile.Tile, palette.data(), output.data(), pixels);
         }
-
-        return results;
     }
 
     uint32_t Level::num_rooms() const
@@ -461,6 +702,11 @@ namespace trlevel
         return _rooms[index];
     }
 
+    const tr3_room& Level::room(uint32_t index) const
+    {
+        return _rooms[index];
+    }
+
     uint32_t Level::num_object_textures() const
     {
         return static_cast<uint32_t>(_object_textures.size());
@@ -487,6 +733,11 @@ namespace trlevel
         return _floor_data;
     }
 
+    const std::vector<std::uint16_t>& Level::floor_data() const
+    {
+        return _floor_data;
+    }
+
     uint32_t Level::num_entities() const
     {
         return static_cast<uint32_t>(_entities.size());
@@ -509,15 +760,13 @@ namespace trlevel
 
     bool Level::get_model_by_id(uint32_t id, tr_model& output) const 
     {
-        for (const auto& model : _models)
+        uint32_t index = 0;
+        if (!_model_ids.find(id, index))
         {
-            if (model.ID == id)
-            {
-                output = model;
-                return true;
-            }
+            return false;
         }
-        return false;
+        output = _models[index];
+        return true;
     }
 
     uint32_t Level::num_static_meshes() const
@@ -537,8 +786,12 @@ namespace trlevel
 
     tr_mesh Level::get_mesh_by_pointer(uint32_t mesh_pointer) const
     {
-        auto index = _mesh_pointers[mesh_pointer];
-        return _meshes.find(index)->second;
+        return mesh(mesh_pointer);
+    }
+
+    const tr_mesh& Level::mesh(uint32_t mesh_pointer) const
+    {
+        return _meshes[_mesh_indices[mesh_pointer]];
     }
 
     std::vector<tr_meshtree_node> Level::get_meshtree(uint32_t starting_index, uint32_t node_count) const
@@ -557,85 +810,250 @@ namespace trlevel
         return nodes;
     }
 
+    Span<tr_meshtree_node> Level::meshtree(uint32_t starting_index, uint32_t node_count) const
+    {
+        // The mesh tree is stored as a flat array of 32 bit values, four per node, which is the same layout
+        // as the packed node structure - so the nodes can be viewed in place.
+        static_assert(sizeof(tr_meshtree_node) == 4 * sizeof(uint32_t), "Mesh tree node must be four 32 bit values");
+        if (node_count == 0)
+        {
+            return Span<tr_meshtree_node>();
+        }
+        if (starting_index > _meshtree.size() || node_count > (_meshtree.size() - starting_index) / 4)
+        {
+            throw std::out_of_range("Mesh tree range is outside of the mesh tree");
+        }
+        return Span<tr_meshtree_node>(reinterpret_cast<const tr_meshtree_node*>(&_meshtree[starting_index]), node_count);
+    }
+
     tr2_frame Level::get_frame(uint32_t frame_offset, uint32_t mesh_count) const
     {
-        uint32_t offset = frame_offset;
         tr2_frame frame;
-        frame.bb1x = _frames[offset++];
-        frame.bb1y = _frames[offset++];
-        frame.bb1z = _frames[offset++];
-        frame.bb2x = _frames[offset++];
-        frame.bb2y = _frames[offset++];
-        frame.bb2z = _frames[offset++];
-        frame.offsetx = _frames[offset++];
-        frame.offsety = _frames[offset++];
-        frame.offsetz = _frames[offset++];
-
-        // Tomb Raider I has the mesh count in the frame structure - all other tombs
-        // already know based on the number of meshes.
-        if (_version == LevelVersion::Tomb1)
+        get_frame(frame_offset, mesh_count, frame);
+        return frame;
+    }
+
+    void Level::get_frame(uint32_t frame_offset, uint32_t mesh_count, tr2_frame& frame) const
+    {
+        if (!decode_frame(_version, _frames, frame_offset, mesh_count, frame))
         {
-            mesh_count = _frames[offset++];
+            throw std::out_of_range("Frame is outside of the frame data");
         }
+    }
 
-        for (uint32_t i = 0; i < mesh_count; ++i)
-        {
-            tr2_frame_rotation rotation;
+    Span<tr4_animation> Level::animations() const
+    {
+        return _animations;
+    }
 
-            uint16_t next = 0;
-            uint16_t data = 0;
-            uint16_t mode = 0;
+    Span<tr_state_change> Level::state_changes() const
+    {
+        return _state_changes;
+    }
 
-            // Tomb Raider I has reversed words and always uses the two word format.
-            if (_version == LevelVersion::Tomb1)
-            {
-                next = _frames[offset++];
-                data = _frames[offset++];
-            }
-            else
+    Span<tr_anim_dispatch> Level::anim_dispatches() const
+    {
+        return _anim_dispatches;
+    }
+
+    Span<tr_anim_command> Level::anim_commands() const
+    {
+        return _anim_commands;
+    }
+
+    uint32_t Level::num_model_frames(uint32_t model_index) const
+    {
+        return _poses.num_model_frames(model_index);
+    }
+
+    void Level::get_world_transforms(Span<PoseInstance> instances, std::vector<DirectX::SimpleMath::Matrix>& transforms) const
+    {
+        transforms.clear();
+
+        std::size_t total = 0;
+        for (const auto& instance : instances)
+        {
+            // The models are released when the level is trimmed, so this is checked on every call.
+            if (instance.model >= _models.size())
             {
-                data = _frames[offset++];
-                mode = data & 0xC000;
-                if (!mode)
-                {
-                    next = _frames[offset++];
-                }
+                throw std::out_of_range("Model is outside of the models of the level");
             }
+            total += _models[instance.model].NumMeshes;
+        }
+        transforms.resize(total);
 
-            if (mode)
+        DirectX::SimpleMath::Matrix* output = transforms.data();
+        for (const auto& instance : instances)
+        {
+            const auto& model = _models[instance.model];
+            if (model.NumMeshes == 0)
             {
-                float angle = 0;
-                if (_version >= LevelVersion::Tomb4)
-                {
-                    angle = (data & 0x0fff) * PiMul2 / 4096.0f;
-                }
-                else
-                {
-                    angle = (data & 0x03ff) * PiMul2 / 1024.0f;
-                }
-
-                if (mode == 0x4000)
-                {
-                    rotation.x = angle;
-                }
-                else if (mode == 0x8000)
-                {
-                    rotation.y = angle;
-                }
-                else if (mode == 0xC000)
-                {
-                    rotation.z = angle;
-                }
+                continue;
             }
-            else
+
+            if (instance.frame >= _poses.num_model_frames(instance.model))
             {
-                rotation.x = ((data & 0x3ff0) >> 4) * PiMul2 / 1024.0f;
-                rotation.y = ((((data & 0x000f) << 6)) | ((next & 0xfc00) >> 10)) * PiMul2 / 1024.0f;
-                rotation.z = (next & 0x03ff) * PiMul2 / 1024.0f;
+                throw std::out_of_range("Frame is outside of the frames of the model");
             }
-            frame.values.push_back(rotation);
+
+            _poses.evaluate(instance.model, instance.frame, meshtree(model.MeshTree, model.NumMeshes - 1u), instance.world, output);
+            output += model.NumMeshes;
         }
-        return frame;
+    }
+
+    uint32_t Level::num_sound_samples() const
+    {
+        return static_cast<uint32_t>(_sound_samples.size());
+    }
+
+    std::vector<uint8_t> Level::get_sound_sample(uint32_t index) const
+    {
+        return _sound_samples[index].sound_data;
+    }
+
+    const LevelSummary& Level::summary() const
+    {
+        return _summary;
+    }
+
+    void Level::save_cache(DataWriter& writer) const
+    {
+        writer.write(_version);
+        writer.write(_options);
+        writer.write(_summary);
+
+        writer.write_sized_vector<uint32_t>(_palette);
+        writer.write_sized_vector<uint32_t>(_palette16);
+        writer.write(_num_textiles);
+        writer.write_sized_vector<uint32_t>(_textile8);
+        writer.write_sized_vector<uint32_t>(_textile16);
+        writer.write_sized_vector<uint32_t>(_textile32);
+
+        writer.write(static_cast<uint32_t>(_rooms.size()));
+        for (const auto& room : _rooms)
+        {
+            write_room(writer, room);
+        }
+
+        writer.write_sized_vector<uint32_t>(_object_textures);
+        writer.write_sized_vector<uint32_t>(_floor_data);
+        writer.write_sized_vector<uint32_t>(_models);
+        writer.write_sized_vector<uint32_t>(_entities);
+
+        writer.write(static_cast<uint32_t>(_static_meshes.size()));
+        for (const auto& mesh : _static_meshes)
+        {
+            writer.write(mesh.second);
+        }
+
+        writer.write(_lara_type);
+        writer.write(_weather_type);
+
+        // The meshes are stored already generated so that loading from the cache doesn't need the mesh data.
+        writer.write(static_cast<uint32_t>(_meshes.size()));
+        for (const auto& mesh : _meshes)
+        {
+            write_mesh(writer, mesh);
+        }
+        writer.write_sized_vector<uint32_t>(_mesh_indices);
+
+        writer.write_sized_vector<uint32_t>(_mesh_pointers);
+        writer.write_sized_vector<uint32_t>(_animations);
+        writer.write_sized_vector<uint32_t>(_state_changes);
+        writer.write_sized_vector<uint32_t>(_anim_dispatches);
+        writer.write_sized_vector<uint32_t>(_anim_commands);
+        writer.write_sized_vector<uint32_t>(_meshtree);
+        writer.write_sized_vector<uint32_t>(_frames);
+        writer.write_sized_vector<uint32_t>(_sprite_textures);
+        writer.write_sized_vector<uint32_t>(_sprite_sequences);
+
+        writer.write(static_cast<uint32_t>(_sound_samples.size()));
+        for (const auto& sample : _sound_samples)
+        {
+            writer.write_sized_vector<uint32_t>(sample.sound_data);
+        }
+    }
+
+    std::unique_ptr<Level> Level::load_cache(DataReader& reader)
+    {
+        std::unique_ptr<Level> level(new Level());
+        reader.read(level->_version);
+        reader.read(level->_options);
+        reader.read(level->_summary);
+
+        level->_palette = reader.read_vector<uint32_t, tr_colour>();
+        level->_palette16 = reader.read_vector<uint32_t, tr_colour4>();
+        reader.read(level->_num_textiles);
+        level->_textile8 = reader.read_vector<uint32_t, tr_textile8>();
+        level->_textile16 = reader.read_vector<uint32_t, tr_textile16>();
+        level->_textile32 = reader.read_vector<uint32_t, tr_textile32>();
+
+        const auto num_rooms = reader.read<uint32_t>();
+        for (uint32_t i = 0; i < num_rooms; ++i)
+        {
+            level->_rooms.push_back(read_room(reader));
+        }
+
+        level->_object_textures = reader.read_vector<uint32_t, tr_object_texture>();
+        level->_floor_data = reader.read_vector<uint32_t, uint16_t>();
+        level->_models = reader.read_vector<uint32_t, tr_model>();
+        level->_entities = reader.read_vector<uint32_t, tr2_entity>();
+
+        const auto num_static_meshes = reader.read<uint32_t>();
+        for (uint32_t i = 0; i < num_static_meshes; ++i)
+        {
+            const auto mesh = reader.read<tr_staticmesh>();
+            level->_static_meshes.insert({ mesh.ID, mesh });
+        }
+
+        reader.read(level->_lara_type);
+        reader.read(level->_weather_type);
+
+        const auto num_meshes = reader.read<uint32_t>();
+        level->_meshes.reserve(num_meshes);
+        for (uint32_t i = 0; i < num_meshes; ++i)
+        {
+            level->_meshes.push_back(read_mesh(reader));
+        }
+        level->_mesh_indices = reader.read_vector<uint32_t, uint32_t>();
+
+        level->_mesh_pointers = reader.read_vector<uint32_t, uint32_t>();
+        level->_animations = reader.read_vector<uint32_t, tr4_animation>();
+        level->_state_changes = reader.read_vector<uint32_t, tr_state_change>();
+        level->_anim_dispatches = reader.read_vector<uint32_t, tr_anim_dispatch>();
+        level->_anim_commands = reader.read_vector<uint32_t, tr_anim_command>();
+        level->_meshtree = reader.read_vector<uint32_t, uint32_t>();
+        level->_frames = reader.read_vector<uint32_t, uint16_t>();
+        level->_sprite_textures = reader.read_vector<uint32_t, tr_sprite_texture>();
+        level->_sprite_sequences = reader.read_vector<uint32_t, tr_sprite_sequence>();
+
+        const auto num_sound_samples = reader.read<uint32_t>();
+        for (uint32_t i = 0; i < num_sound_samples; ++i)
+        {
+            level->_sound_samples.push_back({ reader.read_vector<uint32_t, uint8_t>() });
+        }
+
+        // A damaged entry has to fail here rather than when the tables are indexed later.
+        const auto textiles_valid = [&](std::size_t size) { return size == 0 || size == level->_num_textiles; };
+        const bool valid =
+            reader.position() == reader.size() &&
+            (level->_palette.empty() || level->_palette.size() == 256) &&
+            (level->_palette16.empty() || level->_palette16.size() == 256) &&
+            textiles_valid(level->_textile8.size()) &&
+            textiles_valid(level->_textile16.size()) &&
+            textiles_valid(level->_textile32.size()) &&
+            level->_mesh_indices.size() == level->_mesh_pointers.size() &&
+            std::all_of(level->_mesh_indices.begin(), level->_mesh_indices.end(),
+                [&](uint32_t index) { return index < level->_meshes.size(); });
+        if (!valid)
+        {
+            throw LevelLoadException();
+        }
+
+        // The decoded frames and the lookups are quick to rebuild so they aren't stored in the cache.
+        level->_poses = PoseCache(level->_version, level->_frames, level->_models, level->_animations);
+        level->generate_indices();
+        return level;
     }
 
     LevelVersion Level::get_version() const 
@@ -645,17 +1063,12 @@ namespace trlevel
 
     bool Level::get_sprite_sequence_by_id(int32_t sprite_sequence_id, tr_sprite_sequence& output) const
     {
-        auto found_sequence = std::find_if(_sprite_sequences.begin(), _sprite_sequences.end(), [=](const auto& sequence)
-        {
-            return sequence.SpriteID == sprite_sequence_id; 
-        });
-
-        if (found_sequence == _sprite_sequences.end())
+        uint32_t index = 0;
+        if (!_sprite_sequence_ids.find(static_cast<uint32_t>(sprite_sequence_id), index))
         {
             return false;
         }
-
-        output = *found_sequence;
+        output = _sprite_sequences[index];
         return true;
     }
 
@@ -664,111 +1077,193 @@ namespace trlevel
         return _sprite_textures[index];
     }
 
-    void Level::load_tr4(std::ifstream& file)
+    void Level::load_tr4(DataReader& reader, const LoadCallbacks& callbacks)
     {
-        uint16_t num_room_textiles = read<uint16_t>(file);
-        uint16_t num_obj_textiles = read<uint16_t>(file);
-        uint16_t num_bump_textiles = read<uint16_t>(file);
-        _num_textiles = num_room_textiles + num_obj_textiles + num_bump_textiles;
+        uint16_t num_room_textiles = reader.read<uint16_t>();
+        uint16_t num_obj_textiles = reader.read<uint16_t>();
+        uint16_t num_bump_textiles = reader.read<uint16_t>();
+        const uint32_t num_textiles = num_room_textiles + num_obj_textiles + num_bump_textiles;
+        _summary.num_textiles = num_textiles;
+
+        // Find the compressed chunks first and then inflate them all at the same time on the thread pool.
+        const auto textile32_chunk = read_compressed_chunk(reader);
+        const auto textile16_chunk = read_compressed_chunk(reader);
+        // The misc textiles (font and sky) are not used.
+        read_compressed_chunk(reader);
+
+        std::vector<CompressedChunk> sound_sample_chunks;
+
+        // The group will wait for any running tasks if loading fails, so it has to be declared after
+        // everything that the tasks write to.
+        trview::TaskGroup tasks(trview::ThreadPool::shared());
+        if (_options.textures)
+        {
+            _num_textiles = num_textiles;
+            tasks.run([&]() { _textile32 = decompress_vector<tr_textile32>(textile32_chunk, _num_textiles); });
+            tasks.run([&]() { _textile16 = decompress_vector<tr_textile16>(textile16_chunk, _num_textiles); });
+        }
 
-        _textile32 = read_vector_compressed<tr_textile32>(file, _num_textiles);
-        _textile16 = read_vector_compressed<tr_textile16>(file, _num_textiles);
-        auto textile32_misc = read_vector_compressed<tr_textile32>(file, 2);
+        auto read_sound_samples = [&]()
+        {
+            uint32_t num_sound_samples = reader.read<uint32_t>();
+            _summary.num_sound_samples = num_sound_samples;
+            for (uint32_t i = 0; i < num_sound_samples; ++i)
+            {
+                sound_sample_chunks.push_back(read_compressed_chunk(reader));
+            }
+
+            if (!_options.sound_samples)
+            {
+                return;
+            }
+
+            _sound_samples.resize(num_sound_samples);
+            for (uint32_t i = 0; i < num_sound_samples; ++i)
+            {
+                tasks.run([&, i]() { _sound_samples[i].sound_data = decompress(sound_sample_chunks[i]); });
+            }
+        };
 
         if (_version == LevelVersion::Tomb5)
         {
-            _lara_type = read<uint16_t>(file);
-            _weather_type = read<uint16_t>(file);
-            file.seekg(28, std::ios::cur);
+            _lara_type = reader.read<uint16_t>();
+            _weather_type = reader.read<uint16_t>();
+            reader.skip(28);
         }
 
         if (_version == LevelVersion::Tomb4)
         {
-            std::vector<uint8_t> level_data = read_compressed(file);
-            std::string data(reinterpret_cast<char*>(&level_data[0]), level_data.size());
-            std::istringstream data_stream(data, std::ios::binary);
-            load_level_data(data_stream);
+            const auto level_data_chunk = read_compressed_chunk(reader);
+            read_sound_samples();
+
+            std::vector<uint8_t> level_data = decompress(level_data_chunk);
+            DataReader level_reader(level_data);
+            load_level_data(level_reader, callbacks);
         }
         else
         {
             // Skip size of uncompressed and compressed level data as they are
             // unused in TR5.
-            skip(file, 8);
-            load_level_data(file);
+            reader.skip(8);
+            load_level_data(reader, callbacks);
+            reader.skip(6);
+            read_sound_samples();
         }
 
-        if (_version == LevelVersion::Tomb5)
-        {
-            skip(file, 6);
-        }
+        tasks.wait();
 
-        uint32_t num_sound_samples = read<uint32_t>(file);
-        std::vector<tr4_sample> sound_samples(num_sound_samples);
-        for (uint32_t i = 0; i < num_sound_samples; ++i)
+        if (_options.models)
         {
-            sound_samples[i].sound_data = read_compressed(file);
+            generate_meshes(_mesh_data);
+            release(_mesh_data);
+            _poses = PoseCache(_version, _frames, _models, _animations);
         }
-
-        generate_meshes(_mesh_data);
     }
 
-    void Level::load_level_data(std::istream& file)
+    void Level::load_level_data(DataReader& reader, const LoadCallbacks& callbacks)
     {
         // Read unused value.
-        read<uint32_t>(file);
+        reader.read<uint32_t>();
 
         uint32_t num_rooms = 0;
         if (_version == LevelVersion::Tomb5)
         {
-            num_rooms = read<uint32_t>(file);
+            num_rooms = reader.read<uint32_t>();
         }
         else
         {
-            num_rooms = read<uint16_t>(file);
+            num_rooms = reader.read<uint16_t>();
         }
+        _summary.num_rooms = num_rooms;
 
-        for (auto i = 0u; i < num_rooms; ++i)
+        if (_options.rooms && _version == LevelVersion::Tomb5)
         {
-            tr3_room room;
-            if (_version == LevelVersion::Tomb5)
+            // Each Tomb Raider V room is stored with its size, so the blocks can be found up front
+            // and then parsed at the same time.
+            std::vector<DataReader> blocks;
+            blocks.reserve(num_rooms);
+            for (auto i = 0u; i < num_rooms; ++i)
             {
-                load_tr5_room(file, room);
+                blocks.push_back(read_tr5_room_block(reader));
             }
-            else
+
+            std::vector<tr3_room> rooms(num_rooms);
+            trview::parallel_for(trview::ThreadPool::shared(), num_rooms, [&](std::size_t index)
             {
-                load_tr1_4_room(file, room, _version);
+                load_tr5_room(blocks[index], rooms[index]);
+                if (callbacks.room_loaded)
+                {
+                    callbacks.room_loaded(static_cast<uint32_t>(index), rooms[index]);
+                }
+            });
+
+            _rooms = std::move(rooms);
+        }
+        else
+        {
+            for (auto i = 0u; i < num_rooms; ++i)
+            {
+                if (!_options.rooms)
+                {
+                    if (_version == LevelVersion::Tomb5)
+                    {
+                        skip_tr5_room(reader);
+                    }
+                    else
+                    {
+                        skip_tr1_4_room(reader, _version);
+                    }
+                    continue;
+                }
+
+                tr3_room room;
+                load_tr1_4_room(reader, room, _version);
+                if (callbacks.room_loaded)
+                {
+                    callbacks.room_loaded(i, room);
+                }
+                _rooms.push_back(std::move(room));
             }
-            _rooms.push_back(room);
         }
 
-        _floor_data = read_vector<uint32_t, uint16_t>(file);
+        _floor_data = read_or_skip_vector<uint32_t, uint16_t>(reader, _options.rooms);
+
+        // Nothing after this point changes the rooms or the floordata, so they can be used while the rest is read.
+        if (_options.rooms && callbacks.rooms_loaded)
+        {
+            callbacks.rooms_loaded(*this);
+        }
+
+        _mesh_data = read_or_skip_vector<uint32_t, uint16_t>(reader, _options.models);
+        _mesh_pointers = read_or_skip_vector<uint32_t, uint32_t>(reader, _options.models);
 
-        _mesh_data = read_vector<uint32_t, uint16_t>(file);
-        _mesh_pointers = read_vector<uint32_t, uint32_t>(file);
         if (_version >= LevelVersion::Tomb4)
         {
-            auto animations = read_vector<uint32_t, tr4_animation>(file);
+            _animations = read_or_skip_vector<uint32_t, tr4_animation>(reader, _options.models);
         }
         else
         {
-            std::vector<tr_animation> animations = read_vector<uint32_t, tr_animation>(file);
+            _animations = convert_animations(read_or_skip_vector<uint32_t, tr_animation>(reader, _options.models));
         }
-        std::vector<tr_state_change> state_changes = read_vector<uint32_t, tr_state_change>(file);
-        std::vector<tr_anim_dispatch> anim_dispatches = read_vector<uint32_t, tr_anim_dispatch>(file);
-        std::vector<tr_anim_command> anim_commands = read_vector<uint32_t, tr_anim_command>(file);
-        _meshtree = read_vector<uint32_t, uint32_t>(file);
-        _frames = read_vector<uint32_t, uint16_t>(file);
+        _state_changes = read_or_skip_vector<uint32_t, tr_state_change>(reader, _options.models);
+        _anim_dispatches = read_or_skip_vector<uint32_t, tr_anim_dispatch>(reader, _options.models);
+        _anim_commands = read_or_skip_vector<uint32_t, tr_anim_command>(reader, _options.models);
+
+        _meshtree = read_or_skip_vector<uint32_t, uint32_t>(reader, _options.models);
+        _frames = read_or_skip_vector<uint32_t, uint16_t>(reader, _options.models);
 
+        _summary.num_models = reader.peek<uint32_t>();
         if (_version < LevelVersion::Tomb5)
         {
-            _models = read_vector<uint32_t, tr_model>(file);
+            _models = read_or_skip_vector<uint32_t, tr_model>(reader, _options.models);
         }
         else
         {
-            _models = convert_models(read_vector<uint32_t, tr5_model>(file));
+            _models = convert_models(read_or_skip_vector<uint32_t, tr5_model>(reader, _options.models));
         }
 
-        auto static_meshes = read_vector<uint32_t, tr_staticmesh>(file);
+        _summary.num_static_meshes = reader.peek<uint32_t>();
+        auto static_meshes = read_or_skip_vector<uint32_t, tr_staticmesh>(reader, _options.models);
         for (const auto& mesh : static_meshes)
         {
             _static_meshes.insert({ mesh.ID, mesh });
@@ -776,105 +1271,122 @@ namespace trlevel
 
         if (get_version() < LevelVersion::Tomb3)
         {
-            _object_textures = read_vector<uint32_t, tr_object_texture>(file);
+            _summary.num_object_textures = reader.peek<uint32_t>();
+            _object_textures = read_or_skip_vector<uint32_t, tr_object_texture>(reader, _options.textures);
         }
 
         if (_version >= LevelVersion::Tomb4)
         {
             // Skip past the 'SPR' marker.
-            file.seekg(3, std::ios::cur);
+            reader.skip(3);
             if (_version == LevelVersion::Tomb5)
             {
-                skip(file, 1);
+                reader.skip(1);
             }
         }
 
-        _sprite_textures = read_vector<uint32_t, tr_sprite_texture>(file);
-        _sprite_sequences = read_vector<uint32_t, tr_sprite_sequence>(file);
+        _sprite_textures = read_or_skip_vector<uint32_t, tr_sprite_texture>(reader, _options.textures);
+        _sprite_sequences = read_or_skip_vector<uint32_t, tr_sprite_sequence>(reader, _options.models);
 
         // If this is Unfinished Business, the palette is here.
         // Need to do something about that, instead of just crashing.
 
-        std::vector<tr_camera> cameras = read_vector<uint32_t, tr_camera>(file);
+        // Cameras, sound sources and AI pathfinding data are not used.
+        reader.skip_vector<uint32_t, tr_camera>();
 
         if (_version >= LevelVersion::Tomb4)
         {
-            std::vector<tr4_flyby_camera> flyby_cameras = read_vector<uint32_t, tr4_flyby_camera>(file);
+            reader.skip_vector<uint32_t, tr4_flyby_camera>();
         }
 
-        std::vector<tr_sound_source> sound_sources = read_vector<uint32_t, tr_sound_source>(file);
+        reader.skip_vector<uint32_t, tr_sound_source>();
 
         uint32_t num_boxes = 0;
         if (_version == LevelVersion::Tomb1)
         {
-            std::vector<tr_box> boxes = read_vector<uint32_t, tr_box>(file);
-            num_boxes = static_cast<uint32_t>(boxes.size());
+            num_boxes = reader.skip_vector<uint32_t, tr_box>();
         }
         else
         {
-            std::vector<tr2_box> boxes = read_vector<uint32_t, tr2_box>(file);
-            num_boxes = static_cast<uint32_t>(boxes.size());
+            num_boxes = reader.skip_vector<uint32_t, tr2_box>();
         }
-        std::vector<uint16_t> overlaps = read_vector<uint32_t, uint16_t>(file);
+        reader.skip_vector<uint32_t, uint16_t>();
 
         if (_version == LevelVersion::Tomb1)
         {
-            std::vector<int16_t> zones = read_vector<int16_t>(file, num_boxes * 6);
+            reader.skip_vector<int16_t>(num_boxes * 6);
         }
         else
         {
-            std::vector<int16_t> zones = read_vector<int16_t>(file, num_boxes * 10);
+            reader.skip_vector<int16_t>(num_boxes * 10);
         }
-        std::vector<uint16_t> animated_textures = read_vector<uint32_t, uint16_t>(file);
+
+        // Animated textures.
+        reader.skip_vector<uint32_t, uint16_t>();
 
         if (_version >= LevelVersion::Tomb4)
         {
             // Animated textures uv count - not yet used:
-            skip(file, 1);
+            reader.skip(1);
 
-            file.seekg(3, std::ios::cur);
+            reader.skip(3);
             if (_version == LevelVersion::Tomb5)
             {
-                skip(file, 1);
+                reader.skip(1);
             }
         }
 
+        if (get_version() >= LevelVersion::Tomb3)
+        {
+            _summary.num_object_textures = reader.peek<uint32_t>();
+        }
+
         if (get_version() == LevelVersion::Tomb3)
         {
-            _object_textures = read_vector<uint32_t, tr_object_texture>(file);
+            _object_textures = read_or_skip_vector<uint32_t, tr_object_texture>(reader, _options.textures);
         }
         if (get_version() == LevelVersion::Tomb4)
         {
-            _object_textures = convert_object_textures(read_vector<uint32_t, tr4_object_texture>(file));
+            _object_textures = convert_object_textures(read_or_skip_vector<uint32_t, tr4_object_texture>(reader, _options.textures));
         }
         else if (get_version() == LevelVersion::Tomb5)
         {
-            _object_textures = convert_object_textures(read_vector<uint32_t, tr5_object_texture>(file));
+            _object_textures = convert_object_textures(read_or_skip_vector<uint32_t, tr5_object_texture>(reader, _options.textures));
         }
 
+        _summary.num_entities = reader.peek<uint32_t>();
         if (_version == LevelVersion::Tomb1)
         {
-            _entities = convert_entities(read_vector<uint32_t, tr_entity>(file));
+            _entities = convert_entities(read_or_skip_vector<uint32_t, tr_entity>(reader, _options.entities));
         }
         else
         {
             // TR4 entity is in here, OCB is not set but goes into intensity2 (convert later).
-            _entities = read_vector<uint32_t, tr2_entity>(file);
+            _entities = read_or_skip_vector<uint32_t, tr2_entity>(reader, _options.entities);
         }
 
         if (_version < LevelVersion::Tomb4)
         {
-            std::vector<uint8_t> light_map = read_vector<uint8_t>(file, 32 * 256);
+            // Light map.
+            reader.skip(32 * 256);
         }
 
         if (_version == LevelVersion::Tomb1)
         {
-            _palette = read_vector<tr_colour>(file, 256);
+            if (_options.textures)
+            {
+                _palette = reader.read_vector<tr_colour>(256);
+            }
+            else
+            {
+                reader.skip_vector<tr_colour>(256);
+            }
         }
 
         if (_version >= LevelVersion::Tomb4)
         {
-            std::vector<tr4_ai_object> ai_objects = read_vector<uint32_t, tr4_ai_object>(file);
+            _summary.num_entities += reader.peek<uint32_t>();
+            std::vector<tr4_ai_object> ai_objects = read_or_skip_vector<uint32_t, tr4_ai_object>(reader, _options.entities);
             std::transform(ai_objects.begin(), ai_objects.end(), std::back_inserter(_entities),
                 [](const auto& ai_object)
                 {
@@ -893,58 +1405,119 @@ namespace trlevel
                 });
         }
 
+        // Cinematics, demo data and the sound tables are not used.
         if (_version < LevelVersion::Tomb4)
         {
-            std::vector<tr_cinematic_frame> cinematic_frames = read_vector<uint16_t, tr_cinematic_frame>(file);
+            reader.skip_vector<uint16_t, tr_cinematic_frame>();
         }
 
-        std::vector<uint8_t> demo_data = read_vector<uint16_t, uint8_t>(file);
+        const uint16_t demo_data_size = reader.skip_vector<uint16_t, uint8_t>();
 
         if (_version == LevelVersion::Tomb1)
         {
-            std::vector<int16_t> sound_map = read_vector<int16_t>(file, 256);
+            reader.skip_vector<int16_t>(256);
         }
         else if (_version < LevelVersion::Tomb4)
         {
-            std::vector<int16_t> sound_map = read_vector<int16_t>(file, 370);
+            reader.skip_vector<int16_t>(370);
         }
         else if (_version == LevelVersion::Tomb4)
         {
-            if (demo_data.size() == 2048)
+            if (demo_data_size == 2048)
             {
-                std::vector<int16_t> sound_map = read_vector<int16_t>(file, 1024);
+                reader.skip_vector<int16_t>(1024);
             }
             else
             {
-                std::vector<int16_t> sound_map = read_vector<int16_t>(file, 370);
+                reader.skip_vector<int16_t>(370);
             }
         }
         else
         {
-            std::vector<int16_t> sound_map = read_vector<int16_t>(file, 450);
+            reader.skip_vector<int16_t>(450);
         }
 
-        std::vector<tr3_sound_details> sound_details = read_vector<uint32_t, tr3_sound_details>(file);
+        reader.skip_vector<uint32_t, tr3_sound_details>();
 
         if (_version == LevelVersion::Tomb1)
         {
-            std::vector<uint8_t> sound_data = read_vector<int32_t, uint8_t>(file);
+            reader.skip_vector<int32_t, uint8_t>();
         }
 
-        std::vector<uint32_t> sample_indices = read_vector<uint32_t, uint32_t>(file);
+        reader.skip_vector<uint32_t, uint32_t>();
+
+        generate_indices();
     }
 
     bool Level::find_first_entity_by_type(int16_t type, tr2_entity& entity) const
     {
-        auto found = std::find_if(_entities.begin(), _entities.end(), [type](const auto& e) { return e.TypeID == type; });
-        if (found == _entities.end())
+        const auto entities = entities_by_type(type);
+        if (entities.empty())
         {
             return false;
         }
-        entity = *found;
+        entity = _entities[entities[0]];
         return true;
     }
 
+    Span<uint32_t> Level::entities_by_type(int16_t type) const
+    {
+        uint32_t group = 0;
+        if (!_entity_types.find(static_cast<uint16_t>(type), group))
+        {
+            return Span<uint32_t>();
+        }
+        const uint32_t start = _entity_type_starts[group];
+        return Span<uint32_t>(_entity_type_entities.data() + start, _entity_type_starts[group + 1] - start);
+    }
+
+    void Level::generate_indices()
+    {
+        _model_ids.clear();
+        for (uint32_t i = 0; i < _models.size(); ++i)
+        {
+            _model_ids.add(_models[i].ID, i);
+        }
+
+        _sprite_sequence_ids.clear();
+        for (uint32_t i = 0; i < _sprite_sequences.size(); ++i)
+        {
+            _sprite_sequence_ids.add(static_cast<uint32_t>(_sprite_sequences[i].SpriteID), i);
+        }
+
+        // Group the entities by type. The entity indices for each type are stored together in one
+        // array, with each type having a start position in that array.
+        _entity_types.clear();
+        std::vector<uint32_t> counts;
+        std::vector<uint32_t> entity_groups;
+        entity_groups.reserve(_entities.size());
+        for (const auto& entity : _entities)
+        {
+            const uint32_t type = static_cast<uint16_t>(entity.TypeID);
+            uint32_t group = static_cast<uint32_t>(counts.size());
+            if (!_entity_types.find(type, group))
+            {
+                _entity_types.add(type, group);
+                counts.push_back(0);
+            }
+            ++counts[group];
+            entity_groups.push_back(group);
+        }
+
+        _entity_type_starts.assign(counts.size() + 1, 0);
+        for (uint32_t i = 0; i < counts.size(); ++i)
+        {
+            _entity_type_starts[i + 1] = _entity_type_starts[i] + counts[i];
+        }
+
+        _entity_type_entities.resize(_entities.size());
+        std::vector<uint32_t> next(_entity_type_starts.begin(), _entity_type_starts.end() - 1);
+        for (uint32_t i = 0; i < entity_groups.size(); ++i)
+        {
+            _entity_type_entities[next[entity_groups[i]]++] = i;
+        }
+    }
+
     int16_t Level::get_mesh_from_type_id(int16_t type) const
     {
         if (type != 0 || _version < LevelVersion::Tomb3)
@@ -958,4 +1531,90 @@ namespace trlevel
         }
         return LaraSkinTR3;
     }
+
+    void Level::trim(const LoadOptions& sections)
+    {
+        if (!sections.textures)
+        {
+            release(_palette);
+            release(_palette16);
+            release(_textile8);
+            release(_textile16);
+            release(_textile32);
+            release(_object_textures);
+            release(_sprite_textures);
+            _num_textiles = 0;
+            _options.textures = false;
+        }
+
+        if (!sections.rooms)
+        {
+            release(_rooms);
+            release(_floor_data);
+            _options.rooms = false;
+        }
+
+        if (!sections.models)
+        {
+            release(_meshes);
+            release(_mesh_indices);
+            release(_mesh_pointers);
+            release(_meshtree);
+            release(_frames);
+            release(_models);
+            release(_animations);
+            release(_state_changes);
+            release(_anim_dispatches);
+            release(_anim_commands);
+            release(_sprite_sequences);
+            std::unordered_map<uint32_t, tr_staticmesh>().swap(_static_meshes);
+            _poses = PoseCache();
+            _options.models = false;
+        }
+
+        if (!sections.entities)
+        {
+            release(_entities);
+            _options.entities = false;
+        }
+
+        if (!sections.sound_samples)
+        {
+            release(_sound_samples);
+            _options.sound_samples = false;
+        }
+
+        generate_indices();
+    }
+
+    std::size_t Level::memory_usage() const
+    {
+        std::size_t total = allocated_bytes(_palette) + allocated_bytes(_palette16) +
+            allocated_bytes(_textile8) + allocated_bytes(_textile16) + allocated_bytes(_textile32) +
+            allocated_bytes(_rooms) + allocated_bytes(_object_textures) + allocated_bytes(_floor_data) +
+            allocated_bytes(_models) + allocated_bytes(_animations) + allocated_bytes(_state_changes) +
+            allocated_bytes(_anim_dispatches) + allocated_bytes(_anim_commands) + allocated_bytes(_entities) +
+            allocated_bytes(_meshes) + allocated_bytes(_mesh_indices) + allocated_bytes(_mesh_data) +
+            allocated_bytes(_mesh_pointers) + allocated_bytes(_meshtree) + allocated_bytes(_frames) +
+            allocated_bytes(_sprite_textures) + allocated_bytes(_sprite_sequences) + allocated_bytes(_sound_samples) +
+            allocated_bytes(_entity_type_starts) + allocated_bytes(_entity_type_entities) +
+            _static_meshes.size() * sizeof(std::pair<const uint32_t, tr_staticmesh>) +
+            _poses.memory_usage();
+
+        for (const auto& room : _rooms)
+        {
+            total += allocated_bytes(room);
+        }
+
+        for (const auto& mesh : _meshes)
+        {
+            total += allocated_bytes(mesh);
+        }
+
+        for (const auto& sample : _sound_samples)
+        {
+            total += allocated_bytes(sample.sound_data);
+        }
+        return total;
+    }
 }
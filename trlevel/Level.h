@@ -2,18 +2,26 @@
 
 #include <string>
 #include <array>
+#include <memory>
 #include <vector>
 #include <unordered_map>
 
 #include "ILevel.h"
+#include "LevelSummary.h"
+#include "LoadOptions.h"
+#include "PoseCache.h"
+#include "IdIndex.h"
 #include "trtypes.h"
 
 namespace trlevel
 {
+    class DataReader;
+    class DataWriter;
+
     class Level : public ILevel
     {
     public:
-        explicit Level(const std::string& filename);
+        explicit Level(const std::string& filename, const LoadOptions& options = LoadOptions(), const LoadCallbacks& callbacks = LoadCallbacks());
 
         virtual ~Level();
 
@@ -55,6 +63,11 @@ namespace trlevel
         // Returns: The colours for this index.
         virtual std::vector<uint32_t> get_textile(uint32_t index) const override;
 
+        /// Get the 8 or 16 bit textile with the specified index, converted to 32 bit colours.
+        /// @param index The index of the textile.
+        /// @param output The buffer to write the colours to. This is resized to fit the textile.
+        virtual void get_textile(uint32_t index, std::vector<uint32_t>& output) const override;
+
         // Gets the number of rooms in the level.
         // Returns: The number of rooms.
         virtual uint32_t num_rooms() const override;
@@ -63,6 +76,11 @@ namespace trlevel
         // Returns: The room.
         virtual tr3_room get_room(uint32_t index) const override;
 
+        /// Get the room at the specified index without copying it.
+        /// @param index The index of the room.
+        /// @returns The room. This is valid for as long as the level exists.
+        virtual const tr3_room& room(uint32_t index) const override;
+
         // Get the number of object textures in the level.
         // Returns: The number of object textures.
         virtual uint32_t num_object_textures() const override;
@@ -85,6 +103,10 @@ namespace trlevel
         // Returns: The floor data.
         virtual std::vector<std::uint16_t> get_floor_data_all() const override; 
 
+        /// Get all of the floor data without copying it.
+        /// @returns The floor data. This is valid for as long as the level exists.
+        virtual const std::vector<std::uint16_t>& floor_data() const override;
+
         // Get the number of entities in the level.
         // Returns: The number of entities.
         virtual uint32_t num_entities() const override;
@@ -126,18 +148,73 @@ namespace trlevel
         // Returns: The mesh.
         virtual tr_mesh get_mesh_by_pointer(uint32_t mesh_pointer) const override;
 
+        /// Get the mesh referenced by the specified mesh pointer without copying it.
+        /// @param mesh_pointer The mesh pointer index.
+        /// @returns The mesh. This is valid for as long as the level exists.
+        virtual const tr_mesh& mesh(uint32_t mesh_pointer) const override;
+
         // Get the mesh tree node at the specified index.
         // index: The mesh tree index.
         // node_count: The number of nodes to read.
         // Returns: The mesh tree node.
         virtual std::vector<tr_meshtree_node> get_meshtree(uint32_t starting_index, uint32_t node_count) const override;
 
+        /// Get a range of mesh tree nodes without copying them.
+        /// @param starting_index The starting mesh tree index.
+        /// @param node_count The number of nodes in the range.
+        /// @returns The mesh tree nodes. These are valid for as long as the level exists.
+        virtual Span<tr_meshtree_node> meshtree(uint32_t starting_index, uint32_t node_count) const override;
+
         // Get the frame at the specified index. Read the specified number of meshes.
         // frame_offset: The frame offset.
         // mesh_count: The number of meshes to read.
         // Returns: The frame.
         virtual tr2_frame get_frame(uint32_t frame_offset, uint32_t mesh_count) const override;
 
+        /// Get the frame at the specified offset into an existing frame so that the rotation
+        /// storage can be reused.
+        /// @param frame_offset The frame offset.
+        /// @param mesh_count The number of meshes to read.
+        /// @param frame The frame to populate.
+        virtual void get_frame(uint32_t frame_offset, uint32_t mesh_count, tr2_frame& frame) const override;
+
+        /// Get the animations in the level. Tomb Raider I-III animations are converted to the Tomb Raider IV
+        /// layout with no lateral movement.
+        /// @returns The animations. These are valid for as long as the level exists.
+        virtual Span<tr4_animation> animations() const override;
+
+        /// Get the animation state changes in the level.
+        /// @returns The state changes. These are valid for as long as the level exists.
+        virtual Span<tr_state_change> state_changes() const override;
+
+        /// Get the animation dispatches in the level.
+        /// @returns The dispatches. These are valid for as long as the level exists.
+        virtual Span<tr_anim_dispatch> anim_dispatches() const override;
+
+        /// Get the animation commands in the level.
+        /// @returns The commands. These are valid for as long as the level exists.
+        virtual Span<tr_anim_command> anim_commands() const override;
+
+        /// Get the number of frames that can be used to pose a model. This is the frame that the model
+        /// points to followed by the frames of its animations.
+        /// @param model_index The index of the model.
+        /// @returns The number of frames.
+        virtual uint32_t num_model_frames(uint32_t model_index) const override;
+
+        /// Calculate the world transform of every mesh of a number of posed models at once.
+        /// @param instances The models to pose.
+        /// @param transforms Receives the transforms of each instance in turn, one per mesh of the model.
+        virtual void get_world_transforms(Span<PoseInstance> instances, std::vector<DirectX::SimpleMath::Matrix>& transforms) const override;
+
+        /// Get the number of sound samples that were loaded.
+        /// @returns The number of sound samples.
+        virtual uint32_t num_sound_samples() const override;
+
+        /// Get the sound sample at the specified index.
+        /// @param index The index of the sample.
+        /// @returns The uncompressed sample data.
+        virtual std::vector<uint8_t> get_sound_sample(uint32_t index) const override;
+
         // Get the version of the game that the level was built for.
         // Returns: The level version.
         virtual LevelVersion get_version() const override;
@@ -159,24 +236,58 @@ namespace trlevel
         /// @returns Whether the entity was found.
         virtual bool find_first_entity_by_type(int16_t type, tr2_entity& entity) const override;
 
+        /// Get the indices of all of the entities with the specified type.
+        /// @param type The type ID of the entities.
+        /// @returns The entity indices in ascending order. These are valid for as long as the level exists.
+        virtual Span<uint32_t> entities_by_type(int16_t type) const override;
+
         /// Get the true mesh from a type id. For example Lara's skin.
         /// @param type The type id to check.
         /// @returns The mesh index for the type.
         virtual int16_t get_mesh_from_type_id(int16_t type) const override;
+
+        /// Release the loaded sections of the level that are no longer needed, for example once they have been
+        /// uploaded to the GPU. The released sections are empty afterwards, as if they had not been loaded.
+        /// @param sections The sections to keep. Sections that are not set are released.
+        virtual void trim(const LoadOptions& sections) override;
+
+        /// Get the approximate amount of memory used by the loaded sections of the level.
+        /// @returns The number of bytes.
+        virtual std::size_t memory_usage() const override;
+
+        /// Get the counts of the sections in the level. These are recorded even for sections that were not loaded.
+        /// @returns The level summary.
+        const LevelSummary& summary() const;
+
+        /// Write the loaded sections of the level in the layout used by the level cache.
+        /// @param writer The writer to write to.
+        void save_cache(DataWriter& writer) const;
+
+        /// Load a level that was written with save_cache.
+        /// @param reader The reader positioned at the start of the saved level.
+        /// @returns The loaded level.
+        static std::unique_ptr<Level> load_cache(DataReader& reader);
     private:
+        Level() = default;
+
         void generate_meshes(const std::vector<uint16_t>& mesh_data);
 
         // Load a Tomb Raider IV level.
-        void load_tr4(std::ifstream& file);
+        void load_tr4(DataReader& reader, const LoadCallbacks& callbacks);
+
+        void load_level_data(DataReader& reader, const LoadCallbacks& callbacks);
 
-        void load_level_data(std::istream& file);
+        /// Build the lookups from model IDs, sprite IDs and entity types.
+        void generate_indices();
 
         LevelVersion _version;
+        LoadOptions _options;
+        LevelSummary _summary;
 
         std::vector<tr_colour>  _palette;
         std::vector<tr_colour4> _palette16;
 
-        uint32_t                  _num_textiles;
+        uint32_t                  _num_textiles{ 0u };
         std::vector<tr_textile8>  _textile8;
         std::vector<tr_textile16> _textile16;
         std::vector<tr_textile32> _textile32;
@@ -185,6 +296,10 @@ namespace trlevel
         std::vector<tr_object_texture> _object_textures;
         std::vector<uint16_t>          _floor_data;
         std::vector<tr_model>          _models;
+        std::vector<tr4_animation>     _animations;
+        std::vector<tr_state_change>   _state_changes;
+        std::vector<tr_anim_dispatch>  _anim_dispatches;
+        std::vector<tr_anim_command>   _anim_commands;
         std::vector<tr2_entity>        _entities;
         std::unordered_map<uint32_t, tr_staticmesh> _static_meshes;
 
@@ -192,12 +307,24 @@ namespace trlevel
         uint16_t _weather_type{ 0u };
 
         // Mesh management.
-        std::unordered_map<uint32_t, tr_mesh> _meshes;
+        // The distinct meshes and, for each mesh pointer, the index of the mesh that it points to.
+        std::vector<tr_mesh>                  _meshes;
+        std::vector<uint32_t>                 _mesh_indices;
         std::vector<uint16_t>                 _mesh_data;
         std::vector<uint32_t>                 _mesh_pointers;
         std::vector<uint32_t>                 _meshtree;
         std::vector<uint16_t>                 _frames;
+        PoseCache                             _poses;
         std::vector<tr_sprite_texture>        _sprite_textures;
         std::vector<tr_sprite_sequence>       _sprite_sequences;
+
+        std::vector<tr4_sample> _sound_samples;
+
+        // Lookups built once the level has loaded.
+        IdIndex _model_ids;
+        IdIndex _sprite_sequence_ids;
+        IdIndex _entity_types;
+        std::vector<uint32_t> _entity_type_starts;
+        std::vector<uint32_t> _entity_type_entities;
     };
 }
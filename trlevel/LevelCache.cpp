@@ -0,0 +1,391 @@
+#include "LevelCache.h"
+#include "Level.h"
+#include "LevelLoadException.h"
+#include "DataReader.h"
+#include "DataWriter.h"
+
+#include <filesystem>
+#include <iomanip>
+
+#include <trview.common/MappedFile.h>
+
+namespace trlevel
+{
+    namespace
+    {
+        const uint32_t CacheMagic = 0x43565254; // TRVC
+        // Increase this whenever the layout written by Level::save_cache changes.
+        const uint32_t CacheFormat = 5;
+
+        uint64_t rotate_left(uint64_t value, int bits)
+        {
+            return (value << bits) | (value >> (64 - bits));
+        }
+
+        uint64_t mix(uint64_t hash, uint64_t value)
+        {
+            hash ^= value * 0x87c37b91114253d5ull;
+            return rotate_left(hash, 31) * 0x9e3779b97f4a7c15ull;
+        }
+
+        uint64_t finalise(uint64_t hash)
+        {
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccdull;
+            hash ^= hash >> 33;
+            hash *= 0xc4ceb9fe1a85ec53ull;
+            hash ^= hash >> 33;
+            return hash;
+        }
+
+        /// Hash a block of data. This is only used to tell level files apart, so it is built for speed -
+        /// four independent lanes of 64 bit words so that the multiplies can overlap.
+        uint64_t hash_data(const uint8_t* data, std::size_t size)
+        {
+            uint64_t lanes[4] = { size, 0x9e3779b97f4a7c15ull, 0xc2b2ae3d27d4eb4full, 0x165667b19e3779f9ull };
+
+            std::size_t position = 0;
+            for (; position + 32 <= size; position += 32)
+            {
+                for (int lane = 0; lane < 4; ++lane)
+                {
+                    uint64_t word;
+                    std::memcpy(&word, data + position + lane * 8, sizeof(word));
+                    lanes[lane] = mix(lanes[lane], word);
+                }
+            }
+
+            for (; position < size; position += 8)
+            {
+                uint64_t word = 0;
+                std::memcpy(&word, data + position, std::min<std::size_t>(8, size - position));
+                lanes[0] = mix(lanes[0], word);
+            }
+
+            uint64_t hash = lanes[0];
+            for (int lane = 1; lane < 4; ++lane)
+            {
+                hash = mix(hash, lanes[lane]);
+            }
+            return finalise(hash);
+        }
+
+        uint64_t hash_string(const std::string& value)
+        {
+            return hash_data(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+        }
+
+        uint32_t option_flags(const LoadOptions& options)
+        {
+            return (options.textures ? 0x1 : 0) |
+                (options.rooms ? 0x2 : 0) |
+                (options.models ? 0x4 : 0) |
+                (options.entities ? 0x8 : 0) |
+                (options.sound_samples ? 0x10 : 0);
+        }
+
+        /// The extension is part of the key as Tomb Raider V levels are identified by their extension.
+        std::string upper_extension(const std::string& filename)
+        {
+            std::string extension = std::filesystem::u8path(filename).extension().u8string();
+            std::transform(extension.begin(), extension.end(), extension.begin(),
+                [](unsigned char c) { return static_cast<char>(::toupper(c)); });
+            return extension;
+        }
+
+        std::string entry_name(uint64_t key)
+        {
+            std::stringstream stream;
+            stream << std::hex << std::setw(16) << std::setfill('0') << key << ".trcache";
+            return stream.str();
+        }
+
+        void write_header(DataWriter& writer, uint64_t key, uint64_t source_size, const std::string& build,
+            const std::vector<uint8_t>& payload, const std::vector<uint8_t>& geometry)
+        {
+            writer.write(CacheMagic);
+            writer.write(CacheFormat);
+            writer.write(key);
+            writer.write(source_size);
+            writer.write(static_cast<uint32_t>(build.size()));
+            writer.write_vector(std::vector<char>(build.begin(), build.end()));
+            writer.write(static_cast<uint64_t>(payload.size()));
+            writer.write(hash_data(payload.data(), payload.size()));
+            writer.write(static_cast<uint64_t>(geometry.size()));
+            writer.write(hash_data(geometry.data(), geometry.size()));
+        }
+
+        /// Check the header of an entry and that the level and the geometry that follow it match the checksums in the header.
+        /// @param payload_size Set to the size of the level, which starts at the reader position.
+        /// @param geometry_size Set to the size of the geometry, which follows the level.
+        bool read_header(DataReader& reader, uint64_t key, uint64_t source_size, const std::string& build, uint64_t& payload_size, uint64_t& geometry_size)
+        {
+            if (reader.read<uint32_t>() != CacheMagic ||
+                reader.read<uint32_t>() != CacheFormat ||
+                reader.read<uint64_t>() != key ||
+                reader.read<uint64_t>() != source_size)
+            {
+                return false;
+            }
+            const auto entry_build = reader.read_vector<uint32_t, char>();
+            if (std::string(entry_build.begin(), entry_build.end()) != build)
+            {
+                return false;
+            }
+
+            payload_size = reader.read<uint64_t>();
+            const auto payload_hash = reader.read<uint64_t>();
+            geometry_size = reader.read<uint64_t>();
+            const auto geometry_hash = reader.read<uint64_t>();
+            const uint64_t remaining = reader.size() - reader.position();
+            return payload_size <= remaining && geometry_size == remaining - payload_size &&
+                payload_hash == hash_data(reader.current(), static_cast<std::size_t>(payload_size)) &&
+                geometry_hash == hash_data(reader.current() + payload_size, static_cast<std::size_t>(geometry_size));
+        }
+    }
+
+    LevelCache::LevelCache(const std::string& directory, const std::string& build, uint64_t max_size)
+        : _directory(directory), _build(build), _max_size(max_size), _writes(trview::ThreadPool::shared())
+    {
+    }
+
+    LevelCache::~LevelCache()
+    {
+        try
+        {
+            _writes.wait();
+        }
+        catch (const std::exception&)
+        {
+        }
+    }
+
+    LevelCache::Entry LevelCache::find_entry(const std::string& filename, const LoadOptions& options) const
+    {
+        uint64_t key = 0;
+        uint64_t source_size = 0;
+        try
+        {
+            trview::MappedFile source(filename);
+            source_size = source.size();
+            key = hash_data(source.data(), source.size());
+        }
+        catch (const std::exception&)
+        {
+            throw LevelLoadException();
+        }
+        key = finalise(mix(mix(key, hash_string(upper_extension(filename))), option_flags(options)));
+        return { (std::filesystem::u8path(_directory) / entry_name(key)).u8string(), key, source_size };
+    }
+
+    std::unique_ptr<Level> LevelCache::read_entry(const Entry& entry, std::vector<uint8_t>* geometry) const
+    {
+        std::unique_ptr<Level> cached;
+        try
+        {
+            trview::MappedFile file(entry.path);
+            DataReader reader(file.data(), file.size());
+            uint64_t payload_size = 0;
+            uint64_t geometry_size = 0;
+            if (read_header(reader, entry.key, entry.source_size, _build, payload_size, geometry_size))
+            {
+                DataReader payload(reader.current(), static_cast<std::size_t>(payload_size));
+                cached = Level::load_cache(payload);
+                if (geometry)
+                {
+                    const uint8_t* const start = reader.current() + payload_size;
+                    geometry->assign(start, start + geometry_size);
+                }
+            }
+        }
+        catch (const std::exception&)
+        {
+            // Missing or damaged entries are replaced when the level is loaded.
+            return nullptr;
+        }
+
+        if (cached)
+        {
+            // Mark the entry as recently used so that it is evicted last.
+            std::error_code error;
+            std::filesystem::last_write_time(std::filesystem::u8path(entry.path), std::filesystem::file_time_type::clock::now(), error);
+        }
+        return cached;
+    }
+
+    void LevelCache::write_entry(const Entry& entry, const std::vector<uint8_t>& payload, const std::vector<uint8_t>& geometry) const
+    {
+        DataWriter writer;
+        write_header(writer, entry.key, entry.source_size, _build, payload, geometry);
+
+        // Write to a temporary file first so that a partly written entry is never picked up.
+        const auto entry_path = std::filesystem::u8path(entry.path);
+        std::error_code error;
+        std::filesystem::create_directories(entry_path.parent_path(), error);
+        auto temporary_path = entry_path;
+        temporary_path += ".tmp";
+        {
+            std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(writer.data().data()), writer.data().size());
+            file.write(reinterpret_cast<const char*>(payload.data()), payload.size());
+            file.write(reinterpret_cast<const char*>(geometry.data()), geometry.size());
+            if (!file)
+            {
+                file.close();
+                std::filesystem::remove(temporary_path, error);
+                return;
+            }
+        }
+        std::filesystem::rename(temporary_path, entry_path, error);
+        if (error)
+        {
+            std::filesystem::remove(temporary_path, error);
+        }
+    }
+
+    void LevelCache::write_geometry(const Entry& entry, const std::vector<uint8_t>& geometry) const
+    {
+        // The level is copied out of the existing entry so that the file is closed before it is replaced.
+        std::vector<uint8_t> payload;
+        try
+        {
+            trview::MappedFile file(entry.path);
+            DataReader reader(file.data(), file.size());
+            uint64_t payload_size = 0;
+            uint64_t geometry_size = 0;
+            if (!read_header(reader, entry.key, entry.source_size, _build, payload_size, geometry_size))
+            {
+                return;
+            }
+            payload.assign(reader.current(), reader.current() + payload_size);
+        }
+        catch (const std::exception&)
+        {
+            return;
+        }
+        write_entry(entry, payload, geometry);
+    }
+
+    void LevelCache::evict() const
+    {
+        struct File
+        {
+            std::filesystem::path path;
+            std::filesystem::file_time_type last_used;
+            uint64_t size;
+        };
+
+        std::error_code error;
+        std::vector<File> files;
+        for (const auto& item : std::filesystem::directory_iterator(std::filesystem::u8path(_directory), error))
+        {
+            if (item.path().extension() == ".trcache")
+            {
+                std::error_code item_error;
+                const auto last_used = item.last_write_time(item_error);
+                const auto size = item.file_size(item_error);
+                if (!item_error)
+                {
+                    files.push_back({ item.path(), last_used, size });
+                }
+            }
+        }
+
+        // Keep the most recently used entries that fit in the maximum size.
+        std::sort(files.begin(), files.end(), [](const auto& l, const auto& r) { return l.last_used > r.last_used; });
+        uint64_t total = 0;
+        for (const auto& file : files)
+        {
+            total += file.size;
+            if (total > _max_size)
+            {
+                std::filesystem::remove(file.path, error);
+            }
+        }
+    }
+
+    bool LevelCache::contains(const std::string& filename, const LoadOptions& options)
+    {
+        wait();
+        return read_entry(find_entry(filename, options), nullptr) != nullptr;
+    }
+
+    void LevelCache::wait()
+    {
+        try
+        {
+            _writes.wait();
+        }
+        catch (const std::exception&)
+        {
+        }
+    }
+
+    std::unique_ptr<ILevel> LevelCache::load(const std::string& filename, const LoadOptions& options)
+    {
+        Entry entry;
+        return load_entry(filename, options, entry, nullptr, LoadCallbacks());
+    }
+
+    std::unique_ptr<ILevel> LevelCache::load(const std::string& filename, const LoadOptions& options, Entry& entry, std::vector<uint8_t>& geometry, const LoadCallbacks& callbacks)
+    {
+        geometry.clear();
+        return load_entry(filename, options, entry, &geometry, callbacks);
+    }
+
+    std::unique_ptr<ILevel> LevelCache::load_entry(const std::string& filename, const LoadOptions& options, Entry& entry, std::vector<uint8_t>* geometry, const LoadCallbacks& callbacks)
+    {
+        entry = find_entry(filename, options);
+        auto cached = read_entry(entry, geometry);
+        if (cached)
+        {
+            if (options.rooms && callbacks.room_loaded)
+            {
+                for (uint32_t i = 0; i < cached->num_rooms(); ++i)
+                {
+                    callbacks.room_loaded(i, cached->room(i));
+                }
+            }
+            if (options.rooms && callbacks.rooms_loaded)
+            {
+                callbacks.rooms_loaded(*cached);
+            }
+            return cached;
+        }
+
+        auto level = std::make_unique<Level>(filename, options, callbacks);
+
+        // The level is copied out here as the caller is free to change it once it has been returned. Hashing
+        // the copy, writing it to disk and evicting old entries happens on the thread pool.
+        auto payload = std::make_shared<DataWriter>();
+        try
+        {
+            level->save_cache(*payload);
+        }
+        catch (const std::exception&)
+        {
+            return level;
+        }
+
+        _writes.run([this, entry, payload]() mutable
+        {
+            write_entry(entry, payload->data(), {});
+            payload.reset();
+            evict();
+        });
+
+        return level;
+    }
+
+    void LevelCache::store_geometry(const Entry& entry, std::vector<uint8_t> geometry)
+    {
+        wait();
+        auto data = std::make_shared<std::vector<uint8_t>>(std::move(geometry));
+        _writes.run([this, entry, data]() mutable
+        {
+            write_geometry(entry, *data);
+            data.reset();
+            evict();
+        });
+    }
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <trview.common/ThreadPool.h>
+
+#include "ILevel.h"
+#include "LoadOptions.h"
+
+namespace trlevel
+{
+    class Level;
+
+    /// Stores parsed levels on disk so that opening the same level again skips decompression, parsing
+    /// and mesh generation. The application can also store the geometry that it builds from the level in the
+    /// same entry. Entries are keyed by a hash of the level file contents and the load options.
+    /// Entries written by a different build, or that fail their checksum, are ignored and replaced. Once the
+    /// entries take up more than the maximum size the least recently used entries are removed.
+    class LevelCache final
+    {
+    public:
+        /// The default maximum size of the cache directory in bytes.
+        static const uint64_t DefaultMaxSize = 1024ull * 1024ull * 1024ull;
+
+        /// Create a level cache.
+        /// @param directory The directory to store the cached levels in. This is created when the first entry is written.
+        /// @param build Identifies the build of the application that is using the cache.
+        /// @param max_size The maximum total size of the entries in bytes.
+        LevelCache(const std::string& directory, const std::string& build, uint64_t max_size = DefaultMaxSize);
+
+        /// Waits for any entries that are still being written.
+        ~LevelCache();
+
+        /// Load a level, using the cached copy if there is a usable one. Otherwise the level is loaded
+        /// from the file and the entry is written on the shared thread pool. Problems reading or writing the
+        /// cache are not errors - the level is loaded from the file instead.
+        /// @param filename The level file to load.
+        /// @param options The sections of the level to load.
+        /// @returns The loaded level. Throws LevelLoadException if the level could not be loaded.
+        std::unique_ptr<ILevel> load(const std::string& filename, const LoadOptions& options = LoadOptions());
+
+        /// Identifies the entry for a level, so that data derived from the level can be stored with it later.
+        struct Entry
+        {
+            std::string path;
+            uint64_t key;
+            uint64_t source_size;
+        };
+
+        /// Load a level along with any geometry that was stored with its entry by store_geometry.
+        /// @param filename The level file to load.
+        /// @param options The sections of the level to load.
+        /// @param entry Set to the entry for the level, to pass to store_geometry.
+        /// @param geometry Set to the stored geometry. This is empty if the entry has no geometry or was not usable.
+        /// @param callbacks Optional functions to call as the rooms are read. When the level is loaded from the cache
+        /// these are called once the entry has been read.
+        /// @returns The loaded level. Throws LevelLoadException if the level could not be loaded.
+        std::unique_ptr<ILevel> load(const std::string& filename, const LoadOptions& options, Entry& entry, std::vector<uint8_t>& geometry, const LoadCallbacks& callbacks = LoadCallbacks());
+
+        /// Store geometry built from a level in the entry for the level, replacing any geometry already there. The
+        /// cache doesn't look inside the geometry. This waits for any entries that are being written, as the level
+        /// has to be written first, and then writes the entry on the shared thread pool. Nothing is stored if the
+        /// entry is missing or damaged.
+        /// @param entry The entry from load.
+        /// @param geometry The geometry to store.
+        void store_geometry(const Entry& entry, std::vector<uint8_t> geometry);
+
+        /// Determine whether there is a usable entry for a level. This waits for any entries that are being written.
+        /// @param filename The level file.
+        /// @param options The sections of the level.
+        /// @returns True if loading the level would use the cached copy.
+        bool contains(const std::string& filename, const LoadOptions& options = LoadOptions());
+
+        /// Wait for any entries that are being written to finish.
+        void wait();
+    private:
+        std::unique_ptr<ILevel> load_entry(const std::string& filename, const LoadOptions& options, Entry& entry, std::vector<uint8_t>* geometry, const LoadCallbacks& callbacks);
+        Entry find_entry(const std::string& filename, const LoadOptions& options) const;
+        std::unique_ptr<Level> read_entry(const Entry& entry, std::vector<uint8_t>* geometry) const;
+        void write_entry(const Entry& entry, const std::vector<uint8_t>& payload, const std::vector<uint8_t>& geometry) const;
+        void write_geometry(const Entry& entry, const std::vector<uint8_t>& geometry) const;
+        void evict() const;
+
+        std::string _directory;
+        std::string _build;
+        uint64_t _max_size;
+        trview::TaskGroup _writes;
+    };
+}
@@ -0,0 +1,76 @@
+#include "LevelStream.h"
+
+namespace trlevel
+{
+    LevelStream::LevelStream(const Loader& loader)
+        : _load(trview::ThreadPool::shared())
+    {
+        LoadCallbacks callbacks;
+        callbacks.room_loaded = [this](uint32_t index, const tr3_room&)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _rooms.push_back(index);
+        };
+        callbacks.rooms_loaded = [this](const ILevel& level)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _loading_level = &level;
+        };
+        callbacks.load_failed = [this]()
+        {
+            // Taking the lock waits for take_rooms to finish with the level before the loader releases it.
+            std::lock_guard<std::mutex> lock(_mutex);
+            _loading_level = nullptr;
+        };
+
+        _load.run([this, loader, callbacks]()
+        {
+            try
+            {
+                auto level = loader(callbacks);
+                std::lock_guard<std::mutex> lock(_mutex);
+                _level = std::move(level);
+                _finished = true;
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _loading_level = nullptr;
+                _finished = true;
+                throw;
+            }
+        });
+    }
+
+    LevelStream::~LevelStream()
+    {
+    }
+
+    bool LevelStream::take_rooms(const RoomsFunction& function)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_loading_level)
+        {
+            return false;
+        }
+
+        std::vector<uint32_t> rooms;
+        rooms.swap(_rooms);
+        function(*_loading_level, rooms);
+        return true;
+    }
+
+    bool LevelStream::finished() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _finished;
+    }
+
+    std::unique_ptr<ILevel> LevelStream::level()
+    {
+        _load.wait();
+        std::lock_guard<std::mutex> lock(_mutex);
+        _loading_level = nullptr;
+        return std::move(_level);
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <trview.common/ThreadPool.h>
+
+#include "ILevel.h"
+
+namespace trlevel
+{
+    /// Loads a level on the shared thread pool and queues each room as it is parsed, so that the rooms can be used
+    /// while the rest of the level is still loading.
+    class LevelStream final
+    {
+    public:
+        /// Loads the level, calling the callbacks as the rooms are read - for example load_level or LevelCache::load.
+        using Loader = std::function<std::unique_ptr<ILevel> (const LoadCallbacks& callbacks)>;
+
+        /// Called with the level that is loading and the indices of the rooms that have been parsed.
+        using RoomsFunction = std::function<void (const ILevel& level, const std::vector<uint32_t>& rooms)>;
+
+        /// Start loading a level.
+        /// @param loader The function that loads the level.
+        explicit LevelStream(const Loader& loader);
+
+        LevelStream(const LevelStream&) = delete;
+        LevelStream& operator=(const LevelStream&) = delete;
+
+        /// Waits for the level to finish loading.
+        ~LevelStream();
+
+        /// Take the rooms that have been parsed since the rooms were last taken. The rooms stay in the queue until
+        /// the floordata has been read, as nothing can be built from them before that. Loading can't fail and
+        /// release the rooms while the function is running.
+        /// @param function The function to call with the level and the rooms. The level must not be kept.
+        /// @returns True if the function was called.
+        bool take_rooms(const RoomsFunction& function);
+
+        /// Gets whether the level has finished loading or has failed to load.
+        /// @returns True if level can be called without waiting.
+        bool finished() const;
+
+        /// Get the loaded level, waiting for it to finish loading. This can only be called once.
+        /// @returns The level. Throws whatever the loader threw if the level could not be loaded.
+        std::unique_ptr<ILevel> level();
+    private:
+        mutable std::mutex _mutex;
+        std::vector<uint32_t> _rooms;
+        const ILevel* _loading_level{ nullptr };
+        std::unique_ptr<ILevel> _level;
+        bool _finished{ false };
+        // Declared last so that the load is waited for before anything it writes to is destroyed.
+        trview::TaskGroup _load;
+    };
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include "LevelVersion.h"
+
+namespace trlevel
+{
+    /// Counts of the main sections of a level, read without loading the sections themselves.
+    struct LevelSummary
+    {
+        LevelVersion version{ LevelVersion::Unknown };
+        uint32_t num_textiles{ 0u };
+        uint32_t num_rooms{ 0u };
+        /// The number of entities, including AI objects.
+        uint32_t num_entities{ 0u };
+        uint32_t num_models{ 0u };
+        uint32_t num_static_meshes{ 0u };
+        uint32_t num_object_textures{ 0u };
+        uint32_t num_sound_samples{ 0u };
+    };
+}
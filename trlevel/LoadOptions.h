@@ -0,0 +1,34 @@
+#pragma once
+
+namespace trlevel
+{
+    /// Controls which sections of a level file are loaded. Sections that are not loaded are skipped over
+    /// without being read into memory and will be empty in the loaded level.
+    struct LoadOptions
+    {
+        /// Palettes, textiles, object textures and sprite textures.
+        bool textures{ true };
+        /// Room geometry, sectors, portals and floordata.
+        bool rooms{ true };
+        /// Meshes, static meshes, models, mesh trees, animation frames and sprite sequences.
+        bool models{ true };
+        /// Entities and AI objects.
+        bool entities{ true };
+        /// Compressed sound samples. These are only stored in Tomb Raider IV and V levels.
+        bool sound_samples{ true };
+
+        /// Options that load every section of the level.
+        /// @returns The load options.
+        static LoadOptions all()
+        {
+            return LoadOptions();
+        }
+
+        /// Options that load no sections. Only the level version will be loaded.
+        /// @returns The load options.
+        static LoadOptions none()
+        {
+            return LoadOptions{ false, false, false, false, false };
+        }
+    };
+}
@@ -0,0 +1,307 @@
+#include "PoseCache.h"
+
+namespace trlevel
+{
+    namespace
+    {
+        const float PiMul2 = 6.283185307179586476925286766559f;
+        const uint16_t NoAnimation = 0xffff;
+    }
+
+    bool decode_frame(LevelVersion version, const std::vector<uint16_t>& frames, uint32_t frame_offset, uint32_t mesh_count, tr2_frame& frame, uint32_t* end_offset)
+    {
+        const std::size_t size = frames.size();
+        std::size_t offset = frame_offset;
+        const std::size_t header_size = version == LevelVersion::Tomb1 ? 10 : 9;
+        if (offset + header_size > size)
+        {
+            return false;
+        }
+
+        frame.bb1x = frames[offset++];
+        frame.bb1y = frames[offset++];
+        frame.bb1z = frames[offset++];
+        frame.bb2x = frames[offset++];
+        frame.bb2y = frames[offset++];
+        frame.bb2z = frames[offset++];
+        frame.offsetx = frames[offset++];
+        frame.offsety = frames[offset++];
+        frame.offsetz = frames[offset++];
+
+        // Tomb Raider I has the mesh count in the frame structure - all other tombs
+        // already know based on the number of meshes.
+        if (version == LevelVersion::Tomb1)
+        {
+            mesh_count = frames[offset++];
+        }
+
+        frame.values.clear();
+        for (uint32_t i = 0; i < mesh_count; ++i)
+        {
+            tr2_frame_rotation rotation;
+
+            uint16_t next = 0;
+            uint16_t data = 0;
+            uint16_t mode = 0;
+
+            // Tomb Raider I has reversed words and always uses the two word format.
+            if (version == LevelVersion::Tomb1)
+            {
+                if (offset + 2 > size)
+                {
+                    return false;
+                }
+                next = frames[offset++];
+                data = frames[offset++];
+            }
+            else
+            {
+                if (offset >= size)
+                {
+                    return false;
+                }
+                data = frames[offset++];
+                mode = data & 0xC000;
+                if (!mode)
+                {
+                    if (offset >= size)
+                    {
+                        return false;
+                    }
+                    next = frames[offset++];
+                }
+            }
+
+            if (mode)
+            {
+                float angle = 0;
+                if (version >= LevelVersion::Tomb4)
+                {
+                    angle = (data & 0x0fff) * PiMul2 / 4096.0f;
+                }
+                else
+                {
+                    angle = (data & 0x03ff) * PiMul2 / 1024.0f;
+                }
+
+                if (mode == 0x4000)
+                {
+                    rotation.x = angle;
+                }
+                else if (mode == 0x8000)
+                {
+                    rotation.y = angle;
+                }
+                else if (mode == 0xC000)
+                {
+                    rotation.z = angle;
+                }
+            }
+            else
+            {
+                rotation.x = ((data & 0x3ff0) >> 4) * PiMul2 / 1024.0f;
+                rotation.y = ((((data & 0x000f) << 6)) | ((next & 0xfc00) >> 10)) * PiMul2 / 1024.0f;
+                rotation.z = (next & 0x03ff) * PiMul2 / 1024.0f;
+            }
+            frame.values.push_back(rotation);
+        }
+
+        if (end_offset)
+        {
+            *end_offset = static_cast<uint32_t>(offset);
+        }
+        return true;
+    }
+
+    PoseCache::PoseCache(LevelVersion version, const std::vector<uint16_t>& frames, const std::vector<tr_model>& models, const std::vector<tr4_animation>& animations)
+        : _version(version), _frames(&frames), _models(&models), _animations(&animations)
+    {
+        // A model owns the animations from its first animation up to the first animation of the next model.
+        std::vector<uint32_t> animation_starts;
+        for (const auto& model : models)
+        {
+            if (model.Animation != NoAnimation)
+            {
+                animation_starts.push_back(model.Animation);
+            }
+        }
+        animation_starts.push_back(static_cast<uint32_t>(animations.size()));
+        std::sort(animation_starts.begin(), animation_starts.end());
+
+        _animation_ends.reserve(models.size());
+        _poses.reserve(models.size());
+        for (const auto& model : models)
+        {
+            _animation_ends.push_back(model.Animation != NoAnimation && model.Animation < animations.size() ?
+                *std::upper_bound(animation_starts.begin(), animation_starts.end(), static_cast<uint32_t>(model.Animation)) : 0u);
+            _poses.push_back(std::make_unique<ModelPoses>());
+        }
+    }
+
+    const PoseCache::ModelPoses& PoseCache::poses(uint32_t model) const
+    {
+        auto& entry = *_poses[model];
+        std::call_once(entry.decode, [&]()
+        {
+            decode(model, entry);
+            entry.decoded = true;
+        });
+        return entry;
+    }
+
+    void PoseCache::decode(uint32_t model_index, ModelPoses& poses) const
+    {
+        const auto& model = (*_models)[model_index];
+        tr2_frame scratch;
+        uint32_t end_offset = 0;
+
+        // The frame is always decoded as the end of the frame is needed to find the next frame when the
+        // animation doesn't have a frame size.
+        auto add_pose = [&](uint32_t frame_offset)
+        {
+            if (!decode_frame(_version, *_frames, frame_offset, model.NumMeshes, scratch, &end_offset))
+            {
+                return false;
+            }
+
+            const uint64_t key = (static_cast<uint64_t>(frame_offset) << 32) | scratch.values.size();
+            const auto found = poses.offsets.find(key);
+            if (found != poses.offsets.end())
+            {
+                poses.frame_poses.push_back(found->second);
+                return true;
+            }
+
+            const uint32_t pose = static_cast<uint32_t>(poses.headers.size());
+            poses.headers.push_back({ scratch.bb1x, scratch.bb1y, scratch.bb1z, scratch.bb2x, scratch.bb2y, scratch.bb2z, scratch.offsetx, scratch.offsety, scratch.offsetz });
+            poses.first_rotation.push_back(static_cast<uint32_t>(poses.angles.size()));
+            poses.rotation_count.push_back(static_cast<uint32_t>(scratch.values.size()));
+            for (const auto& rotation : scratch.values)
+            {
+                poses.angles.push_back(rotation);
+                // Rotations are performed in Y, X, Z order.
+                poses.rotations.push_back(DirectX::SimpleMath::Quaternion::CreateFromYawPitchRoll(rotation.y, rotation.x, rotation.z));
+            }
+            poses.offsets.insert({ key, pose });
+            poses.frame_poses.push_back(pose);
+            return true;
+        };
+
+        if (!add_pose(model.FrameOffset / 2))
+        {
+            return;
+        }
+
+        for (uint32_t a = model.Animation; a < _animation_ends[model_index]; ++a)
+        {
+            const auto& animation = (*_animations)[a];
+            if (animation.FrameEnd < animation.FrameStart)
+            {
+                continue;
+            }
+
+            // Only every FrameRate'th frame is stored, the rest are interpolated by the game.
+            const uint32_t frame_count = (animation.FrameEnd - animation.FrameStart) / std::max<uint32_t>(animation.FrameRate, 1) + 1;
+            uint32_t offset = animation.FrameOffset / 2;
+            for (uint32_t f = 0; f < frame_count; ++f)
+            {
+                if (!add_pose(offset))
+                {
+                    break;
+                }
+                offset = animation.FrameSize ? offset + animation.FrameSize : end_offset;
+            }
+        }
+    }
+
+    uint32_t PoseCache::num_model_frames(uint32_t model) const
+    {
+        return model < _poses.size() ? static_cast<uint32_t>(poses(model).frame_poses.size()) : 0u;
+    }
+
+    void PoseCache::get_frame(uint32_t model, uint32_t frame, tr2_frame& output) const
+    {
+        const auto& model_poses = poses(model);
+        const uint32_t pose = model_poses.frame_poses[frame];
+        const auto& header = model_poses.headers[pose];
+        output.bb1x = header.bb1x;
+        output.bb1y = header.bb1y;
+        output.bb1z = header.bb1z;
+        output.bb2x = header.bb2x;
+        output.bb2y = header.bb2y;
+        output.bb2z = header.bb2z;
+        output.offsetx = header.offsetx;
+        output.offsety = header.offsety;
+        output.offsetz = header.offsetz;
+
+        const uint32_t first = model_poses.first_rotation[pose];
+        const uint32_t count = model_poses.rotation_count[pose];
+        output.values.assign(model_poses.angles.begin() + first, model_poses.angles.begin() + first + count);
+    }
+
+    void PoseCache::evaluate(uint32_t model, uint32_t frame, Span<tr_meshtree_node> nodes, const DirectX::SimpleMath::Matrix& world, DirectX::SimpleMath::Matrix* output) const
+    {
+        using namespace DirectX::SimpleMath;
+
+        const auto& model_poses = poses(model);
+        const uint32_t pose = model_poses.frame_poses[frame];
+        const uint32_t first = model_poses.first_rotation[pose];
+        const uint32_t count = model_poses.rotation_count[pose];
+        if (count == 0)
+        {
+            std::fill(output, output + nodes.size() + 1, world);
+            return;
+        }
+
+        const auto& rotations = model_poses.rotations;
+        const auto& header = model_poses.headers[pose];
+        const Vector3 position(header.offsetx / Scale_X, header.offsety / Scale_Y, header.offsetz / Scale_Z);
+        Matrix previous = Matrix::CreateFromQuaternion(rotations[first]) * Matrix::CreateTranslation(position);
+        output[0] = previous * world;
+
+        // Same traversal as the entity mesh tree: bit 0 pops the parent from the stack and bit 1 pushes it.
+        Matrix stack[64];
+        uint32_t stack_size = 0;
+        const std::size_t node_count = std::min<std::size_t>(nodes.size(), count - 1);
+        for (std::size_t i = 0; i < node_count; ++i)
+        {
+            const auto& node = nodes[i];
+            Matrix parent = previous;
+            if ((node.Flags & 0x1) && stack_size > 0)
+            {
+                parent = stack[--stack_size];
+            }
+            if ((node.Flags & 0x2) && stack_size < 64)
+            {
+                stack[stack_size++] = parent;
+            }
+
+            previous = Matrix::CreateFromQuaternion(rotations[first + i + 1]) * Matrix::CreateTranslation(node.position()) * parent;
+            output[i + 1] = previous * world;
+        }
+
+        // Meshes without a rotation keep the transform of the root.
+        for (std::size_t i = node_count + 1; i <= nodes.size(); ++i)
+        {
+            output[i] = output[0];
+        }
+    }
+
+    std::size_t PoseCache::memory_usage() const
+    {
+        std::size_t total = _animation_ends.capacity() * sizeof(uint32_t) + _poses.capacity() * (sizeof(std::unique_ptr<ModelPoses>) + sizeof(ModelPoses));
+        for (const auto& entry : _poses)
+        {
+            if (!entry->decoded)
+            {
+                continue;
+            }
+            total += entry->offsets.size() * sizeof(std::pair<const uint64_t, uint32_t>) +
+                entry->headers.capacity() * sizeof(FrameHeader) +
+                (entry->first_rotation.capacity() + entry->rotation_count.capacity() + entry->frame_poses.capacity()) * sizeof(uint32_t) +
+                entry->angles.capacity() * sizeof(tr2_frame_rotation) +
+                entry->rotations.capacity() * sizeof(DirectX::SimpleMath::Quaternion);
+        }
+        return total;
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <SimpleMath.h>
+
+#include "trtypes.h"
+#include "LevelVersion.h"
+#include "Span.h"
+
+namespace trlevel
+{
+    /// Decode a frame from the packed frame data.
+    /// @param version The version of the level that the frame data came from.
+    /// @param frames The frame data.
+    /// @param frame_offset The offset of the frame in words.
+    /// @param mesh_count The number of rotations to read. Ignored for Tomb Raider I, which stores the count in the frame.
+    /// @param frame The frame to populate. The rotation vector is reused.
+    /// @param end_offset If not null, receives the offset of the word after the frame.
+    /// @returns False if the frame runs past the end of the frame data.
+    bool decode_frame(LevelVersion version, const std::vector<uint16_t>& frames, uint32_t frame_offset, uint32_t mesh_count, tr2_frame& frame, uint32_t* end_offset = nullptr);
+
+    /// The frames used by the models in a level. The frames of a model are decoded the first time that the
+    /// model is posed, so levels that are never posed don't pay for decoding. Rotations are stored as separate
+    /// arrays of angles and quaternions so that posing a model again doesn't need to unpack the frame words or
+    /// do any trigonometry. Models can be posed from more than one thread at a time.
+    class PoseCache final
+    {
+    public:
+        PoseCache() = default;
+
+        /// Create the cache. No frames are decoded until they are used.
+        /// @param version The version of the level.
+        /// @param frames The packed frame data. This must outlive the cache.
+        /// @param models The models in the level. This must outlive the cache.
+        /// @param animations The animations in the level. This must outlive the cache.
+        PoseCache(LevelVersion version, const std::vector<uint16_t>& frames, const std::vector<tr_model>& models, const std::vector<tr4_animation>& animations);
+
+        /// Get the number of frames of a model - the default frame followed by the stored frames of each of its animations.
+        /// @param model The index of the model.
+        /// @returns The number of frames.
+        uint32_t num_model_frames(uint32_t model) const;
+
+        /// Copy a decoded frame of a model into a frame structure.
+        /// @param model The index of the model.
+        /// @param frame The frame of the model.
+        /// @param output The frame to populate. The rotation vector is reused.
+        void get_frame(uint32_t model, uint32_t frame, tr2_frame& output) const;
+
+        /// Calculate the mesh transforms for a frame of a model.
+        /// @param model The index of the model.
+        /// @param frame The frame of the model.
+        /// @param nodes The mesh tree nodes of the model, one less than the number of meshes.
+        /// @param world The transform from model space to world space.
+        /// @param output Receives one transform per mesh. Must have space for one more transform than there are nodes.
+        void evaluate(uint32_t model, uint32_t frame, Span<tr_meshtree_node> nodes, const DirectX::SimpleMath::Matrix& world, DirectX::SimpleMath::Matrix* output) const;
+
+        /// Get the approximate amount of memory used by the decoded frames.
+        /// @returns The number of bytes.
+        std::size_t memory_usage() const;
+    private:
+        /// The bounding box and offset from the start of a frame.
+        struct FrameHeader
+        {
+            int16_t bb1x, bb1y, bb1z;
+            int16_t bb2x, bb2y, bb2z;
+            int16_t offsetx, offsety, offsetz;
+        };
+
+        /// The decoded frames of one model.
+        struct ModelPoses
+        {
+            std::once_flag decode;
+            std::atomic<bool> decoded{ false };
+
+            /// Frames shared between animations are only decoded once. The key is the frame offset and the mesh count.
+            std::unordered_map<uint64_t, uint32_t> offsets;
+
+            // One entry per pose.
+            std::vector<FrameHeader> headers;
+            std::vector<uint32_t> first_rotation;
+            std::vector<uint32_t> rotation_count;
+
+            // One entry per rotation.
+            std::vector<tr2_frame_rotation> angles;
+            std::vector<DirectX::SimpleMath::Quaternion> rotations;
+
+            // The pose for each frame of the model.
+            std::vector<uint32_t> frame_poses;
+        };
+
+        const ModelPoses& poses(uint32_t model) const;
+        void decode(uint32_t model, ModelPoses& poses) const;
+
+        LevelVersion _version{ LevelVersion::Unknown };
+        const std::vector<uint16_t>* _frames{ nullptr };
+        const std::vector<tr_model>* _models{ nullptr };
+        const std::vector<tr4_animation>* _animations{ nullptr };
+
+        /// The animation after the last animation of each model.
+        std::vector<uint32_t> _animation_ends;
+        std::vector<std::unique_ptr<ModelPoses>> _poses;
+    };
+}
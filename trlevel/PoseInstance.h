@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+#include <SimpleMath.h>
+
+namespace trlevel
+{
+    /// A model to pose with get_world_transforms.
+    struct PoseInstance
+    {
+        /// The index of the model.
+        uint32_t model{ 0u };
+        /// The frame of the model to use. Frame 0 is the frame that the model points to, the animation
+        /// frames of the model follow on from it.
+        uint32_t frame{ 0u };
+        /// The transform from model space to world space.
+        DirectX::SimpleMath::Matrix world;
+    };
+}
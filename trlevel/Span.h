@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace trlevel
+{
+    /// Read only view of a contiguous range of elements owned by something else. The owner
+    /// must outlive the span.
+    template < typename T >
+    class Span final
+    {
+    public:
+        Span() = default;
+
+        /// Create a span over a range of elements.
+        /// @param data The first element.
+        /// @param size The number of elements.
+        Span(const T* data, std::size_t size)
+            : _data(data), _size(size)
+        {
+        }
+
+        /// Create a span over all of the elements in a vector.
+        /// @param data The vector to view.
+        Span(const std::vector<T>& data)
+            : _data(data.data()), _size(data.size())
+        {
+        }
+
+        const T* begin() const { return _data; }
+        const T* end() const { return _data + _size; }
+        const T* data() const { return _data; }
+        std::size_t size() const { return _size; }
+        bool empty() const { return _size == 0; }
+        const T& operator[](std::size_t index) const { return _data[index]; }
+    private:
+        const T* _data{ nullptr };
+        std::size_t _size{ 0u };
+    };
+}
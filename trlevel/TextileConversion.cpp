@@ -0,0 +1,222 @@
+#include "TextileConversion.h"
+#include "trtypes.h"
+
+#include <trview.common/CpuFeatures.h>
+
+#include <atomic>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define TRLEVEL_TEXTILE_SIMD
+#include <immintrin.h>
+#ifdef _MSC_VER
+// MSVC allows AVX2 intrinsics in any function, GCC and Clang have to be told which functions use them.
+#define TRLEVEL_TARGET_AVX2
+#else
+#define TRLEVEL_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace trlevel
+{
+    namespace
+    {
+        std::atomic<TextileConversionPath> forced_path{ TextileConversionPath::Default };
+
+        /// The path to use, taking into account the processor and any path forced by the tests.
+        TextileConversionPath current_path()
+        {
+            const auto forced = forced_path.load(std::memory_order_relaxed);
+            if (forced != TextileConversionPath::Default)
+            {
+                return forced;
+            }
+#ifdef TRLEVEL_TEXTILE_SIMD
+            return trview::cpu_supports_avx2() ? TextileConversionPath::Avx2 : TextileConversionPath::Sse2;
+#else
+            return TextileConversionPath::Scalar;
+#endif
+        }
+
+#ifdef TRLEVEL_TEXTILE_SIMD
+
+        /// Swap the red and blue channels of four pixels.
+        __m128i bgra_to_rgba(__m128i pixels)
+        {
+            const __m128i alpha_green = _mm_set1_epi32(static_cast<int>(0xff00ff00));
+            const __m128i low_byte = _mm_set1_epi32(0xff);
+            const __m128i red = _mm_and_si128(_mm_srli_epi32(pixels, 16), low_byte);
+            const __m128i blue = _mm_slli_epi32(_mm_and_si128(pixels, low_byte), 16);
+            return _mm_or_si128(_mm_or_si128(_mm_and_si128(pixels, alpha_green), red), blue);
+        }
+
+        /// Expand four ARGB1555 pixels that have been zero extended to 32 bits. Matches the scalar
+        /// version: each channel is shifted up by three bits and then has three added to it.
+        __m128i argb1555_to_rgba(__m128i pixels)
+        {
+            const __m128i red = _mm_and_si128(_mm_srli_epi32(pixels, 7), _mm_set1_epi32(0xf8));
+            const __m128i green = _mm_and_si128(_mm_slli_epi32(pixels, 6), _mm_set1_epi32(0xf800));
+            const __m128i blue = _mm_and_si128(_mm_slli_epi32(pixels, 19), _mm_set1_epi32(0xf80000));
+            const __m128i alpha = _mm_and_si128(_mm_srai_epi32(_mm_slli_epi32(pixels, 16), 31), _mm_set1_epi32(static_cast<int>(0xff000000)));
+            const __m128i colour = _mm_add_epi32(_mm_or_si128(_mm_or_si128(red, green), blue), _mm_set1_epi32(0x030303));
+            return _mm_or_si128(colour, alpha);
+        }
+
+        TRLEVEL_TARGET_AVX2
+        __m256i argb1555_to_rgba_avx2(__m256i pixels)
+        {
+            const __m256i red = _mm256_and_si256(_mm256_srli_epi32(pixels, 7), _mm256_set1_epi32(0xf8));
+            const __m256i green = _mm256_and_si256(_mm256_slli_epi32(pixels, 6), _mm256_set1_epi32(0xf800));
+            const __m256i blue = _mm256_and_si256(_mm256_slli_epi32(pixels, 19), _mm256_set1_epi32(0xf80000));
+            const __m256i alpha = _mm256_and_si256(_mm256_srai_epi32(_mm256_slli_epi32(pixels, 16), 31), _mm256_set1_epi32(static_cast<int>(0xff000000)));
+            const __m256i colour = _mm256_add_epi32(_mm256_or_si256(_mm256_or_si256(red, green), blue), _mm256_set1_epi32(0x030303));
+            return _mm256_or_si256(colour, alpha);
+        }
+
+        TRLEVEL_TARGET_AVX2
+        std::size_t convert_textile32_avx2(const uint32_t* input, uint32_t* output, std::size_t count)
+        {
+            const __m256i swizzle = _mm256_setr_epi8(
+                2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+                2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), _mm256_shuffle_epi8(pixels, swizzle));
+            }
+            return i;
+        }
+
+        std::size_t convert_textile32_sse2(const uint32_t* input, uint32_t* output, std::size_t count)
+        {
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), bgra_to_rgba(pixels));
+            }
+            return i;
+        }
+
+        TRLEVEL_TARGET_AVX2
+        std::size_t convert_textile16_avx2(const uint16_t* input, uint32_t* output, std::size_t count)
+        {
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m256i pixels = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i)));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), argb1555_to_rgba_avx2(pixels));
+            }
+            return i;
+        }
+
+        std::size_t convert_textile16_sse2(const uint16_t* input, uint32_t* output, std::size_t count)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), argb1555_to_rgba(_mm_unpacklo_epi16(pixels, zero)));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i + 4), argb1555_to_rgba(_mm_unpackhi_epi16(pixels, zero)));
+            }
+            return i;
+        }
+
+        TRLEVEL_TARGET_AVX2
+        std::size_t convert_textile8_avx2(const uint8_t* input, const uint32_t* palette, uint32_t* output, std::size_t count)
+        {
+            const int* table = reinterpret_cast<const int*>(palette);
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m256i indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(input + i)));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), _mm256_i32gather_epi32(table, indices, 4));
+            }
+            return i;
+        }
+#endif
+    }
+
+    void convert_textile32(const uint32_t* input, uint32_t* output, std::size_t count)
+    {
+        std::size_t i = 0;
+#ifdef TRLEVEL_TEXTILE_SIMD
+        switch (current_path())
+        {
+            case TextileConversionPath::Avx2:
+                i = convert_textile32_avx2(input, output, count);
+                break;
+            case TextileConversionPath::Sse2:
+                i = convert_textile32_sse2(input, output, count);
+                break;
+            default:
+                break;
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            output[i] = convert_textile32(input[i]);
+        }
+    }
+
+    void convert_textile16(const uint16_t* input, uint32_t* output, std::size_t count)
+    {
+        std::size_t i = 0;
+#ifdef TRLEVEL_TEXTILE_SIMD
+        switch (current_path())
+        {
+            case TextileConversionPath::Avx2:
+                i = convert_textile16_avx2(input, output, count);
+                break;
+            case TextileConversionPath::Sse2:
+                i = convert_textile16_sse2(input, output, count);
+                break;
+            default:
+                break;
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            output[i] = convert_textile16(input[i]);
+        }
+    }
+
+    void convert_textile8(const uint8_t* input, const uint32_t* palette, uint32_t* output, std::size_t count)
+    {
+        // There is no gather instruction before AVX2, so without it this is a plain table lookup.
+        std::size_t i = 0;
+#ifdef TRLEVEL_TEXTILE_SIMD
+        if (current_path() == TextileConversionPath::Avx2)
+        {
+            i = convert_textile8_avx2(input, palette, output, count);
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            output[i] = palette[input[i]];
+        }
+    }
+
+    bool textile_conversion_uses_avx2()
+    {
+        return current_path() == TextileConversionPath::Avx2;
+    }
+
+    bool force_textile_conversion_path(TextileConversionPath path)
+    {
+#ifdef TRLEVEL_TEXTILE_SIMD
+        if (path == TextileConversionPath::Avx2 && !trview::cpu_supports_avx2())
+        {
+            return false;
+        }
+#else
+        if (path == TextileConversionPath::Sse2 || path == TextileConversionPath::Avx2)
+        {
+            return false;
+        }
+#endif
+        forced_path = path;
+        return true;
+    }
+}
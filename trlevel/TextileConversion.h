@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+
+namespace trlevel
+{
+    /// Convert 32 bit BGRA textile pixels into RGBA pixels.
+    /// @param input The pixels to convert.
+    /// @param output The buffer to write to. Must have space for count pixels.
+    /// @param count The number of pixels to convert.
+    void convert_textile32(const uint32_t* input, uint32_t* output, std::size_t count);
+
+    /// Convert 16 bit ARGB1555 textile pixels into RGBA pixels.
+    /// @param input The pixels to convert.
+    /// @param output The buffer to write to. Must have space for count pixels.
+    /// @param count The number of pixels to convert.
+    void convert_textile16(const uint16_t* input, uint32_t* output, std::size_t count);
+
+    /// Convert 8 bit palette indices into RGBA pixels.
+    /// @param input The palette indices to convert.
+    /// @param palette The 256 entry RGBA palette.
+    /// @param output The buffer to write to. Must have space for count pixels.
+    /// @param count The number of pixels to convert.
+    void convert_textile8(const uint8_t* input, const uint32_t* palette, uint32_t* output, std::size_t count);
+
+    /// Whether the conversion functions are able to use AVX2 on this machine. When this is false
+    /// SSE2 is used where available, otherwise the pixels are converted one at a time.
+    /// @returns True if AVX2 is in use.
+    bool textile_conversion_uses_avx2();
+
+    /// The ways that textile pixels can be converted.
+    enum class TextileConversionPath
+    {
+        /// AVX2 if the processor supports it, otherwise SSE2, otherwise one pixel at a time.
+        Default,
+        /// One pixel at a time.
+        Scalar,
+        /// SSE2. 8 bit textiles are converted one pixel at a time as there is no gather instruction.
+        Sse2,
+        Avx2
+    };
+
+    /// Make the conversion functions use one path so that the paths can be compared. Only for use in tests.
+    /// @param path The path to use.
+    /// @returns False if this machine can't use the path, in which case the path in use is not changed.
+    bool force_textile_conversion_path(TextileConversionPath path);
+}
@@ -1,10 +1,34 @@
 #include "trlevel.h"
 #include "Level.h"
+#include "LevelLoadException.h"
+
+#include <trview.common/ThreadPool.h>
 
 namespace trlevel
 {
-    std::unique_ptr<ILevel> load_level(const std::string& filename)
+    std::unique_ptr<ILevel> load_level(const std::string& filename, const LoadOptions& options, const LoadCallbacks& callbacks)
+    {
+        return std::make_unique<Level>(filename, options, callbacks);
+    }
+
+    LevelSummary probe_level(const std::string& filename)
+    {
+        return Level(filename, LoadOptions::none()).summary();
+    }
+
+    std::vector<std::optional<LevelSummary>> probe_levels(const std::vector<std::string>& filenames)
     {
-        return std::make_unique<Level>(filename);
+        std::vector<std::optional<LevelSummary>> summaries(filenames.size());
+        trview::parallel_for(trview::ThreadPool::shared(), filenames.size(), [&](std::size_t index)
+        {
+            try
+            {
+                summaries[index] = probe_level(filenames[index]);
+            }
+            catch (const LevelLoadException&)
+            {
+            }
+        });
+        return summaries;
     }
-}
\ No newline at end of file
+}
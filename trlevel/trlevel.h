@@ -1,13 +1,32 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "ILevel.h"
+#include "LevelSummary.h"
+#include "LoadOptions.h"
 
 namespace trlevel
 {
     // Load the level at the specified location.
+    // filename: The level file to load.
+    // options: The sections of the level to load.
+    // callbacks: Optional functions to call as the rooms are read, so that they can be used before
+    // the rest of the level has finished loading.
     // Returns: The loaded level.
-    std::unique_ptr<ILevel> load_level(const std::string& filename);
-}
\ No newline at end of file
+    std::unique_ptr<ILevel> load_level(const std::string& filename, const LoadOptions& options = LoadOptions(), const LoadCallbacks& callbacks = LoadCallbacks());
+
+    // Read the version and section counts of a level without loading the sections.
+    // filename: The level file to probe.
+    // Returns: The level summary. Throws LevelLoadException if the level could not be read.
+    LevelSummary probe_level(const std::string& filename);
+
+    // Probe a set of levels at the same time using the shared thread pool.
+    // filenames: The level files to probe.
+    // Returns: The summary for each file in the same order as the filenames. Files that could not be
+    // read will have no value.
+    std::vector<std::optional<LevelSummary>> probe_levels(const std::vector<std::string>& filenames);
+}
@@ -191,4 +191,31 @@ namespace trlevel
             std::back_inserter(new_models), [](const auto& model) { return model.model; });
         return new_models;
     }
+
+    std::vector<tr4_animation> convert_animations(const std::vector<tr_animation>& animations)
+    {
+        std::vector<tr4_animation> new_animations;
+        new_animations.reserve(animations.size());
+        std::transform(animations.begin(), animations.end(), std::back_inserter(new_animations),
+            [](const auto& animation)
+        {
+            tr4_animation new_animation{};
+            new_animation.FrameOffset = animation.FrameOffset;
+            new_animation.FrameRate = animation.FrameRate;
+            new_animation.FrameSize = animation.FrameSize;
+            new_animation.State_ID = animation.State_ID;
+            new_animation.Speed = animation.Speed;
+            new_animation.Accel = animation.Accel;
+            new_animation.FrameStart = animation.FrameStart;
+            new_animation.FrameEnd = animation.FrameEnd;
+            new_animation.NextAnimation = animation.NextAnimation;
+            new_animation.NextFrame = animation.NextFrame;
+            new_animation.NumStateChanges = animation.NumStateChanges;
+            new_animation.StateChangeOffset = animation.StateChangeOffset;
+            new_animation.NumAnimCommands = animation.NumAnimCommands;
+            new_animation.AnimCommand = animation.AnimCommand;
+            return new_animation;
+        });
+        return new_animations;
+    }
 }
\ No newline at end of file
@@ -716,4 +716,9 @@ namespace trlevel
     tr_room_info convert_room_info(const tr1_4_room_info& room_info);
 
     std::vector<tr_model> convert_models(std::vector<tr5_model> models);
+
+    /// Convert a set of Tomb Raider I-III animations into the Tomb Raider IV format. The lateral speed and acceleration are zero.
+    /// @param animations The animations to convert.
+    /// @returns The converted animations.
+    std::vector<tr4_animation> convert_animations(const std::vector<tr_animation>& animations);
 }
\ No newline at end of file
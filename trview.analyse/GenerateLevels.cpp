@@ -0,0 +1,43 @@
+#include <trlevel.benchmarks/SyntheticLevel.h>
+
+#include <filesystem>
+
+using namespace trlevel;
+using namespace trlevel::benchmarks;
+
+// Writes one synthetic level for each version to a directory so that trview.analyse can be run
+// somewhere that has no real levels, such as CI.
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: trview.analyse.levels <directory>" << std::endl;
+        return 1;
+    }
+
+    const std::pair<LevelVersion, std::string> levels[] =
+    {
+        { LevelVersion::Tomb1, "tomb1" },
+        { LevelVersion::Tomb2, "tomb2" },
+        { LevelVersion::Tomb3, "tomb3" },
+        { LevelVersion::Tomb4, "tomb4" },
+        { LevelVersion::Tomb5, "tomb5" }
+    };
+
+    try
+    {
+        std::filesystem::create_directories(argv[1]);
+        for (const auto& level : levels)
+        {
+            SyntheticLevelOptions options;
+            options.version = level.first;
+            std::cout << write_synthetic_level(options, argv[1], level.second) << std::endl;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
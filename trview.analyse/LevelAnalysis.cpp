@@ -0,0 +1,159 @@
+#include "LevelAnalysis.h"
+
+#include <trlevel/LevelLoadException.h>
+#include <trlevel/trlevel.h>
+#include <trview.app/Elements/FloorData.h>
+#include <trview.common/Strings.h>
+
+namespace trview
+{
+    namespace analyse
+    {
+        namespace
+        {
+            const uint16_t Texture_Mask = 0x7fff;
+            const uint16_t Tile_Mask = 0x7fff;
+
+            double elapsed_milliseconds(std::chrono::steady_clock::time_point start)
+            {
+                return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            }
+
+            template <typename Face>
+            void count_textile_usage(const std::vector<Face>& faces, const std::vector<uint16_t>& face_textiles, std::vector<uint32_t>& usage)
+            {
+                for (const auto& face : faces)
+                {
+                    const uint16_t texture = face.texture & Texture_Mask;
+                    if (texture < face_textiles.size() && face_textiles[texture] < usage.size())
+                    {
+                        ++usage[face_textiles[texture]];
+                    }
+                }
+            }
+        }
+
+        void analyse_level(const trlevel::ILevel& level, LevelAnalysis& analysis)
+        {
+            analysis.version = level.get_version();
+            analysis.rooms = level.num_rooms();
+            analysis.entities = level.num_entities();
+            analysis.textiles = level.num_textiles();
+            analysis.textile_usage.assign(analysis.textiles, 0u);
+
+            for (uint32_t i = 0; i < analysis.entities; ++i)
+            {
+                ++analysis.entity_types[level.get_entity(i).TypeID];
+            }
+
+            std::vector<uint16_t> face_textiles(level.num_object_textures());
+            for (uint32_t i = 0; i < face_textiles.size(); ++i)
+            {
+                face_textiles[i] = level.get_object_texture(i).TileAndFlag & Tile_Mask;
+            }
+
+            const FloorData floor_data(level);
+            for (uint32_t i = 0; i < analysis.rooms; ++i)
+            {
+                const auto& room = level.room(i);
+                analysis.rectangles += static_cast<uint32_t>(room.data.rectangles.size());
+                analysis.triangles += static_cast<uint32_t>(room.data.triangles.size());
+                count_textile_usage(room.data.rectangles, face_textiles, analysis.textile_usage);
+                count_textile_usage(room.data.triangles, face_textiles, analysis.textile_usage);
+
+                for (const auto& sector : room.sector_list)
+                {
+                    const auto& record = floor_data.record(sector.floordata_index);
+                    if (record.flags & SectorFlag::Trigger)
+                    {
+                        ++analysis.triggers;
+                        ++analysis.trigger_types[to_utf8(trigger_type_name(record.trigger.type))];
+                        analysis.trigger_commands += static_cast<uint32_t>(record.trigger.commands.size());
+                    }
+                }
+            }
+        }
+
+        LevelAnalysis analyse_level(const std::string& filename)
+        {
+            LevelAnalysis analysis;
+            analysis.filename = filename;
+
+            try
+            {
+                // Sound samples are not counted, so there is no need to read them.
+                auto options = trlevel::LoadOptions::all();
+                options.sound_samples = false;
+
+                auto start = std::chrono::steady_clock::now();
+                const auto level = trlevel::load_level(filename, options);
+                analysis.load_time = elapsed_milliseconds(start);
+
+                start = std::chrono::steady_clock::now();
+                analyse_level(*level, analysis);
+                analysis.analyse_time = elapsed_milliseconds(start);
+            }
+            catch (const trlevel::LevelLoadException&)
+            {
+                analysis.error = "Level could not be loaded";
+            }
+            catch (const std::exception& e)
+            {
+                analysis.error = e.what();
+            }
+
+            return analysis;
+        }
+
+        nlohmann::json to_json(const LevelAnalysis& analysis)
+        {
+            nlohmann::json json;
+            json["file"] = analysis.filename;
+            if (!analysis.error.empty())
+            {
+                json["error"] = analysis.error;
+                return json;
+            }
+
+            json["version"] = version_name(analysis.version);
+            json["load_ms"] = analysis.load_time;
+            json["analyse_ms"] = analysis.analyse_time;
+            json["rooms"] = analysis.rooms;
+            json["rectangles"] = analysis.rectangles;
+            json["triangles"] = analysis.triangles;
+            json["entities"] = analysis.entities;
+
+            nlohmann::json entity_types = nlohmann::json::object();
+            for (const auto& type : analysis.entity_types)
+            {
+                entity_types[std::to_string(type.first)] = type.second;
+            }
+            json["entity_types"] = entity_types;
+
+            json["triggers"] = analysis.triggers;
+            json["trigger_types"] = analysis.trigger_types;
+            json["trigger_commands"] = analysis.trigger_commands;
+            json["textiles"] = analysis.textiles;
+            json["textile_usage"] = analysis.textile_usage;
+            return json;
+        }
+
+        std::string version_name(trlevel::LevelVersion version)
+        {
+            switch (version)
+            {
+            case trlevel::LevelVersion::Tomb1:
+                return "Tomb1";
+            case trlevel::LevelVersion::Tomb2:
+                return "Tomb2";
+            case trlevel::LevelVersion::Tomb3:
+                return "Tomb3";
+            case trlevel::LevelVersion::Tomb4:
+                return "Tomb4";
+            case trlevel::LevelVersion::Tomb5:
+                return "Tomb5";
+            }
+            return "Unknown";
+        }
+    }
+}
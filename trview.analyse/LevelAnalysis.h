@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <external/nlohmann/json.hpp>
+#include <trlevel/ILevel.h>
+
+namespace trview
+{
+    namespace analyse
+    {
+        /// Statistics gathered from a single level file.
+        struct LevelAnalysis
+        {
+            std::string filename;
+            /// The reason the level could not be analysed. Empty if the level was analysed.
+            std::string error;
+            trlevel::LevelVersion version{ trlevel::LevelVersion::Unknown };
+            /// The time taken to load the level, in milliseconds.
+            double load_time{ 0 };
+            /// The time taken to decode the floordata and count everything, in milliseconds.
+            double analyse_time{ 0 };
+            uint32_t rooms{ 0u };
+            uint32_t rectangles{ 0u };
+            uint32_t triangles{ 0u };
+            uint32_t entities{ 0u };
+            /// The number of entities of each type ID.
+            std::map<int16_t, uint32_t> entity_types;
+            uint32_t triggers{ 0u };
+            /// The number of triggers of each type, keyed by the trigger type name.
+            std::map<std::string, uint32_t> trigger_types;
+            uint32_t trigger_commands{ 0u };
+            uint32_t textiles{ 0u };
+            /// The number of room faces that use each textile.
+            std::vector<uint32_t> textile_usage;
+        };
+
+        /// Gather the statistics for a level that has been loaded.
+        /// @param level The level to analyse.
+        /// @param analysis The analysis to fill in. The filename, error and load time are not changed.
+        void analyse_level(const trlevel::ILevel& level, LevelAnalysis& analysis);
+
+        /// Load a level and gather its statistics. Levels that fail to load have the error set.
+        /// @param filename The level file to analyse.
+        /// @returns The analysis of the level.
+        LevelAnalysis analyse_level(const std::string& filename);
+
+        /// Convert an analysis to the JSON object written for each level.
+        /// @param analysis The analysis to convert.
+        /// @returns The JSON object.
+        nlohmann::json to_json(const LevelAnalysis& analysis);
+
+        /// Get the name of a level version.
+        /// @param version The version to convert.
+        /// @returns The name of the version.
+        std::string version_name(trlevel::LevelVersion version);
+    }
+}
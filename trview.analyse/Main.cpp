@@ -0,0 +1,90 @@
+#include "LevelAnalysis.h"
+
+#include <trview.common/ThreadPool.h>
+
+namespace
+{
+    const std::string Level_Extensions[] = { ".phd", ".tub", ".tr2", ".tr4", ".trc" };
+
+    bool is_level_file(const std::filesystem::path& path)
+    {
+        std::string extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+            [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+        return std::find(std::begin(Level_Extensions), std::end(Level_Extensions), extension) != std::end(Level_Extensions);
+    }
+
+    /// Find every level file in a directory and its subdirectories.
+    std::vector<std::string> find_levels(const std::filesystem::path& directory)
+    {
+        std::vector<std::string> filenames;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied))
+        {
+            if (entry.is_regular_file() && is_level_file(entry.path()))
+            {
+                filenames.push_back(entry.path().string());
+            }
+        }
+        std::sort(filenames.begin(), filenames.end());
+        return filenames;
+    }
+
+    void print_usage(std::ostream& stream)
+    {
+        stream << "Usage: trview.analyse <directory>" << std::endl
+            << std::endl
+            << "Analyses every level in <directory> and its subdirectories and writes one JSON object per level" << std::endl
+            << "to stdout, one per line. Levels are analysed in parallel and each line is written when its level" << std::endl
+            << "finishes, so the lines are in completion order rather than sorted by filename. Use the \"file\"" << std::endl
+            << "field to match lines to levels." << std::endl
+            << std::endl
+            << "Exits with 0 if every level was analysed, 1 if the arguments or directory are invalid and 2 if" << std::endl
+            << "any level could not be loaded. Levels that could not be loaded have an \"error\" field." << std::endl;
+    }
+}
+
+// Analyses every level in a directory and writes one JSON object per level to stdout, as each level
+// finishes. Levels are analysed in parallel using the shared thread pool, so the output is in completion
+// order and not sorted.
+int main(int argc, char* argv[])
+{
+    if (argc == 2 && (std::string(argv[1]) == "--help" || std::string(argv[1]) == "-h"))
+    {
+        print_usage(std::cout);
+        return 0;
+    }
+
+    if (argc != 2)
+    {
+        print_usage(std::cerr);
+        return 1;
+    }
+
+    std::vector<std::string> filenames;
+    try
+    {
+        filenames = find_levels(argv[1]);
+    }
+    catch (const std::filesystem::filesystem_error& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    std::mutex output_mutex;
+    std::atomic<std::size_t> failed{ 0u };
+    trview::parallel_for(trview::ThreadPool::shared(), filenames.size(), [&](std::size_t i)
+    {
+        const auto analysis = trview::analyse::analyse_level(filenames[i]);
+        if (!analysis.error.empty())
+        {
+            ++failed;
+        }
+
+        const auto line = trview::analyse::to_json(analysis).dump();
+        std::lock_guard<std::mutex> lock(output_mutex);
+        std::cout << line << std::endl;
+    });
+
+    return failed == 0 ? 0 : 2;
+}
@@ -0,0 +1,43 @@
+# Checks the output of trview.analyse when run on the levels written by trview.analyse.levels.
+#   python3 check_analysis.py <output file> <exit code> <expected levels> <expected failures>
+import json
+import sys
+
+output_file, exit_code, expected_levels, expected_failures = sys.argv[1], int(sys.argv[2]), int(sys.argv[3]), int(sys.argv[4])
+
+with open(output_file) as f:
+    rows = [json.loads(line) for line in f if line.strip()]
+
+errors = []
+if len(rows) != expected_levels:
+    errors.append(f"expected {expected_levels} rows, got {len(rows)}")
+
+failures = [row for row in rows if "error" in row]
+if len(failures) != expected_failures:
+    errors.append(f"expected {expected_failures} failed levels, got {len(failures)}")
+
+expected_exit_code = 2 if expected_failures else 0
+if exit_code != expected_exit_code:
+    errors.append(f"expected exit code {expected_exit_code}, got {exit_code}")
+
+if len({row["file"] for row in rows}) != len(rows):
+    errors.append("a level was written more than once")
+
+for row in rows:
+    if "error" in row:
+        continue
+    for field in ("version", "load_ms", "analyse_ms", "rooms", "rectangles", "triangles", "entities",
+                  "entity_types", "triggers", "trigger_types", "trigger_commands", "textiles", "textile_usage"):
+        if field not in row:
+            errors.append(f"{row['file']}: missing {field}")
+    # The generator writes 100 rooms and 200 entities for every version.
+    if row.get("rooms") != 100:
+        errors.append(f"{row['file']}: expected 100 rooms, got {row.get('rooms')}")
+    if row.get("entities") != 200:
+        errors.append(f"{row['file']}: expected 200 entities, got {row.get('entities')}")
+    if sum(row.get("entity_types", {}).values()) != row.get("entities"):
+        errors.append(f"{row['file']}: entity types do not add up to the number of entities")
+
+for error in errors:
+    print(error)
+sys.exit(1 if errors else 0)
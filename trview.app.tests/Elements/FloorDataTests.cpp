@@ -0,0 +1,81 @@
+#include <trview.app/Elements/FloorData.h>
+
+using namespace trview;
+
+// Tests that a complete trigger is decoded.
+TEST(FloorData, DecodesTrigger)
+{
+    // Index 0 is the dummy entry. The trigger is a pad with an object command and a camera command. The extra word
+    // of the camera command ends the list.
+    const std::vector<uint16_t> floor_data{ 0, 0x8000 | 0x0100 | 0x4, 0x0105, 0x0003, 0x0400 | 0x0002, 0x8001 };
+    const auto record = decode_floordata(floor_data, 1);
+
+    ASSERT_TRUE(record.flags & SectorFlag::Trigger);
+    ASSERT_EQ(TriggerType::Pad, record.trigger.type);
+    ASSERT_EQ(5u, record.trigger.timer);
+    ASSERT_EQ(1u, record.trigger.oneshot);
+    ASSERT_EQ(2u, record.trigger.commands.size());
+    ASSERT_EQ(TriggerCommandType::Object, record.trigger.commands[0].first);
+    ASSERT_EQ(3u, record.trigger.commands[0].second);
+    ASSERT_EQ(TriggerCommandType::Camera, record.trigger.commands[1].first);
+    ASSERT_EQ(2u, record.trigger.commands[1].second);
+}
+
+// Tests that a trigger list that runs off the end of the floordata keeps the commands that were read and stops there.
+TEST(FloorData, TruncatedTriggerList)
+{
+    // The last command doesn't have the end bit set.
+    const std::vector<uint16_t> floor_data{ 0, 0x8000 | 0x4, 0x0000, 0x0003, 0x0004 };
+    const auto record = decode_floordata(floor_data, 1);
+
+    ASSERT_TRUE(record.flags & SectorFlag::Trigger);
+    ASSERT_EQ(2u, record.trigger.commands.size());
+    ASSERT_EQ(3u, record.trigger.commands[0].second);
+    ASSERT_EQ(4u, record.trigger.commands[1].second);
+}
+
+// Tests that a camera command that is missing its extra word stops decoding.
+TEST(FloorData, TruncatedCameraCommand)
+{
+    const std::vector<uint16_t> floor_data{ 0, 0x8000 | 0x4, 0x0000, 0x0400 | 0x0002 };
+    const auto record = decode_floordata(floor_data, 1);
+
+    ASSERT_TRUE(record.flags & SectorFlag::Trigger);
+    ASSERT_EQ(1u, record.trigger.commands.size());
+    ASSERT_EQ(TriggerCommandType::Camera, record.trigger.commands[0].first);
+}
+
+// Tests that a trigger without its setup word is not decoded.
+TEST(FloorData, TruncatedTriggerSetup)
+{
+    const std::vector<uint16_t> floor_data{ 0, 0x8000 | 0x4 };
+    const auto record = decode_floordata(floor_data, 1);
+
+    ASSERT_FALSE(record.flags & SectorFlag::Trigger);
+    ASSERT_TRUE(record.trigger.commands.empty());
+}
+
+// Tests that a floor slant without its slant word is not decoded, but the functions before it are kept.
+TEST(FloorData, TruncatedSlant)
+{
+    const std::vector<uint16_t> floor_data{ 0, 0x1, 0x0005, 0x8000 | 0x2 };
+    const auto record = decode_floordata(floor_data, 1);
+
+    ASSERT_TRUE(record.flags & SectorFlag::Portal);
+    ASSERT_EQ(5u, record.portal);
+    ASSERT_FALSE(record.flags & SectorFlag::FloorSlant);
+    ASSERT_EQ(0u, record.floor_slant);
+    const std::array<float, 4> flat{ 0, 0, 0, 0 };
+    ASSERT_EQ(flat, record.corner_offsets);
+}
+
+// Tests that a ceiling slant, portal or triangulation at the end of the floordata without its data word is not decoded.
+TEST(FloorData, TruncatedSingleWordFunctions)
+{
+    ASSERT_FALSE(decode_floordata({ 0, 0x8000 | 0x3 }, 1).flags & SectorFlag::CeilingSlant);
+    ASSERT_FALSE(decode_floordata({ 0, 0x8000 | 0x1 }, 1).flags & SectorFlag::Portal);
+
+    const auto triangulation = decode_floordata({ 0, 0x8000 | 0x7 }, 1);
+    const std::array<float, 4> flat{ 0, 0, 0, 0 };
+    ASSERT_EQ(flat, triangulation.corner_offsets);
+}
@@ -6,6 +6,8 @@ using namespace trview::graphics;
 using namespace trlevel;
 using testing::NiceMock;
 using testing::Return;
+using testing::ReturnRef;
+using testing::SaveArg;
 
 namespace
 {
@@ -27,13 +29,16 @@ namespace
         MOCK_METHOD(tr_textile8, get_textile8, (uint32_t), (const, override));
         MOCK_METHOD(tr_textile16, get_textile16, (uint32_t), (const, override));
         MOCK_METHOD(std::vector<uint32_t>, get_textile, (uint32_t), (const, override));
+        MOCK_METHOD(void, get_textile, (uint32_t, std::vector<uint32_t>&), (const, override));
         MOCK_METHOD(uint32_t, num_rooms, (), (const, override));
         MOCK_METHOD(tr3_room, get_room, (uint32_t), (const, override));
+        MOCK_METHOD(const tr3_room&, room, (uint32_t), (const, override));
         MOCK_METHOD(uint32_t, num_object_textures, (), (const, override));
         MOCK_METHOD(tr_object_texture, get_object_texture, (uint32_t), (const, override));
         MOCK_METHOD(uint32_t, num_floor_data, (), (const, override));
         MOCK_METHOD(uint16_t, get_floor_data, (uint32_t), (const, override));
         MOCK_METHOD(std::vector<uint16_t>, get_floor_data_all, (), (const, override));
+        MOCK_METHOD(const std::vector<uint16_t>&, floor_data, (), (const, override));
         MOCK_METHOD(uint32_t, num_entities, (), (const, override));
         MOCK_METHOD(tr2_entity, get_entity, (uint32_t), (const, override));
         MOCK_METHOD(uint32_t, num_models, (), (const, override));
@@ -43,13 +48,27 @@ namespace
         MOCK_METHOD(tr_staticmesh, get_static_mesh, (uint32_t), (const, override));
         MOCK_METHOD(uint32_t, num_mesh_pointers, (), (const, override));
         MOCK_METHOD(tr_mesh, get_mesh_by_pointer, (uint32_t), (const, override));
+        MOCK_METHOD(const tr_mesh&, mesh, (uint32_t), (const, override));
         MOCK_METHOD(std::vector<tr_meshtree_node>, get_meshtree, (uint32_t, uint32_t), (const, override));
+        MOCK_METHOD(Span<tr_meshtree_node>, meshtree, (uint32_t, uint32_t), (const, override));
         MOCK_METHOD(tr2_frame, get_frame, (uint32_t, uint32_t), (const, override));
+        MOCK_METHOD(void, get_frame, (uint32_t, uint32_t, tr2_frame&), (const, override));
+        MOCK_METHOD(Span<tr4_animation>, animations, (), (const, override));
+        MOCK_METHOD(Span<tr_state_change>, state_changes, (), (const, override));
+        MOCK_METHOD(Span<tr_anim_dispatch>, anim_dispatches, (), (const, override));
+        MOCK_METHOD(Span<tr_anim_command>, anim_commands, (), (const, override));
+        MOCK_METHOD(uint32_t, num_model_frames, (uint32_t), (const, override));
+        MOCK_METHOD(void, get_world_transforms, (Span<PoseInstance>, std::vector<DirectX::SimpleMath::Matrix>&), (const, override));
+        MOCK_METHOD(uint32_t, num_sound_samples, (), (const, override));
+        MOCK_METHOD(std::vector<uint8_t>, get_sound_sample, (uint32_t), (const, override));
         MOCK_METHOD(LevelVersion, get_version, (), (const, override));
         MOCK_METHOD(bool, get_sprite_sequence_by_id, (int32_t, tr_sprite_sequence&), (const, override));
         MOCK_METHOD(tr_sprite_texture, get_sprite_texture, (uint32_t), (const, override));
         MOCK_METHOD(bool, find_first_entity_by_type, (int16_t, tr2_entity&), (const, override));
+        MOCK_METHOD(Span<uint32_t>, entities_by_type, (int16_t), (const, override));
         MOCK_METHOD(int16_t, get_mesh_from_type_id, (int16_t), (const, override));
+        MOCK_METHOD(void, trim, (const LoadOptions&), (override));
+        MOCK_METHOD(std::size_t, memory_usage, (), (const, override));
     };
 
     class MockTypeNameLookup : public ITypeNameLookup
@@ -66,11 +85,17 @@ TEST(Level, LoadTypeNames)
     entity.Room = 0;
     entity.TypeID = 123;
 
+    tr3_room level_room;
+    const std::vector<uint16_t> floor_data;
     auto mock_level = std::make_unique<testing::NiceMock<MockLevel>>();
     EXPECT_CALL(*mock_level, get_version)
         .WillRepeatedly(Return(LevelVersion::Tomb2));
+    EXPECT_CALL(*mock_level, floor_data())
+        .WillRepeatedly(ReturnRef(floor_data));
     EXPECT_CALL(*mock_level, num_rooms())
         .WillRepeatedly(Return(1));
+    EXPECT_CALL(*mock_level, room(0))
+        .WillRepeatedly(ReturnRef(level_room));
     EXPECT_CALL(*mock_level, num_entities())
         .WillRepeatedly(Return(1));
     EXPECT_CALL(*mock_level, get_entity(0))
@@ -80,4 +105,175 @@ TEST(Level, LoadTypeNames)
     EXPECT_CALL(mock_type_name_lookup, lookup_type_name(LevelVersion::Tomb2, 123));
 
     Level level(graphics::Device(), NiceMock<MockShaderStorage>(), std::move(mock_level), mock_type_name_lookup);
-}
\ No newline at end of file
+}
+// Tests that the room containing Lara has its geometry generated when the level is created and that
+// the other rooms are left until later.
+TEST(Level, GeneratesLaraRoomGeometryFirst)
+{
+    tr2_entity entity;
+    entity.Room = 1;
+    entity.TypeID = 0;
+
+    tr3_room level_room;
+    const std::vector<uint16_t> floor_data;
+    auto mock_level = std::make_unique<testing::NiceMock<MockLevel>>();
+    EXPECT_CALL(*mock_level, get_version)
+        .WillRepeatedly(Return(LevelVersion::Tomb2));
+    EXPECT_CALL(*mock_level, floor_data())
+        .WillRepeatedly(ReturnRef(floor_data));
+    EXPECT_CALL(*mock_level, num_rooms())
+        .WillRepeatedly(Return(2));
+    EXPECT_CALL(*mock_level, room)
+        .WillRepeatedly(ReturnRef(level_room));
+    EXPECT_CALL(*mock_level, num_entities())
+        .WillRepeatedly(Return(1));
+    EXPECT_CALL(*mock_level, get_entity(0))
+        .WillRepeatedly(Return(entity));
+
+    graphics::Device device;
+    Level level(device, NiceMock<MockShaderStorage>(), std::move(mock_level), NiceMock<MockTypeNameLookup>());
+    ASSERT_TRUE(level.room(1)->geometry_generated());
+    ASSERT_FALSE(level.room(0)->geometry_generated());
+    ASSERT_TRUE(level.rooms_pending());
+
+    level.generate_pending_rooms(device, std::chrono::milliseconds::zero());
+    ASSERT_TRUE(level.room(0)->geometry_generated());
+    ASSERT_FALSE(level.rooms_pending());
+}
+
+// Tests that everything except the room geometry is released from the level once the level has been created.
+TEST(Level, TrimsLevelAfterCreation)
+{
+    tr3_room level_room;
+    const std::vector<uint16_t> floor_data;
+    auto mock_level = std::make_unique<testing::NiceMock<MockLevel>>();
+    EXPECT_CALL(*mock_level, get_version)
+        .WillRepeatedly(Return(LevelVersion::Tomb2));
+    EXPECT_CALL(*mock_level, floor_data())
+        .WillRepeatedly(ReturnRef(floor_data));
+    EXPECT_CALL(*mock_level, num_rooms())
+        .WillRepeatedly(Return(1));
+    EXPECT_CALL(*mock_level, room)
+        .WillRepeatedly(ReturnRef(level_room));
+
+    LoadOptions sections;
+    EXPECT_CALL(*mock_level, trim)
+        .WillOnce(SaveArg<0>(&sections));
+
+    Level level(graphics::Device(), NiceMock<MockShaderStorage>(), std::move(mock_level), NiceMock<MockTypeNameLookup>());
+    ASSERT_FALSE(sections.textures);
+    ASSERT_TRUE(sections.rooms);
+    ASSERT_FALSE(sections.models);
+    ASSERT_FALSE(sections.entities);
+    ASSERT_FALSE(sections.sound_samples);
+}
+
+// Tests that the geometry built for a level is only available once every room has been generated, and that a level
+// created with that geometry has every room generated without keeping the room data.
+TEST(Level, CreatesRoomsFromGeneratedGeometry)
+{
+    tr3_room level_room;
+    const std::vector<uint16_t> floor_data;
+    auto create_mock_level = [&]()
+    {
+        auto mock_level = std::make_unique<testing::NiceMock<MockLevel>>();
+        EXPECT_CALL(*mock_level, get_version)
+            .WillRepeatedly(Return(LevelVersion::Tomb2));
+        EXPECT_CALL(*mock_level, floor_data())
+            .WillRepeatedly(ReturnRef(floor_data));
+        EXPECT_CALL(*mock_level, num_rooms())
+            .WillRepeatedly(Return(2));
+        EXPECT_CALL(*mock_level, room)
+            .WillRepeatedly(ReturnRef(level_room));
+        return mock_level;
+    };
+
+    graphics::Device device;
+    Level level(device, NiceMock<MockShaderStorage>(), create_mock_level(), NiceMock<MockTypeNameLookup>());
+    ASSERT_TRUE(level.rooms_pending());
+    ASSERT_TRUE(level.take_generated_geometry().empty());
+
+    level.generate_pending_rooms(device, std::chrono::milliseconds::zero());
+    const auto geometry = level.take_generated_geometry();
+    ASSERT_FALSE(geometry.empty());
+    ASSERT_TRUE(level.take_generated_geometry().empty());
+
+    auto cached_mock_level = create_mock_level();
+    LoadOptions sections;
+    EXPECT_CALL(*cached_mock_level, trim)
+        .WillOnce(SaveArg<0>(&sections));
+
+    Level cached_level(device, NiceMock<MockShaderStorage>(), std::move(cached_mock_level), NiceMock<MockTypeNameLookup>(), geometry);
+    ASSERT_TRUE(cached_level.room(0)->geometry_generated());
+    ASSERT_TRUE(cached_level.room(1)->geometry_generated());
+    ASSERT_FALSE(cached_level.rooms_pending());
+    ASSERT_FALSE(sections.rooms);
+    ASSERT_TRUE(cached_level.take_generated_geometry().empty());
+}
+
+// Tests that geometry that can't be loaded is ignored and the geometry is built from the level instead.
+TEST(Level, BuildsGeometryWhenCachedGeometryIsNotValid)
+{
+    tr3_room level_room;
+    const std::vector<uint16_t> floor_data;
+    auto mock_level = std::make_unique<testing::NiceMock<MockLevel>>();
+    EXPECT_CALL(*mock_level, get_version)
+        .WillRepeatedly(Return(LevelVersion::Tomb2));
+    EXPECT_CALL(*mock_level, floor_data())
+        .WillRepeatedly(ReturnRef(floor_data));
+    EXPECT_CALL(*mock_level, num_rooms())
+        .WillRepeatedly(Return(2));
+    EXPECT_CALL(*mock_level, room)
+        .WillRepeatedly(ReturnRef(level_room));
+
+    graphics::Device device;
+    Level level(device, NiceMock<MockShaderStorage>(), std::move(mock_level), NiceMock<MockTypeNameLookup>(), { 1, 2, 3 });
+    ASSERT_TRUE(level.rooms_pending());
+
+    level.generate_pending_rooms(device, std::chrono::milliseconds::zero());
+    ASSERT_FALSE(level.take_generated_geometry().empty());
+}
+
+// Tests that rooms can be created from a level that is still loading using only the rooms and the floordata, and that
+// finishing the level keeps those rooms and creates the rest.
+TEST(Level, LoadsRoomsBeforeLevelHasLoaded)
+{
+    tr3_room level_room;
+    const std::vector<uint16_t> floor_data;
+    testing::StrictMock<MockLevel> loading_level;
+    EXPECT_CALL(loading_level, get_version)
+        .WillRepeatedly(Return(LevelVersion::Tomb2));
+    EXPECT_CALL(loading_level, floor_data())
+        .WillRepeatedly(ReturnRef(floor_data));
+    EXPECT_CALL(loading_level, num_rooms())
+        .WillRepeatedly(Return(2));
+    EXPECT_CALL(loading_level, room)
+        .WillRepeatedly(ReturnRef(level_room));
+
+    graphics::Device device;
+    Level level(device, NiceMock<MockShaderStorage>());
+    level.load_rooms(loading_level, { 1 });
+    ASSERT_EQ(2u, level.number_of_rooms());
+    ASSERT_EQ(nullptr, level.room(0));
+    const auto loaded_room = level.room(1);
+    ASSERT_NE(nullptr, loaded_room);
+
+    auto mock_level = std::make_unique<testing::NiceMock<MockLevel>>();
+    EXPECT_CALL(*mock_level, get_version)
+        .WillRepeatedly(Return(LevelVersion::Tomb2));
+    EXPECT_CALL(*mock_level, floor_data())
+        .WillRepeatedly(ReturnRef(floor_data));
+    EXPECT_CALL(*mock_level, num_rooms())
+        .WillRepeatedly(Return(2));
+    EXPECT_CALL(*mock_level, room)
+        .WillRepeatedly(ReturnRef(level_room));
+
+    level.finish_loading(device, std::move(mock_level), NiceMock<MockTypeNameLookup>());
+    ASSERT_NE(nullptr, level.room(0));
+    ASSERT_EQ(loaded_room, level.room(1));
+    ASSERT_TRUE(level.room(0)->geometry_generated());
+
+    level.generate_pending_rooms(device, std::chrono::milliseconds::zero());
+    ASSERT_TRUE(level.room(1)->geometry_generated());
+    ASSERT_FALSE(level.rooms_pending());
+}
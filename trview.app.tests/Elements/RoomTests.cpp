@@ -0,0 +1,478 @@
+#include <trview.app/Elements/Level.h>
+#include <trview.app/Elements/ITypeNameLookup.h>
+#include <trview.app/Geometry/Triangle.h>
+#include <random>
+
+using namespace trview;
+using namespace trview::graphics;
+using namespace trlevel;
+using namespace DirectX::SimpleMath;
+using testing::_;
+using testing::NiceMock;
+using testing::Return;
+using testing::ReturnRef;
+using testing::SetArgReferee;
+
+namespace
+{
+    class MockShaderStorage : public IShaderStorage
+    {
+    public:
+        MOCK_METHOD(void, add, (const std::string&, std::unique_ptr<IShader>), (override));
+        MOCK_METHOD(IShader*, get, (const std::string&), (const, override));
+    };
+
+    class MockLevel : public ILevel
+    {
+    public:
+        MOCK_METHOD(tr_colour, get_palette_entry8, (uint32_t), (const, override));
+        MOCK_METHOD(tr_colour4, get_palette_entry_16, (uint32_t), (const, override));
+        MOCK_METHOD(tr_colour4, get_palette_entry, (uint32_t), (const, override));
+        MOCK_METHOD(tr_colour4, get_palette_entry, (uint32_t, uint32_t), (const, override));
+        MOCK_METHOD(uint32_t, num_textiles, (), (const, override));
+        MOCK_METHOD(tr_textile8, get_textile8, (uint32_t), (const, override));
+        MOCK_METHOD(tr_textile16, get_textile16, (uint32_t), (const, override));
+        MOCK_METHOD(std::vector<uint32_t>, get_textile, (uint32_t), (const, override));
+        MOCK_METHOD(void, get_textile, (uint32_t, std::vector<uint32_t>&), (const, override));
+        MOCK_METHOD(uint32_t, num_rooms, (), (const, override));
+        MOCK_METHOD(tr3_room, get_room, (uint32_t), (const, override));
+        MOCK_METHOD(const tr3_room&, room, (uint32_t), (const, override));
+        MOCK_METHOD(uint32_t, num_object_textures, (), (const, override));
+        MOCK_METHOD(tr_object_texture, get_object_texture, (uint32_t), (const, override));
+        MOCK_METHOD(uint32_t, num_floor_data, (), (const, override));
+        MOCK_METHOD(uint16_t, get_floor_data, (uint32_t), (const, override));
+        MOCK_METHOD(std::vector<uint16_t>, get_floor_data_all, (), (const, override));
+        MOCK_METHOD(const std::vector<uint16_t>&, floor_data, (), (const, override));
+        MOCK_METHOD(uint32_t, num_entities, (), (const, override));
+        MOCK_METHOD(tr2_entity, get_entity, (uint32_t), (const, override));
+        MOCK_METHOD(uint32_t, num_models, (), (const, override));
+        MOCK_METHOD(tr_model, get_model, (uint32_t), (const, override));
+        MOCK_METHOD(bool, get_model_by_id, (uint32_t, tr_model&), (const, override));
+        MOCK_METHOD(uint32_t, num_static_meshes, (), (const, override));
+        MOCK_METHOD(tr_staticmesh, get_static_mesh, (uint32_t), (const, override));
+        MOCK_METHOD(uint32_t, num_mesh_pointers, (), (const, override));
+        MOCK_METHOD(tr_mesh, get_mesh_by_pointer, (uint32_t), (const, override));
+        MOCK_METHOD(const tr_mesh&, mesh, (uint32_t), (const, override));
+        MOCK_METHOD(std::vector<tr_meshtree_node>, get_meshtree, (uint32_t, uint32_t), (const, override));
+        MOCK_METHOD(Span<tr_meshtree_node>, meshtree, (uint32_t, uint32_t), (const, override));
+        MOCK_METHOD(tr2_frame, get_frame, (uint32_t, uint32_t), (const, override));
+        MOCK_METHOD(void, get_frame, (uint32_t, uint32_t, tr2_frame&), (const, override));
+        MOCK_METHOD(Span<tr4_animation>, animations, (), (const, override));
+        MOCK_METHOD(Span<tr_state_change>, state_changes, (), (const, override));
+        MOCK_METHOD(Span<tr_anim_dispatch>, anim_dispatches, (), (const, override));
+        MOCK_METHOD(Span<tr_anim_command>, anim_commands, (), (const, override));
+        MOCK_METHOD(uint32_t, num_model_frames, (uint32_t), (const, override));
+        MOCK_METHOD(void, get_world_transforms, (Span<PoseInstance>, std::vector<DirectX::SimpleMath::Matrix>&), (const, override));
+        MOCK_METHOD(uint32_t, num_sound_samples, (), (const, override));
+        MOCK_METHOD(std::vector<uint8_t>, get_sound_sample, (uint32_t), (const, override));
+        MOCK_METHOD(LevelVersion, get_version, (), (const, override));
+        MOCK_METHOD(bool, get_sprite_sequence_by_id, (int32_t, tr_sprite_sequence&), (const, override));
+        MOCK_METHOD(tr_sprite_texture, get_sprite_texture, (uint32_t), (const, override));
+        MOCK_METHOD(bool, find_first_entity_by_type, (int16_t, tr2_entity&), (const, override));
+        MOCK_METHOD(Span<uint32_t>, entities_by_type, (int16_t), (const, override));
+        MOCK_METHOD(int16_t, get_mesh_from_type_id, (int16_t), (const, override));
+        MOCK_METHOD(void, trim, (const LoadOptions&), (override));
+        MOCK_METHOD(std::size_t, memory_usage, (), (const, override));
+    };
+
+    class MockTypeNameLookup : public ITypeNameLookup
+    {
+    public:
+        MOCK_METHOD(std::wstring, lookup_type_name, (LevelVersion, uint32_t), (const, override));
+    };
+
+    /// Object texture 0 is opaque and object texture 1 is transparent.
+    const uint16_t Opaque = 0;
+    const uint16_t Transparent = 1;
+
+    using Face3 = std::array<Vector3, 3>;
+    using Face4 = std::array<Vector3, 4>;
+
+    /// Create a room with walls around the edge and a floor at height 0 everywhere else.
+    tr3_room create_room(uint16_t width, uint16_t depth)
+    {
+        tr3_room room{};
+        room.info.yTop = -4096;
+        room.info.yBottom = 4096;
+        room.num_x_sectors = width;
+        room.num_z_sectors = depth;
+        room.alternate_room = -1;
+        for (uint16_t x = 0; x < width; ++x)
+        {
+            for (uint16_t z = 0; z < depth; ++z)
+            {
+                tr_room_sector sector{};
+                sector.box_index = 0xffff;
+                sector.room_below = 0xff;
+                sector.room_above = 0xff;
+                const bool wall = x == 0 || z == 0 || x == width - 1 || z == depth - 1;
+                sector.floor = wall ? -127 : 0;
+                sector.ceiling = wall ? -127 : -16;
+                room.sector_list.push_back(sector);
+            }
+        }
+        return room;
+    }
+
+    tr_room_sector& sector(tr3_room& room, uint16_t x, uint16_t z)
+    {
+        return room.sector_list[x * room.num_z_sectors + z];
+    }
+
+    /// Get the height of the floor of a sector in the same units as the geometry.
+    float floor_height(const tr3_room& room, uint16_t x, uint16_t z)
+    {
+        return room.sector_list[x * room.num_z_sectors + z].floor * 0.25f;
+    }
+
+    /// Add a vertex to the room. Positions are in sectors, like the geometry of a generated room.
+    uint16_t add_vertex(tr3_room& room, const Vector3& position)
+    {
+        tr3_room_vertex vertex{};
+        vertex.vertex = { static_cast<int16_t>(position.x * 1024), static_cast<int16_t>(position.y * 1024), static_cast<int16_t>(position.z * 1024) };
+        room.data.vertices.push_back(vertex);
+        return static_cast<uint16_t>(room.data.vertices.size() - 1);
+    }
+
+    void add_rectangle(tr3_room& room, const Face4& corners, uint16_t texture)
+    {
+        tr4_mesh_face4 rectangle{};
+        for (int i = 0; i < 4; ++i)
+        {
+            rectangle.vertices[i] = add_vertex(room, corners[i]);
+        }
+        rectangle.texture = texture;
+        room.data.rectangles.push_back(rectangle);
+    }
+
+    void add_triangle(tr3_room& room, const Face3& corners, uint16_t texture)
+    {
+        tr4_mesh_face3 triangle{};
+        for (int i = 0; i < 3; ++i)
+        {
+            triangle.vertices[i] = add_vertex(room, corners[i]);
+        }
+        triangle.texture = texture;
+        room.data.triangles.push_back(triangle);
+    }
+
+    /// Get the corners of a rectangle across a number of sectors from a sector. The rectangle can only be hit
+    /// by a ray from above when it faces up.
+    Face4 floor_rectangle(float x, float z, float y, bool facing_up, float width = 1.0f)
+    {
+        if (facing_up)
+        {
+            return { Vector3(x, y, z), Vector3(x, y, z + 1), Vector3(x + width, y, z + 1), Vector3(x + width, y, z) };
+        }
+        return { Vector3(x, y, z), Vector3(x + width, y, z), Vector3(x + width, y, z + 1), Vector3(x, y, z + 1) };
+    }
+
+    /// Wind a triangle so that it faces up or down, using the same winding as the collision triangles.
+    Face3 facing(Face3 triangle, bool facing_up)
+    {
+        const Triangle collision(triangle[0], triangle[1], triangle[2]);
+        if ((collision.normal.y < 0) != facing_up)
+        {
+            std::swap(triangle[1], triangle[2]);
+        }
+        return triangle;
+    }
+
+    /// Get the triangles that the textured faces of the room are split into.
+    std::vector<Face3> room_triangles(const tr3_room& room, bool transparent)
+    {
+        const auto vertex = [&](uint16_t index) { return convert_vertex(room.data.vertices[index].vertex); };
+        std::vector<Face3> triangles;
+        for (const auto& r : room.data.rectangles)
+        {
+            if ((r.texture == Transparent) == transparent)
+            {
+                triangles.push_back({ vertex(r.vertices[0]), vertex(r.vertices[1]), vertex(r.vertices[2]) });
+                triangles.push_back({ vertex(r.vertices[2]), vertex(r.vertices[3]), vertex(r.vertices[0]) });
+            }
+        }
+        for (const auto& t : room.data.triangles)
+        {
+            if ((t.texture == Transparent) == transparent)
+            {
+                triangles.push_back({ vertex(t.vertices[0]), vertex(t.vertices[1]), vertex(t.vertices[2]) });
+            }
+        }
+        return triangles;
+    }
+
+    /// Whether a sector triangle is covered by the room geometry, checked the way it was before the faces were put
+    /// in a grid: every point has to be one of the points of a rectangle, triangle or transparent triangle in the room.
+    bool geometry_matched_linear(const tr3_room& room, const Face3& triangle)
+    {
+        const auto vertex = [&](uint16_t index) { return convert_vertex(room.data.vertices[index].vertex); };
+        const auto contained = [&](const std::vector<Vector3>& face)
+        {
+            return std::all_of(triangle.begin(), triangle.end(),
+                [&](const auto& point) { return std::find(face.begin(), face.end(), point) != face.end(); });
+        };
+
+        for (const auto& r : room.data.rectangles)
+        {
+            if (contained({ vertex(r.vertices[0]), vertex(r.vertices[1]), vertex(r.vertices[2]), vertex(r.vertices[3]) }))
+            {
+                return true;
+            }
+        }
+
+        for (const auto& t : room.data.triangles)
+        {
+            if (contained({ vertex(t.vertices[0]), vertex(t.vertices[1]), vertex(t.vertices[2]) }))
+            {
+                return true;
+            }
+        }
+
+        for (const auto& t : room_triangles(room, true))
+        {
+            if (contained({ t.begin(), t.end() }))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Whether a transparent triangle is on the floor of a sector, checked the way it was before the sector was
+    /// looked up from the position of the triangle: every floor sector in the room is tried.
+    bool on_floor_linear(const Room& room, const Face3& triangle)
+    {
+        for (const auto& sector : room.sectors())
+        {
+            if (!sector->is_floor())
+            {
+                continue;
+            }
+
+            const float x = sector->x() + 0.5f;
+            const float z = sector->z() + 0.5f;
+            const auto corners = sector->corners();
+            const std::vector<Vector3> sector_corners
+            {
+                { x + 0.5f, corners[2], z - 0.5f },
+                { x - 0.5f, corners[1], z + 0.5f },
+                { x + 0.5f, corners[3], z + 0.5f },
+                { x - 0.5f, corners[0], z - 0.5f }
+            };
+
+            if (std::all_of(triangle.begin(), triangle.end(),
+                [&](const auto& point) { return std::find(sector_corners.begin(), sector_corners.end(), point) != sector_corners.end(); }))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Whether a ray at the front of a triangle hits that triangle. Transparent triangles are only in the room
+    /// mesh as collision triangles when they are on the floor.
+    bool has_collision(const Room& room, const Face3& triangle)
+    {
+        Vector3 normal = Triangle(triangle[0], triangle[1], triangle[2]).normal;
+        normal.Normalize();
+        const Vector3 centre = (triangle[0] + triangle[1] + triangle[2]) / 3.0f;
+        const auto result = room.pick(centre + normal * 2.0f, -normal, false, false);
+        return result.hit && std::abs(result.distance - 2.0f) < 0.001f;
+    }
+
+    /// Load a level that has only the room in it and generate the geometry for the room.
+    std::unique_ptr<Level> load_level(const graphics::Device& device, const tr3_room& room, const std::vector<uint16_t>& floor_data)
+    {
+        tr_object_texture opaque{};
+        tr_object_texture transparent{};
+        transparent.Attribute = 1;
+
+        auto mock_level = std::make_unique<NiceMock<MockLevel>>();
+        EXPECT_CALL(*mock_level, get_version)
+            .WillRepeatedly(Return(LevelVersion::Tomb2));
+        EXPECT_CALL(*mock_level, floor_data())
+            .WillRepeatedly(ReturnRef(floor_data));
+        EXPECT_CALL(*mock_level, num_rooms())
+            .WillRepeatedly(Return(1));
+        EXPECT_CALL(*mock_level, room(0))
+            .WillRepeatedly(ReturnRef(room));
+        EXPECT_CALL(*mock_level, num_textiles())
+            .WillRepeatedly(Return(1));
+        EXPECT_CALL(*mock_level, get_textile(_, _))
+            .WillRepeatedly(SetArgReferee<1>(std::vector<uint32_t>(256 * 256, 0xffffffff)));
+        EXPECT_CALL(*mock_level, num_object_textures())
+            .WillRepeatedly(Return(2));
+        EXPECT_CALL(*mock_level, get_object_texture(Opaque))
+            .WillRepeatedly(Return(opaque));
+        EXPECT_CALL(*mock_level, get_object_texture(Transparent))
+            .WillRepeatedly(Return(transparent));
+
+        auto level = std::make_unique<Level>(device, NiceMock<MockShaderStorage>(), std::move(mock_level), NiceMock<MockTypeNameLookup>());
+        while (level->rooms_pending())
+        {
+            level->generate_pending_rooms(device, std::chrono::milliseconds(100));
+        }
+        return level;
+    }
+
+    /// Check that the transparent triangles that can be picked are the ones that the old linear search puts on the floor.
+    /// @returns The number of transparent triangles that are on the floor.
+    uint32_t check_transparent_collision(const graphics::Device& device, const tr3_room& room)
+    {
+        const std::vector<uint16_t> floor_data;
+        const auto level = load_level(device, room, floor_data);
+        const auto& level_room = *level->room(0);
+
+        uint32_t on_floor = 0;
+        for (const auto& triangle : room_triangles(room, true))
+        {
+            const bool expected = on_floor_linear(level_room, triangle);
+            EXPECT_EQ(expected, has_collision(level_room, triangle))
+                << "Triangle " << triangle[0].x << "," << triangle[0].y << "," << triangle[0].z << " "
+                << triangle[1].x << "," << triangle[1].y << "," << triangle[1].z << " "
+                << triangle[2].x << "," << triangle[2].y << "," << triangle[2].z;
+            on_floor += expected;
+        }
+        return on_floor;
+    }
+}
+
+// Tests that the floor triangles that are shown as unmatched geometry are the same ones that checking every face
+// in the room finds. Every face faces down so that a ray from above only hits the unmatched geometry.
+TEST(Room, UnmatchedGeometryMatchesLinearSearch)
+{
+    graphics::Device device;
+    const std::vector<uint16_t> floor_data;
+
+    for (uint32_t seed = 0; seed < 4; ++seed)
+    {
+        std::mt19937 random(seed);
+        auto room = create_room(8, 7);
+        const int8_t heights[] = { 0, 0, 4, -4 };
+        for (uint16_t x = 1; x < 7; ++x)
+        {
+            for (uint16_t z = 1; z < 6; ++z)
+            {
+                sector(room, x, z).floor = heights[random() % 4];
+            }
+        }
+
+        for (uint16_t x = 1; x < 7; ++x)
+        {
+            for (uint16_t z = 1; z < 6; ++z)
+            {
+                const float y = floor_height(room, x, z);
+                const auto corners = floor_rectangle(x, z, y, false);
+                switch (random() % 6)
+                {
+                case 0:
+                    add_rectangle(room, corners, Opaque);
+                    break;
+                case 1:
+                    add_rectangle(room, corners, Transparent);
+                    break;
+                case 2:
+                {
+                    // Any three corners of the sector, which may not be one of the triangles the floor is split into.
+                    const uint32_t skip = random() % 4;
+                    Face3 triangle;
+                    for (uint32_t i = 0, j = 0; i < 4; ++i)
+                    {
+                        if (i != skip)
+                        {
+                            triangle[j++] = corners[i];
+                        }
+                    }
+                    add_triangle(room, facing(triangle, false), random() % 2 ? Opaque : Transparent);
+                    break;
+                }
+                case 3:
+                    add_rectangle(room, floor_rectangle(x, z, y - 0.5f, false), Opaque);
+                    break;
+                case 4:
+                    add_rectangle(room, floor_rectangle(x, z, y, false, 2.0f), Opaque);
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
+
+        const auto level = load_level(device, room, floor_data);
+        const auto& level_room = *level->room(0);
+
+        uint32_t unmatched = 0;
+        for (const auto& sector : level_room.sectors())
+        {
+            if (!sector->is_floor())
+            {
+                continue;
+            }
+
+            const auto triangles = sector->triangles();
+            for (int i = 0; i < 2; ++i)
+            {
+                const Face3 triangle{ triangles[i * 3], triangles[i * 3 + 1], triangles[i * 3 + 2] };
+                const bool expected = !geometry_matched_linear(room, triangle);
+                const Vector3 centre = (triangle[0] + triangle[1] + triangle[2]) / 3.0f;
+                const auto result = level_room.pick(centre - Vector3(0, 10, 0), Vector3(0, 1, 0), false, false, true);
+                ASSERT_EQ(expected, result.hit) << "Seed " << seed << ", sector " << sector->x() << "," << sector->z() << ", triangle " << i;
+                unmatched += expected;
+            }
+        }
+
+        // The room should have a mix of matched and unmatched triangles for the test to mean anything.
+        ASSERT_GT(unmatched, 0u);
+        ASSERT_LT(unmatched, 60u);
+    }
+}
+
+// Tests that transparent triangles in sectors away from the edges of the room are found on the floor the same way as
+// checking every sector. The sector in the middle is raised so that its corners are not shared with its neighbours.
+TEST(Room, TransparentCollisionInteriorSectors)
+{
+    auto room = create_room(5, 5);
+    sector(room, 2, 2).floor = -4;
+
+    // On the raised floor.
+    add_rectangle(room, floor_rectangle(2, 2, -1.0f, true), Transparent);
+    // Above the floor.
+    add_rectangle(room, floor_rectangle(1, 2, -0.5f, true), Transparent);
+    // The other way of splitting the sector into triangles.
+    add_triangle(room, facing({ Vector3(2, 0, 1), Vector3(3, 0, 1), Vector3(3, 0, 2) }, true), Transparent);
+    add_triangle(room, facing({ Vector3(1, 0, 3), Vector3(2, 0, 4), Vector3(1, 0, 4) }, true), Transparent);
+    // One point in the middle of an edge.
+    add_triangle(room, facing({ Vector3(3, 0, 3), Vector3(4, 0, 3), Vector3(3.5f, 0, 4) }, true), Transparent);
+
+    graphics::Device device;
+    ASSERT_EQ(4u, check_transparent_collision(device, room));
+}
+
+// Tests that transparent triangles on the edges of sectors and of the room are found on the floor the same way as
+// checking every sector. The triangles against the walls have their centre on the edge between two sectors, so
+// the sectors on both sides are looked at, and the ones on the edge of the room look outside of it. A triangle
+// that lies flat along an edge has no area and can't be picked, so walls are used for these instead.
+TEST(Room, TransparentCollisionBoundarySectors)
+{
+    auto room = create_room(6, 5);
+    sector(room, 3, 2).floor = -4;
+
+    // In the corners of the room, next to two walls.
+    add_rectangle(room, floor_rectangle(1, 1, 0.0f, true), Transparent);
+    add_rectangle(room, floor_rectangle(4, 3, 0.0f, true), Transparent);
+    // On the raised sector, which shares no corners with its neighbours.
+    add_triangle(room, facing({ Vector3(3, -1, 2), Vector3(4, -1, 2), Vector3(4, -1, 3) }, true), Transparent);
+    // Shares two corners with the sector in front of it.
+    add_triangle(room, facing({ Vector3(2, 0, 3), Vector3(3, 0, 3), Vector3(3, 0, 4) }, true), Transparent);
+    // Flat on the floor across two sectors.
+    add_triangle(room, facing({ Vector3(1, 0, 2), Vector3(3, 0, 2), Vector3(1, 0, 3) }, true), Transparent);
+    // On the step up to the raised sector, using corners of the sectors on both sides.
+    add_triangle(room, { Vector3(3, 0, 2), Vector3(3, 0, 3), Vector3(3, -1, 2) }, Transparent);
+    // Against the wall between a wall sector and a floor sector.
+    add_triangle(room, { Vector3(1, 0, 1), Vector3(1, 0, 2), Vector3(1, -1, 1) }, Transparent);
+    // On the outside edge of the room.
+    add_triangle(room, { Vector3(0, 0, 1), Vector3(0, 0, 2), Vector3(0, -1, 1) }, Transparent);
+
+    graphics::Device device;
+    ASSERT_EQ(6u, check_transparent_collision(device, room));
+}
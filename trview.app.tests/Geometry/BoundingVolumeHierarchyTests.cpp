@@ -0,0 +1,97 @@
+#include <trview.app/Geometry/BoundingVolumeHierarchy.h>
+
+using namespace trview;
+using namespace DirectX::SimpleMath;
+
+namespace
+{
+    /// A row of unit boxes along the Z axis, starting at z = 1.
+    std::vector<BoundingVolumeHierarchy::Bounds> row_of_boxes(uint32_t count)
+    {
+        std::vector<BoundingVolumeHierarchy::Bounds> boxes(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            boxes[i].add(Vector3(0, 0, static_cast<float>(i + 1)));
+            boxes[i].add(Vector3(1, 1, static_cast<float>(i + 2)));
+        }
+        return boxes;
+    }
+
+    std::vector<uint32_t> visited(const BoundingVolumeHierarchy& hierarchy, const Vector3& position, const Vector3& direction, float nearest)
+    {
+        std::vector<uint32_t> items;
+        hierarchy.traverse(position, direction, nearest, [&](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                items.push_back(hierarchy.order()[i]);
+            }
+        });
+        return items;
+    }
+}
+
+// Tests that an empty hierarchy visits nothing.
+TEST(BoundingVolumeHierarchy, EmptyVisitsNothing)
+{
+    BoundingVolumeHierarchy hierarchy;
+    ASSERT_TRUE(visited(hierarchy, Vector3::Zero, Vector3::UnitZ, FLT_MAX).empty());
+}
+
+// Tests that every item is in the order exactly once.
+TEST(BoundingVolumeHierarchy, OrderContainsEveryItem)
+{
+    BoundingVolumeHierarchy hierarchy(row_of_boxes(100), 2);
+    auto order = hierarchy.order();
+    std::sort(order.begin(), order.end());
+    ASSERT_EQ(100u, order.size());
+    for (uint32_t i = 0; i < order.size(); ++i)
+    {
+        ASSERT_EQ(i, order[i]);
+    }
+}
+
+// Tests that the leaves are visited nearest first.
+TEST(BoundingVolumeHierarchy, VisitsNearestFirst)
+{
+    BoundingVolumeHierarchy hierarchy(row_of_boxes(64), 1);
+    const auto forwards = visited(hierarchy, Vector3(0.5f, 0.5f, 0.0f), Vector3::UnitZ, FLT_MAX);
+    ASSERT_EQ(64u, forwards.size());
+    ASSERT_TRUE(std::is_sorted(forwards.begin(), forwards.end()));
+
+    const auto backwards = visited(hierarchy, Vector3(0.5f, 0.5f, 100.0f), -Vector3::UnitZ, FLT_MAX);
+    ASSERT_EQ(64u, backwards.size());
+    ASSERT_TRUE(std::is_sorted(backwards.rbegin(), backwards.rend()));
+}
+
+// Tests that leaves beyond the nearest distance are not visited.
+TEST(BoundingVolumeHierarchy, SkipsLeavesBeyondNearest)
+{
+    BoundingVolumeHierarchy hierarchy(row_of_boxes(64), 1);
+    const auto items = visited(hierarchy, Vector3(0.5f, 0.5f, 0.0f), Vector3::UnitZ, 10.5f);
+    ASSERT_EQ(10u, items.size());
+}
+
+// Tests that the visitor can stop traversal by lowering the nearest distance.
+TEST(BoundingVolumeHierarchy, VisitorLowersNearest)
+{
+    BoundingVolumeHierarchy hierarchy(row_of_boxes(64), 1);
+    std::vector<uint32_t> items;
+    float nearest = FLT_MAX;
+    hierarchy.traverse(Vector3(0.5f, 0.5f, 0.0f), Vector3::UnitZ, nearest, [&](uint32_t begin, uint32_t end)
+    {
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            items.push_back(hierarchy.order()[i]);
+            nearest = 1.5f;
+        }
+    });
+    ASSERT_EQ(std::vector<uint32_t>{ 0u }, items);
+}
+
+// Tests that boxes that the ray misses are not visited.
+TEST(BoundingVolumeHierarchy, MissVisitsNothing)
+{
+    BoundingVolumeHierarchy hierarchy(row_of_boxes(64), 1);
+    ASSERT_TRUE(visited(hierarchy, Vector3(5.0f, 0.5f, 0.0f), Vector3::UnitZ, FLT_MAX).empty());
+}
@@ -0,0 +1,215 @@
+#include <trview.app/Geometry/CollisionTriangles.h>
+#include <random>
+
+using namespace trview;
+using namespace DirectX::SimpleMath;
+
+namespace
+{
+    /// Triangles facing down the Z axis, one unit apart along the Z axis starting at Z = 1.
+    std::vector<Triangle> stacked_triangles(uint32_t count)
+    {
+        std::vector<Triangle> triangles;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const float z = static_cast<float>(i + 1);
+            triangles.emplace_back(Vector3(-1, -1, z), Vector3(1, -1, z), Vector3(-1, 1, z));
+        }
+        return triangles;
+    }
+
+    /// Random triangles in a box around the origin, with both windings.
+    std::vector<Triangle> random_triangles(uint32_t count, std::mt19937& random)
+    {
+        std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+        std::uniform_real_distribution<float> offset(-2.0f, 2.0f);
+        std::vector<Triangle> triangles;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const Vector3 v0(position(random), position(random), position(random));
+            triangles.emplace_back(v0,
+                v0 + Vector3(offset(random), offset(random), offset(random)),
+                v0 + Vector3(offset(random), offset(random), offset(random)));
+        }
+        return triangles;
+    }
+
+    /// Test every triangle in a range one at a time, in double precision. A triangle faces the ray when the ray
+    /// is against its normal.
+    bool brute_force(const std::vector<Triangle>& triangles, const Vector3& position, const Vector3& direction,
+        std::size_t begin, std::size_t end, double& distance)
+    {
+        bool hit = false;
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const auto& triangle = triangles[i];
+            const double normal[3] = { triangle.normal.x, triangle.normal.y, triangle.normal.z };
+            const double facing = normal[0] * direction.x + normal[1] * direction.y + normal[2] * direction.z;
+            if (!(facing < 0.0))
+            {
+                continue;
+            }
+
+            // Find where the ray meets the plane of the triangle and then check that the point is inside each edge.
+            const double t = (normal[0] * (triangle.v0.x - position.x) + normal[1] * (triangle.v0.y - position.y) + normal[2] * (triangle.v0.z - position.z)) / facing;
+            if (t < 0.0 || t >= distance)
+            {
+                continue;
+            }
+
+            const double point[3] = { position.x + direction.x * t, position.y + direction.y * t, position.z + direction.z * t };
+            const Vector3 vertices[3] = { triangle.v0, triangle.v1, triangle.v2 };
+            bool inside = true;
+            for (int e = 0; e < 3 && inside; ++e)
+            {
+                const auto& a = vertices[e];
+                const auto& b = vertices[(e + 1) % 3];
+                const double edge[3] = { b.x - a.x, b.y - a.y, b.z - a.z };
+                const double to_point[3] = { point[0] - a.x, point[1] - a.y, point[2] - a.z };
+                const double cross[3] =
+                {
+                    edge[1] * to_point[2] - edge[2] * to_point[1],
+                    edge[2] * to_point[0] - edge[0] * to_point[2],
+                    edge[0] * to_point[1] - edge[1] * to_point[0]
+                };
+                inside = cross[0] * normal[0] + cross[1] * normal[1] + cross[2] * normal[2] <= 0.0;
+            }
+
+            if (inside)
+            {
+                distance = t;
+                hit = true;
+            }
+        }
+        return hit;
+    }
+
+    /// Puts the collision triangles back to the default path when a test finishes.
+    struct ForcedPath
+    {
+        ~ForcedPath()
+        {
+            force_collision_triangles_path(CollisionTrianglesPath::Default);
+        }
+    };
+}
+
+// Tests that the nearest hit is returned from a range larger than one batch.
+TEST(CollisionTriangles, ReturnsNearestHit)
+{
+    CollisionTriangles triangles(stacked_triangles(20));
+    float distance = FLT_MAX;
+    ASSERT_TRUE(triangles.intersects(Vector3(-0.5f, -0.5f, 0), Vector3::UnitZ, 0, triangles.size(), distance));
+    ASSERT_FLOAT_EQ(1.0f, distance);
+}
+
+// Tests that only triangles in the range are tested.
+TEST(CollisionTriangles, OnlyTestsRange)
+{
+    CollisionTriangles triangles(stacked_triangles(20));
+    float distance = FLT_MAX;
+    ASSERT_TRUE(triangles.intersects(Vector3(-0.5f, -0.5f, 0), Vector3::UnitZ, 5, 7, distance));
+    ASSERT_FLOAT_EQ(6.0f, distance);
+}
+
+// Tests that hits further than the distance passed in are ignored.
+TEST(CollisionTriangles, IgnoresFurtherHits)
+{
+    CollisionTriangles triangles(stacked_triangles(3));
+    float distance = 0.5f;
+    ASSERT_FALSE(triangles.intersects(Vector3(-0.5f, -0.5f, 0), Vector3::UnitZ, 0, triangles.size(), distance));
+    ASSERT_FLOAT_EQ(0.5f, distance);
+}
+
+// Tests that triangles facing away from the ray are not hit.
+TEST(CollisionTriangles, BackFacesAreNotHit)
+{
+    CollisionTriangles triangles(stacked_triangles(3));
+    float distance = FLT_MAX;
+    ASSERT_FALSE(triangles.intersects(Vector3(-0.5f, -0.5f, 10), -Vector3::UnitZ, 0, triangles.size(), distance));
+}
+
+// Tests that the scalar path can always be used.
+TEST(CollisionTriangles, ScalarPathIsAvailable)
+{
+    ForcedPath forced;
+    ASSERT_TRUE(force_collision_triangles_path(CollisionTrianglesPath::Scalar));
+    ASSERT_FALSE(collision_triangles_use_avx2());
+
+    CollisionTriangles triangles(stacked_triangles(20));
+    float distance = FLT_MAX;
+    ASSERT_TRUE(triangles.intersects(Vector3(-0.5f, -0.5f, 0), Vector3::UnitZ, 5, 7, distance));
+    ASSERT_FLOAT_EQ(6.0f, distance);
+}
+
+// Tests that the scalar, SSE2 and AVX2 paths find the same hits as testing each triangle on its own. Paths that
+// this machine can't use are skipped.
+TEST(CollisionTriangles, PathsMatchBruteForce)
+{
+    std::mt19937 random(1234);
+    const auto source = random_triangles(200, random);
+    const CollisionTriangles triangles(source);
+
+    // Aim most of the rays at a triangle so that there are plenty of hits, and use ranges that start and end
+    // part way through a batch.
+    std::uniform_real_distribution<float> position(-15.0f, 15.0f);
+    std::uniform_int_distribution<std::size_t> index(0, source.size() - 1);
+    struct Ray
+    {
+        Vector3 position;
+        Vector3 direction;
+        std::size_t begin;
+        std::size_t end;
+    };
+    std::vector<Ray> rays;
+    for (uint32_t i = 0; i < 500; ++i)
+    {
+        const auto& target = source[index(random)];
+        const Vector3 origin(position(random), position(random), position(random));
+        Vector3 direction = (i % 4 == 0) ?
+            Vector3(position(random), position(random), position(random)) :
+            (target.v0 + target.v1 + target.v2) / 3.0f - origin;
+        direction.Normalize();
+
+        std::size_t begin = index(random);
+        std::size_t end = index(random);
+        if (begin > end)
+        {
+            std::swap(begin, end);
+        }
+        rays.push_back({ origin, direction, i % 2 ? 0 : begin, i % 2 ? source.size() : end + 1 });
+    }
+
+    std::vector<bool> expected_hits;
+    std::vector<double> expected_distances;
+    uint32_t hits = 0;
+    for (const auto& ray : rays)
+    {
+        double distance = DBL_MAX;
+        expected_hits.push_back(brute_force(source, ray.position, ray.direction, ray.begin, ray.end, distance));
+        expected_distances.push_back(distance);
+        hits += expected_hits.back();
+    }
+    ASSERT_GT(hits, rays.size() / 4);
+
+    ForcedPath forced;
+    for (const auto path : { CollisionTrianglesPath::Scalar, CollisionTrianglesPath::Sse2, CollisionTrianglesPath::Avx2 })
+    {
+        if (!force_collision_triangles_path(path))
+        {
+            continue;
+        }
+
+        SCOPED_TRACE(static_cast<int>(path));
+        ASSERT_EQ(path == CollisionTrianglesPath::Avx2, collision_triangles_use_avx2());
+        for (std::size_t i = 0; i < rays.size(); ++i)
+        {
+            float distance = FLT_MAX;
+            ASSERT_EQ(expected_hits[i], triangles.intersects(rays[i].position, rays[i].direction, rays[i].begin, rays[i].end, distance)) << "Ray " << i;
+            if (expected_hits[i])
+            {
+                ASSERT_NEAR(expected_distances[i], distance, 1e-3);
+            }
+        }
+    }
+}
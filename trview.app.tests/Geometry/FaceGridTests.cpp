@@ -0,0 +1,122 @@
+#include <trview.app/Geometry/FaceGrid.h>
+#include <random>
+
+using namespace trview;
+using namespace DirectX::SimpleMath;
+
+namespace
+{
+    /// The matching that Room used before the grid - every face is checked.
+    bool contained_in_any_face(const Vector3* triangle, const std::vector<FaceGrid::Face>& faces)
+    {
+        for (const auto& face : faces)
+        {
+            const std::vector<Vector3> source(face.vertices.begin(), face.vertices.begin() + face.count);
+            const bool contained = std::find(source.begin(), source.end(), triangle[0]) != source.end() &&
+                std::find(source.begin(), source.end(), triangle[1]) != source.end() &&
+                std::find(source.begin(), source.end(), triangle[2]) != source.end();
+            if (contained)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    FaceGrid::Face rectangle(float x, float z, float size, float height)
+    {
+        return { { Vector3(x, height, z), Vector3(x + size, height, z), Vector3(x + size, height, z + size), Vector3(x, height, z + size) }, 4 };
+    }
+}
+
+// Tests that a sector triangle made from the corners of a rectangle is found.
+TEST(FaceGrid, FindsTriangleInRectangle)
+{
+    FaceGrid grid(4, 4, { rectangle(1, 2, 1, 0) });
+    const Vector3 triangle[3] = { Vector3(2, 0, 3), Vector3(1, 0, 2), Vector3(1, 0, 3) };
+    ASSERT_TRUE(grid.contains_triangle(triangle));
+}
+
+// Tests that a triangle at a different height is not found.
+TEST(FaceGrid, DifferentHeightNotFound)
+{
+    FaceGrid grid(4, 4, { rectangle(1, 2, 1, 0) });
+    const Vector3 triangle[3] = { Vector3(2, 1, 3), Vector3(1, 1, 2), Vector3(1, 1, 3) };
+    ASSERT_FALSE(grid.contains_triangle(triangle));
+}
+
+// Tests that faces that cover more than one sector are found from every sector.
+TEST(FaceGrid, LargeFaceFoundFromEverySector)
+{
+    FaceGrid grid(4, 4, { rectangle(0, 0, 4, 0) });
+    const Vector3 triangle[3] = { Vector3(0, 0, 0), Vector3(4, 0, 0), Vector3(4, 0, 4) };
+    ASSERT_TRUE(grid.contains_triangle(triangle));
+    const Vector3 reversed[3] = { Vector3(4, 0, 4), Vector3(4, 0, 0), Vector3(0, 0, 0) };
+    ASSERT_TRUE(grid.contains_triangle(reversed));
+}
+
+// Tests that faces outside of the room are still found.
+TEST(FaceGrid, FaceOutsideGridFound)
+{
+    FaceGrid grid(2, 2, { rectangle(5, -3, 1, 0) });
+    const Vector3 triangle[3] = { Vector3(6, 0, -2), Vector3(5, 0, -3), Vector3(5, 0, -2) };
+    ASSERT_TRUE(grid.contains_triangle(triangle));
+}
+
+// Tests that the grid gives the same results as checking every face.
+TEST(FaceGrid, MatchesCheckingEveryFace)
+{
+    std::mt19937 random(7);
+    uint32_t found = 0;
+    for (uint32_t room = 0; room < 20; ++room)
+    {
+        const uint32_t width = 1 + random() % 12;
+        const uint32_t depth = 1 + random() % 12;
+        std::uniform_int_distribution<int> height(-2, 2);
+        std::uniform_int_distribution<int> x_position(-2, static_cast<int>(width) + 1);
+        std::uniform_int_distribution<int> z_position(-2, static_cast<int>(depth) + 1);
+
+        std::vector<FaceGrid::Face> faces;
+        for (uint32_t i = 0; i < 200; ++i)
+        {
+            const float x = static_cast<float>(x_position(random));
+            const float z = static_cast<float>(z_position(random));
+            const float y = static_cast<float>(height(random));
+            if (random() % 2)
+            {
+                faces.push_back(rectangle(x, z, static_cast<float>(1 + random() % 3), y));
+            }
+            else
+            {
+                faces.push_back({ { Vector3(x, y, z), Vector3(x + 1, static_cast<float>(height(random)), z), Vector3(x, y, z + 1) }, 3 });
+            }
+        }
+
+        const FaceGrid grid(width, depth, faces);
+        for (uint32_t z = 0; z < depth; ++z)
+        {
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                for (uint32_t i = 0; i < 8; ++i)
+                {
+                    const float fx = static_cast<float>(x);
+                    const float fz = static_cast<float>(z);
+                    const Vector3 corners[4] =
+                    {
+                        Vector3(fx, static_cast<float>(height(random)), fz),
+                        Vector3(fx, static_cast<float>(height(random)), fz + 1),
+                        Vector3(fx + 1, static_cast<float>(height(random)), fz),
+                        Vector3(fx + 1, static_cast<float>(height(random)), fz + 1)
+                    };
+                    const Vector3 triangle[3] = { corners[i % 4], corners[(i + 1) % 4], corners[(i + 2) % 4] };
+                    const bool expected = contained_in_any_face(triangle, faces);
+                    ASSERT_EQ(expected, grid.contains_triangle(triangle));
+                    found += expected;
+                }
+            }
+        }
+    }
+
+    // Make sure that the test isn't only checking triangles that don't match.
+    ASSERT_GT(found, 0u);
+}
@@ -0,0 +1,213 @@
+#include <trview.app/Geometry/PortalVisibility.h>
+
+using namespace trview;
+using namespace DirectX::SimpleMath;
+
+namespace
+{
+    /// A camera at the origin looking down the negative Z axis with a 90 degree field of view. At a distance of
+    /// 5 the screen covers -5 to 5 on the X and Y axes.
+    Matrix view_projection()
+    {
+        return Matrix::CreateLookAt(Vector3(0, 0, 0), Vector3(0, 0, -1), Vector3(0, 1, 0)) *
+            Matrix::CreatePerspectiveFieldOfView(DirectX::XM_PIDIV2, 1.0f, 0.1f, 100.0f);
+    }
+
+    /// A portal across the X/Y plane at a depth. By default the portal faces the camera, which is how portals
+    /// in the rooms that the camera can see into are arranged.
+    Portal portal(uint16_t room, float min_x, float max_x, float z, bool facing_camera = true)
+    {
+        Portal result;
+        result.room = room;
+        result.normal = Vector3(0, 0, facing_camera ? 1.0f : -1.0f);
+        result.vertices = { Vector3(min_x, -1, z), Vector3(max_x, -1, z), Vector3(max_x, 1, z), Vector3(min_x, 1, z) };
+        return result;
+    }
+
+    /// Rooms for the flood to look through. The camera is in room 0.
+    std::vector<PortalRoom> rooms(const std::vector<std::vector<Portal>>& portals)
+    {
+        std::vector<PortalRoom> result(portals.size());
+        for (std::size_t i = 0; i < portals.size(); ++i)
+        {
+            result[i].portals = &portals[i];
+        }
+        result[0].contains_camera = true;
+        return result;
+    }
+
+    std::vector<bool> seen(const std::vector<PortalRoom>& rooms)
+    {
+        return rooms_seen_through_portals(rooms, Vector3(0, 0, 0), view_projection());
+    }
+}
+
+// Tests that adding areas grows the area and that clipping leaves the overlap.
+TEST(PortalVisibility, ScreenRectAddAndClip)
+{
+    ScreenRect rect;
+    ASSERT_TRUE(rect.empty());
+
+    rect.add({ -0.5f, -0.5f, 0.0f, 0.0f });
+    rect.add({ 0.25f, 0.25f, 0.5f, 0.5f });
+    ASSERT_EQ((ScreenRect{ -0.5f, -0.5f, 0.5f, 0.5f }), rect);
+
+    rect.clip({ 0.0f, -1.0f, 1.0f, 0.25f });
+    ASSERT_EQ((ScreenRect{ 0.0f, -0.5f, 0.5f, 0.25f }), rect);
+    ASSERT_FALSE(rect.empty());
+
+    rect.clip({ 0.75f, -1.0f, 1.0f, 1.0f });
+    ASSERT_TRUE(rect.empty());
+}
+
+// Tests that a portal in front of the camera covers the part of the screen that it is drawn on.
+TEST(PortalVisibility, ProjectPortalInFront)
+{
+    const auto rect = project_portal(portal(1, -2.5f, 5.0f, -5.0f), view_projection(), ScreenRect::whole_screen());
+    ASSERT_NEAR(-0.5f, rect.min_x, 1e-4f);
+    ASSERT_NEAR(1.0f, rect.max_x, 1e-4f);
+    ASSERT_NEAR(-0.2f, rect.min_y, 1e-4f);
+    ASSERT_NEAR(0.2f, rect.max_y, 1e-4f);
+}
+
+// Tests that the area of a portal is clipped to the window that it is seen through.
+TEST(PortalVisibility, ProjectPortalClippedToWindow)
+{
+    const auto rect = project_portal(portal(1, -2.5f, 5.0f, -5.0f), view_projection(), { 0.0f, -1.0f, 0.5f, 1.0f });
+    ASSERT_NEAR(0.0f, rect.min_x, 1e-4f);
+    ASSERT_NEAR(0.5f, rect.max_x, 1e-4f);
+}
+
+// Tests that portals behind the camera or off the edge of the screen can't be seen, and that a portal that
+// crosses the plane of the camera could cover all of the window.
+TEST(PortalVisibility, ProjectPortalOutOfView)
+{
+    const auto window = ScreenRect::whole_screen();
+    ASSERT_TRUE(project_portal(portal(1, -1.0f, 1.0f, 5.0f), view_projection(), window).empty());
+    ASSERT_TRUE(project_portal(portal(1, 6.0f, 8.0f, -5.0f), view_projection(), window).empty());
+
+    Portal crossing = portal(1, -1.0f, 1.0f, -5.0f);
+    crossing.vertices[0].z = 5.0f;
+    const ScreenRect small{ -0.25f, -0.25f, 0.25f, 0.25f };
+    ASSERT_EQ(small, project_portal(crossing, view_projection(), small));
+}
+
+// Tests that rooms are seen through a chain of portals, and that a room that no visible portal leads to is not seen.
+TEST(PortalVisibility, FloodsThroughPortals)
+{
+    const std::vector<std::vector<Portal>> portals
+    {
+        { portal(1, -2.0f, 2.0f, -5.0f) },
+        { portal(2, -2.0f, 2.0f, -10.0f) },
+        { },
+        { portal(0, -2.0f, 2.0f, -20.0f) }
+    };
+
+    const auto result = seen(rooms(portals));
+    ASSERT_EQ((std::vector<bool>{ true, true, true, false }), result);
+}
+
+// Tests that a room in view behind a wall is not seen when there is no portal in the way.
+TEST(PortalVisibility, ClosedPortal)
+{
+    const std::vector<std::vector<Portal>> portals
+    {
+        { portal(1, -2.0f, 2.0f, -5.0f) },
+        { },
+        { }
+    };
+
+    // Room 2 is straight in front of the camera, but room 1 has no portal into it.
+    const auto result = seen(rooms(portals));
+    ASSERT_EQ((std::vector<bool>{ true, true, false }), result);
+}
+
+// Tests that portals that face away from the camera are not looked through.
+TEST(PortalVisibility, PortalFacingAwayIsSkipped)
+{
+    const std::vector<std::vector<Portal>> portals
+    {
+        { portal(1, -2.0f, 2.0f, -5.0f, false), portal(2, 2.5f, 4.0f, -5.0f) },
+        { },
+        { }
+    };
+
+    const auto result = seen(rooms(portals));
+    ASSERT_EQ((std::vector<bool>{ true, false, true }), result);
+}
+
+// Tests that a room seen through a portal that is off the edge of the screen is culled.
+TEST(PortalVisibility, PortalOffScreenIsCulled)
+{
+    const std::vector<std::vector<Portal>> portals
+    {
+        { portal(1, 6.0f, 8.0f, -5.0f), portal(2, -1.0f, 1.0f, -5.0f) },
+        { },
+        { }
+    };
+
+    const auto result = seen(rooms(portals));
+    ASSERT_EQ((std::vector<bool>{ true, false, true }), result);
+}
+
+// Tests that a portal on screen that is outside the window it would be seen through is culled.
+TEST(PortalVisibility, PortalOutsideWindowIsCulled)
+{
+    // Room 1 is seen through the left side of the screen. Room 2 is on the right side of the screen
+    // behind room 1, so it can't be seen through the portal into room 1. Room 3 is inside the window.
+    const std::vector<std::vector<Portal>> portals
+    {
+        { portal(1, -4.0f, -1.0f, -5.0f) },
+        { portal(2, 2.0f, 8.0f, -10.0f), portal(3, -6.0f, -4.0f, -10.0f) },
+        { },
+        { }
+    };
+
+    const auto result = seen(rooms(portals));
+    ASSERT_EQ((std::vector<bool>{ true, true, false, true }), result);
+}
+
+// Tests that portals that lead to a room that has been flipped out are followed into the room shown instead.
+TEST(PortalVisibility, FollowsAlternateRoom)
+{
+    const std::vector<std::vector<Portal>> portals
+    {
+        { portal(1, -2.0f, 2.0f, -5.0f) },
+        { },
+        { }
+    };
+
+    auto level_rooms = rooms(portals);
+    level_rooms[1].shown = false;
+    level_rooms[1].shown_instead = 2;
+
+    const auto result = seen(level_rooms);
+    ASSERT_EQ((std::vector<bool>{ true, false, true }), result);
+}
+
+// Tests that portals that lead back to a room that has already been seen don't loop forever.
+TEST(PortalVisibility, PortalLoopsEnd)
+{
+    const std::vector<std::vector<Portal>> portals
+    {
+        { portal(1, -2.0f, 2.0f, -5.0f) },
+        { portal(0, -1.0f, 1.0f, -10.0f) }
+    };
+
+    const auto result = seen(rooms(portals));
+    ASSERT_EQ((std::vector<bool>{ true, true }), result);
+}
+
+// Tests that nothing is culled when the camera is not in any room.
+TEST(PortalVisibility, CameraOutsideLevel)
+{
+    const std::vector<std::vector<Portal>> portals
+    {
+        { portal(1, -2.0f, 2.0f, -5.0f) },
+        { }
+    };
+
+    auto level_rooms = rooms(portals);
+    level_rooms[0].contains_camera = false;
+    ASSERT_TRUE(seen(level_rooms).empty());
+}
@@ -0,0 +1,140 @@
+#include <trview.app/Geometry/TriangleBVH.h>
+#include <trlevel/DataReader.h>
+#include <trlevel/DataWriter.h>
+
+using namespace trview;
+using namespace DirectX::SimpleMath;
+
+namespace
+{
+    /// A square facing down the Z axis at the specified depth, made of two triangles.
+    void add_square(std::vector<Triangle>& triangles, float x, float y, float z)
+    {
+        triangles.emplace_back(Vector3(x, y, z), Vector3(x + 1, y, z), Vector3(x, y + 1, z));
+        triangles.emplace_back(Vector3(x + 1, y, z), Vector3(x + 1, y + 1, z), Vector3(x, y + 1, z));
+    }
+}
+
+// Tests that an empty hierarchy is never hit.
+TEST(TriangleBVH, EmptyIsNotHit)
+{
+    TriangleBVH bvh;
+    float distance = 0;
+    ASSERT_FALSE(bvh.intersects(Vector3::Zero, Vector3::UnitZ, distance));
+}
+
+// Tests that the nearest triangle is returned when the ray passes through several.
+TEST(TriangleBVH, ReturnsNearestHit)
+{
+    std::vector<Triangle> triangles;
+    for (int z = 20; z > 0; --z)
+    {
+        for (int x = -10; x < 10; ++x)
+        {
+            add_square(triangles, static_cast<float>(x), -0.5f, static_cast<float>(z));
+        }
+    }
+
+    TriangleBVH bvh(triangles);
+    ASSERT_EQ(triangles.size(), bvh.size());
+
+    float distance = 0;
+    ASSERT_TRUE(bvh.intersects(Vector3(0.25f, 0.0f, 0.0f), Vector3::UnitZ, distance));
+    ASSERT_FLOAT_EQ(1.0f, distance);
+}
+
+// Tests that triangles facing away from the ray are not hit.
+TEST(TriangleBVH, BackFacesAreNotHit)
+{
+    std::vector<Triangle> triangles;
+    add_square(triangles, 0.0f, 0.0f, 5.0f);
+
+    TriangleBVH bvh(triangles);
+    float distance = 0;
+    ASSERT_TRUE(bvh.intersects(Vector3(0.25f, 0.25f, 0.0f), Vector3::UnitZ, distance));
+    ASSERT_FALSE(bvh.intersects(Vector3(0.25f, 0.25f, 10.0f), -Vector3::UnitZ, distance));
+}
+
+// Tests that a ray that misses every triangle is not a hit.
+TEST(TriangleBVH, MissIsNotHit)
+{
+    std::vector<Triangle> triangles;
+    for (int x = 0; x < 100; ++x)
+    {
+        add_square(triangles, static_cast<float>(x * 2), 0.0f, 5.0f);
+    }
+
+    TriangleBVH bvh(triangles);
+    float distance = 0;
+    ASSERT_FALSE(bvh.intersects(Vector3(1.5f, 0.5f, 0.0f), Vector3::UnitZ, distance));
+    ASSERT_TRUE(bvh.intersects(Vector3(2.5f, 0.5f, 0.0f), Vector3::UnitZ, distance));
+}
+
+// Tests that a hierarchy loaded from the cache is hit in the same way as the hierarchy that was saved.
+TEST(TriangleBVH, LoadsFromCache)
+{
+    std::vector<Triangle> triangles;
+    for (int x = 0; x < 100; ++x)
+    {
+        add_square(triangles, static_cast<float>(x * 2), 0.0f, static_cast<float>(5 + x % 3));
+    }
+
+    const TriangleBVH bvh(triangles);
+    trlevel::DataWriter writer;
+    bvh.save_cache(writer);
+
+    trlevel::DataReader reader(writer.data());
+    const auto loaded = TriangleBVH::load_cache(reader);
+    ASSERT_EQ(writer.data().size(), reader.position());
+    ASSERT_EQ(bvh.size(), loaded.size());
+
+    for (int x = 0; x < 400; ++x)
+    {
+        const Vector3 position(x * 0.5f + 0.25f, 0.5f, 0.0f);
+        float expected_distance = 0;
+        float distance = 0;
+        const bool expected = bvh.intersects(position, Vector3::UnitZ, expected_distance);
+        ASSERT_EQ(expected, loaded.intersects(position, Vector3::UnitZ, distance)) << "Ray " << x;
+        if (expected)
+        {
+            ASSERT_EQ(expected_distance, distance) << "Ray " << x;
+        }
+    }
+}
+
+// Tests that an empty hierarchy can be loaded from the cache.
+TEST(TriangleBVH, LoadsEmptyFromCache)
+{
+    trlevel::DataWriter writer;
+    TriangleBVH().save_cache(writer);
+
+    trlevel::DataReader reader(writer.data());
+    const auto loaded = TriangleBVH::load_cache(reader);
+    ASSERT_EQ(0u, loaded.size());
+
+    float distance = 0;
+    ASSERT_FALSE(loaded.intersects(Vector3::Zero, Vector3::UnitZ, distance));
+}
+
+// Tests that a hierarchy that refers to triangles it doesn't have is not loaded from the cache.
+TEST(TriangleBVH, LoadCacheRejectsInvalidHierarchy)
+{
+    std::vector<Triangle> triangles;
+    for (int x = 0; x < 20; ++x)
+    {
+        add_square(triangles, static_cast<float>(x * 2), 0.0f, 5.0f);
+    }
+
+    trlevel::DataWriter writer;
+    TriangleBVH(triangles).save_cache(writer);
+
+    // The last value written is the last entry in the triangle order.
+    auto data = writer.data();
+    std::fill(data.end() - 4, data.end(), static_cast<uint8_t>(0xff));
+    trlevel::DataReader reader(data);
+    ASSERT_THROW(TriangleBVH::load_cache(reader), std::runtime_error);
+
+    const std::vector<uint8_t> truncated(writer.data().begin(), writer.data().end() - 1);
+    trlevel::DataReader truncated_reader(truncated);
+    ASSERT_ANY_THROW(TriangleBVH::load_cache(truncated_reader));
+}
@@ -20,13 +20,16 @@ namespace
         MOCK_CONST_METHOD1(get_textile8, tr_textile8(uint32_t));
         MOCK_CONST_METHOD1(get_textile16, tr_textile16(uint32_t));
         MOCK_CONST_METHOD1(get_textile, std::vector<uint32_t>(uint32_t));
+        MOCK_CONST_METHOD2(get_textile, void(uint32_t, std::vector<uint32_t>&));
         MOCK_CONST_METHOD0(num_rooms, uint32_t());
         MOCK_CONST_METHOD1(get_room, tr3_room(uint32_t));
+        MOCK_CONST_METHOD1(room, const tr3_room&(uint32_t));
         MOCK_CONST_METHOD0(num_object_textures, uint32_t());
         MOCK_CONST_METHOD1(get_object_texture, tr_object_texture(uint32_t));
         MOCK_CONST_METHOD0(num_floor_data, uint32_t());
         MOCK_CONST_METHOD1(get_floor_data, uint16_t(uint32_t));
         MOCK_CONST_METHOD0(get_floor_data_all, std::vector<uint16_t>());
+        MOCK_CONST_METHOD0(floor_data, const std::vector<uint16_t>&());
         MOCK_CONST_METHOD0(num_entities, uint32_t());
         MOCK_CONST_METHOD1(get_entity, tr2_entity(uint32_t));
         MOCK_CONST_METHOD0(num_models, uint32_t());
@@ -36,13 +39,27 @@ namespace
         MOCK_CONST_METHOD1(get_static_mesh, tr_staticmesh(uint32_t));
         MOCK_CONST_METHOD0(num_mesh_pointers, uint32_t());
         MOCK_CONST_METHOD1(get_mesh_by_pointer, tr_mesh(uint32_t));
+        MOCK_CONST_METHOD1(mesh, const tr_mesh&(uint32_t));
         MOCK_CONST_METHOD2(get_meshtree, std::vector<tr_meshtree_node>(uint32_t, uint32_t));
+        MOCK_CONST_METHOD2(meshtree, Span<tr_meshtree_node>(uint32_t, uint32_t));
         MOCK_CONST_METHOD2(get_frame, tr2_frame(uint32_t, uint32_t));
+        MOCK_CONST_METHOD3(get_frame, void(uint32_t, uint32_t, tr2_frame&));
+        MOCK_CONST_METHOD0(animations, Span<tr4_animation>());
+        MOCK_CONST_METHOD0(state_changes, Span<tr_state_change>());
+        MOCK_CONST_METHOD0(anim_dispatches, Span<tr_anim_dispatch>());
+        MOCK_CONST_METHOD0(anim_commands, Span<tr_anim_command>());
+        MOCK_CONST_METHOD1(num_model_frames, uint32_t(uint32_t));
+        MOCK_CONST_METHOD2(get_world_transforms, void(Span<PoseInstance>, std::vector<DirectX::SimpleMath::Matrix>&));
+        MOCK_CONST_METHOD0(num_sound_samples, uint32_t());
+        MOCK_CONST_METHOD1(get_sound_sample, std::vector<uint8_t>(uint32_t));
         MOCK_CONST_METHOD0(get_version, LevelVersion());
         MOCK_CONST_METHOD2(get_sprite_sequence_by_id, bool(int32_t, tr_sprite_sequence&));
         MOCK_CONST_METHOD1(get_sprite_texture, tr_sprite_texture(uint32_t));
         MOCK_CONST_METHOD2(find_first_entity_by_type, bool(int16_t, tr2_entity&));
+        MOCK_CONST_METHOD1(entities_by_type, Span<uint32_t>(int16_t));
         MOCK_CONST_METHOD1(get_mesh_from_type_id, int16_t(int16_t));
+        MOCK_METHOD1(trim, void(const LoadOptions&));
+        MOCK_CONST_METHOD0(memory_usage, std::size_t());
     };
 }
 
@@ -90,7 +90,7 @@ namespace trview
 
             // Build the mesh tree.
             // Request one less node than we have meshes as the first mesh is at the same position as the entity.
-            auto mesh_nodes = level.get_meshtree(model.MeshTree, model.NumMeshes - 1);
+            const auto mesh_nodes = level.meshtree(model.MeshTree, model.NumMeshes - 1);
 
             for (const auto& node : mesh_nodes)
             {
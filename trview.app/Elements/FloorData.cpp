@@ -0,0 +1,260 @@
+#include "FloorData.h"
+
+#include <trview.common/ThreadPool.h>
+
+namespace trview
+{
+    namespace
+    {
+        const uint32_t NoRecord = 0u;
+
+        void apply_slope(uint16_t floor_slant, std::array<float, 4>& corners)
+        {
+            const int8_t x_slope = floor_slant & 0x00ff;
+            const int8_t z_slope = floor_slant >> 8;
+
+            if (x_slope > 0)
+            {
+                corners[0] += x_slope * 0.25f;
+                corners[1] += x_slope * 0.25f;
+            }
+            else if (x_slope < 0)
+            {
+                corners[2] -= x_slope * 0.25f;
+                corners[3] -= x_slope * 0.25f;
+            }
+
+            if (z_slope > 0)
+            {
+                corners[0] += z_slope * 0.25f;
+                corners[2] += z_slope * 0.25f;
+            }
+            else if (z_slope < 0)
+            {
+                corners[1] -= z_slope * 0.25f;
+                corners[3] -= z_slope * 0.25f;
+            }
+        }
+    }
+
+    FloorDataRecord decode_floordata(const std::vector<uint16_t>& floor_data, uint16_t floordata_index)
+    {
+        FloorDataRecord record;
+
+        std::uint16_t cur_index = floordata_index;
+        if (cur_index == 0x0)
+        {
+            return record;
+        }
+
+        const auto max_floordata = floor_data.size();
+
+        // Read the word after the current word. A chain that runs off the end of the floordata stops being decoded.
+        auto read_next = [&](uint16_t& value)
+        {
+            if (cur_index + 1u >= max_floordata)
+            {
+                return false;
+            }
+            value = floor_data[++cur_index];
+            return true;
+        };
+
+        while (cur_index < max_floordata)
+        {
+            std::uint16_t floor = floor_data[cur_index];
+            std::uint16_t subfunction = (floor & 0x7F00) >> 8;
+
+            switch (floor & 0x1f)
+            {
+            case 0x1:
+            {
+                uint16_t portal = 0;
+                if (!read_next(portal))
+                {
+                    return record;
+                }
+                record.portal = portal & 0xFF;
+                record.flags |= SectorFlag::Portal;
+                break;
+            }
+
+            case 0x2:
+            {
+                if (!read_next(record.floor_slant))
+                {
+                    return record;
+                }
+                record.flags |= SectorFlag::FloorSlant;
+                apply_slope(record.floor_slant, record.corner_offsets);
+                break;
+            }
+            case 0x3:
+                if (!read_next(record.ceiling_slant))
+                {
+                    return record;
+                }
+                record.flags |= SectorFlag::CeilingSlant;
+                break;
+
+            case 0x4:
+            {
+                auto& trigger = record.trigger;
+                std::uint16_t command = 0;
+                std::uint16_t setup = 0;
+                if (!read_next(setup))
+                {
+                    return record;
+                }
+
+                // Basic trigger setup
+                trigger.timer = setup & 0xFF;
+                trigger.oneshot = (setup & 0x100) >> 8;
+                trigger.mask = (setup & 0x3E00) >> 9;
+
+                // Type of the trigger, e.g. Pad, Switch, etc.
+                trigger.type = (TriggerType)subfunction;
+
+                if (trigger.type == TriggerType::Key || trigger.type == TriggerType::Switch)
+                {
+                    // The next element is the lock or switch - ignore.
+                    ++cur_index;
+                }
+
+                // Parse actions
+                do
+                {
+                    if (++cur_index < max_floordata)
+                    {
+                        command = floor_data[cur_index];
+                        auto action = static_cast<TriggerCommandType>((command & 0x7C00) >> 10);
+                        trigger.commands.emplace_back(action, static_cast<uint16_t>(command & 0x3FF));
+                        if (action == TriggerCommandType::Camera)
+                        {
+                            // Camera has another uint16_t - skip for now.
+                            if (!read_next(command))
+                            {
+                                record.flags |= SectorFlag::Trigger;
+                                return record;
+                            }
+                        }
+                    }
+
+                } while (cur_index < max_floordata && !(command & 0x8000));
+
+                record.flags |= SectorFlag::Trigger;
+                break;
+            }
+            case 0x5:
+                record.flags |= SectorFlag::Death;
+                break;
+
+            case 0x6: // climbable walls
+                record.flags |= (subfunction << 6);
+                break;
+
+            case 0x7:
+            case 0xB:
+            case 0xC:
+            case 0x8:
+            case 0xD:
+            case 0xE:
+            {
+                const int16_t function = (floor & 0x001F);
+                switch (function)
+                {
+                case 0x07:
+                case 0x0B:
+                case 0x0C:
+                    record.triangulation = TriangulationDirection::NwSe;
+                    break;
+                case 0x08:
+                case 0x0D:
+                case 0x0E:
+                    record.triangulation = TriangulationDirection::NeSw;
+                    break;
+                }
+
+                uint16_t corner_values = 0;
+                if (!read_next(corner_values))
+                {
+                    return record;
+                }
+                const uint16_t c00 = (corner_values & 0x00F0) >> 4;
+                const uint16_t c01 = (corner_values & 0x0F00) >> 8;
+                const uint16_t c10 = (corner_values & 0x000F);
+                const uint16_t c11 = (corner_values & 0xF000) >> 12;
+                const auto max_corner = std::max({ c00, c01, c10, c11 });
+
+                record.corner_offsets[0] += (max_corner - c00) * 0.25f;
+                record.corner_offsets[1] += (max_corner - c01) * 0.25f;
+                record.corner_offsets[2] += (max_corner - c10) * 0.25f;
+                record.corner_offsets[3] += (max_corner - c11) * 0.25f;
+                break;
+            }
+            case 0x9:
+            case 0xA:
+            case 0xF:
+            case 0x10:
+            case 0x11:
+            case 0x12:
+            {
+                // Ceiling triangulation.
+                ++cur_index;
+                break;
+            }
+            case 0x13:
+                record.flags |= SectorFlag::MonkeySwing;
+                break;
+            case 0x14:
+                record.flags |= SectorFlag::MinecartLeft;
+                break;
+            case 0x15:
+                record.flags |= SectorFlag::MinecartRight;
+                break;
+            }
+
+            if ((floor >> 15) || cur_index == 0x0) break;
+            else cur_index++;
+        }
+
+        return record;
+    }
+
+    FloorData::FloorData(const trlevel::ILevel& level)
+    {
+        const auto& floor_data = level.floor_data();
+
+        // Record 0 is the empty record used by sectors without floordata.
+        _record_indices.assign(floor_data.size(), NoRecord);
+        std::vector<uint16_t> indices;
+        const auto num_rooms = level.num_rooms();
+        for (uint32_t i = 0; i < num_rooms; ++i)
+        {
+            for (const auto& sector : level.room(i).sector_list)
+            {
+                const auto index = sector.floordata_index;
+                if (index != 0 && index < floor_data.size() && _record_indices[index] == NoRecord)
+                {
+                    _record_indices[index] = static_cast<uint32_t>(indices.size() + 1);
+                    indices.push_back(index);
+                }
+            }
+        }
+
+        _records.resize(indices.size() + 1);
+        parallel_for(ThreadPool::shared(), indices.size(), [&](std::size_t i)
+        {
+            _records[i + 1] = decode_floordata(floor_data, indices[i]);
+        });
+    }
+
+    const FloorDataRecord& FloorData::record(uint16_t floordata_index) const
+    {
+        if (floordata_index >= _record_indices.size())
+        {
+            return _records[NoRecord];
+        }
+        return _records[_record_indices[floordata_index]];
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <trlevel/ILevel.h>
+#include "Types.h"
+
+namespace trview
+{
+    enum class TriangulationDirection
+    {
+        None,
+        NwSe,
+        NeSw
+    };
+
+    /// The decoded floordata chain for a sector.
+    struct FloorDataRecord
+    {
+        /// The SectorFlag values set by the floordata functions.
+        uint16_t flags{ 0 };
+        /// The room that the wall portal points to.
+        uint8_t portal{ 0 };
+        uint16_t floor_slant{ 0 };
+        uint16_t ceiling_slant{ 0 };
+        TriangulationDirection triangulation{ TriangulationDirection::None };
+        /// The amount to add to the floor height at each corner for slants and triangulation.
+        std::array<float, 4> corner_offsets{ 0, 0, 0, 0 };
+        /// The trigger, if the trigger flag is set. The sector id is not set.
+        TriggerInfo trigger{};
+    };
+
+    /// Decodes every floordata chain used by the sectors of a level. Each distinct floordata index is
+    /// decoded once, no matter how many sectors use it.
+    class FloorData final
+    {
+    public:
+        /// Decode the floordata used by all of the rooms in the level.
+        /// @param level The level to decode.
+        explicit FloorData(const trlevel::ILevel& level);
+
+        /// Get the decoded floordata chain that starts at the specified index.
+        /// @param floordata_index The index of the start of the chain.
+        /// @returns The record for the chain. Index 0 and indices not used by any sector give an empty record.
+        const FloorDataRecord& record(uint16_t floordata_index) const;
+    private:
+        std::vector<FloorDataRecord> _records;
+        std::vector<uint32_t> _record_indices;
+    };
+
+    /// Decode the floordata chain that starts at the specified index.
+    /// @param floor_data The floordata for the level.
+    /// @param floordata_index The index of the start of the chain.
+    /// @returns The decoded chain.
+    FloorDataRecord decode_floordata(const std::vector<uint16_t>& floor_data, uint16_t floordata_index);
+}
@@ -10,6 +10,7 @@
 #include <trview.app/Graphics/SelectionRenderer.h>
 #include <trview.app/Graphics/MeshStorage.h>
 #include <trview.app/Elements/ITypeNameLookup.h>
+#include <trview.app/Elements/FloorData.h>
 #include <trview.graphics/RasterizerStateStore.h>
 
 using namespace Microsoft::WRL;
@@ -17,8 +18,24 @@ using namespace DirectX::SimpleMath;
 
 namespace trview
 {
-    Level::Level(const graphics::Device& device, const graphics::IShaderStorage& shader_storage, std::unique_ptr<trlevel::ILevel>&& level, const ITypeNameLookup& type_names)
-        : _version(level->get_version())
+    namespace
+    {
+        BoundingVolumeHierarchy::Bounds to_bounds(const DirectX::BoundingBox& box)
+        {
+            BoundingVolumeHierarchy::Bounds bounds;
+            bounds.add(Vector3(box.Center) - Vector3(box.Extents));
+            bounds.add(Vector3(box.Center) + Vector3(box.Extents));
+            return bounds;
+        }
+    }
+
+    Level::Level(const graphics::Device& device, const graphics::IShaderStorage& shader_storage, std::unique_ptr<trlevel::ILevel>&& level, const ITypeNameLookup& type_names, const std::vector<uint8_t>& cached_geometry)
+        : Level(device, shader_storage)
+    {
+        finish_loading(device, std::move(level), type_names, cached_geometry);
+    }
+
+    Level::Level(const graphics::Device& device, const graphics::IShaderStorage& shader_storage)
     {
         _vertex_shader = shader_storage.get("level_vertex_shader");
         _pixel_shader = shader_storage.get("level_pixel_shader");
@@ -44,20 +61,79 @@ namespace trview
         // Create the texture sampler state.
         device.device()->CreateSamplerState(&sampler_desc, &_sampler_state);
 
+        _transparency = std::make_unique<TransparencyBuffer>(device);
+
+        _selection_renderer = std::make_unique<SelectionRenderer>(device, shader_storage);
+    }
+
+    void Level::load_rooms(const trlevel::ILevel& level, const std::vector<uint32_t>& rooms)
+    {
+        if (!_floor_data)
+        {
+            _version = level.get_version();
+            _rooms.resize(level.num_rooms());
+
+            // Decode the floordata for the whole level up front so that sectors that share a floordata
+            // chain don't each parse it again.
+            _floor_data = std::make_unique<FloorData>(level);
+        }
+
+        for (const auto index : rooms)
+        {
+            if (index < _rooms.size() && !_rooms[index])
+            {
+                _rooms[index] = std::make_unique<Room>(level, level.room(index), *_floor_data, index, *this);
+            }
+        }
+    }
+
+    void Level::finish_loading(const graphics::Device& device, std::unique_ptr<trlevel::ILevel>&& level, const ITypeNameLookup& type_names, const std::vector<uint8_t>& cached_geometry)
+    {
+        _version = level->get_version();
         _texture_storage = std::make_unique<LevelTextureStorage>(device, *level);
-        _mesh_storage = std::make_unique<MeshStorage>(device, *level, *_texture_storage.get());
-        generate_rooms(device, *level);
+
+        // Create the rooms that were not created while the level was loading.
+        std::vector<uint32_t> remaining_rooms(level->num_rooms());
+        std::iota(remaining_rooms.begin(), remaining_rooms.end(), 0u);
+        load_rooms(*level, remaining_rooms);
+        _floor_data.reset();
+        link_alternate_rooms();
+
+        const bool cached = load_cached_geometry(device, *level, cached_geometry);
+        if (!cached)
+        {
+            _generated_geometry = std::make_unique<LevelGeometry>();
+            _generated_geometry->meshes = create_mesh_geometry(*level, *_texture_storage);
+            _generated_geometry->rooms.resize(level->num_rooms());
+            _mesh_storage = std::make_unique<MeshStorage>(device, _generated_geometry->meshes);
+        }
+
+        for (uint32_t i = 0; i < _rooms.size(); ++i)
+        {
+            _rooms[i]->generate_static_meshes(*level, level->room(i), *_mesh_storage);
+        }
         generate_triggers();
         generate_entities(device, *level, type_names);
 
+        // The textures, meshes and entities have all been copied or uploaded to the GPU by now. Only the room
+        // geometry is still needed, and that is released once the pending rooms have been generated.
+        auto remaining_sections = trlevel::LoadOptions::none();
+        remaining_sections.rooms = !cached;
+        level->trim(remaining_sections);
+
         for (auto& room : _rooms)
         {
             room->update_bounding_box();
         }
+        generate_pick_hierarchy();
 
-        _transparency = std::make_unique<TransparencyBuffer>(device);
-
-        _selection_renderer = std::make_unique<SelectionRenderer>(device, shader_storage);
+        if (!cached)
+        {
+            // Only the first room has its geometry generated now, the rest are generated over the next few frames.
+            queue_room_geometry();
+            _level = std::move(level);
+            generate_pending_rooms(device, std::chrono::milliseconds::zero());
+        }
     }
 
     Level::~Level()
@@ -208,6 +284,9 @@ namespace trview
     // camera: The current camera to render the level with.
     void Level::render_rooms(const graphics::Device& device, const ICamera& camera)
     {
+        // Work out which rooms can be seen through portals once per frame. Picking uses the same rooms.
+        _seen_through_portals = rooms_seen_through_portals(camera);
+
         // Only render the rooms that the current view mode includes.
         auto rooms = get_rooms_to_render(camera);
 
@@ -281,9 +360,14 @@ namespace trview
         std::vector<RoomToRender> rooms;
 
         DirectX::BoundingFrustum frustum = camera.frustum();
+        const std::vector<bool>& seen = _seen_through_portals;
 
-        auto in_view = [&](const Room& room)
+        auto in_view = [&](const Room& room, std::size_t index)
         {
+            if (index < seen.size() && !seen[index])
+            {
+                return false;
+            }
             return camera.projection_mode() == ProjectionMode::Orthographic || frustum.Contains(room.bounding_box()) != DirectX::DISJOINT;
         };
     
@@ -293,7 +377,7 @@ namespace trview
             for (uint16_t i : _neighbours)
             {
                 const auto& room = _rooms[i];
-                if (is_alternate_mismatch(*room) || !in_view(*room))
+                if (is_alternate_mismatch(*room) || !in_view(*room, i))
                 {
                     continue;
                 }
@@ -305,7 +389,7 @@ namespace trview
             for (std::size_t i = 0; i < _rooms.size(); ++i)
             {
                 const auto& room = _rooms[i].get();
-                if (is_alternate_mismatch(*room) || !in_view(*room))
+                if (is_alternate_mismatch(*room) || !in_view(*room, i))
                 {
                     continue;
                 }
@@ -316,15 +400,29 @@ namespace trview
         return rooms;
     }
 
-    void Level::generate_rooms(const graphics::Device& device, const trlevel::ILevel& level)
+    std::vector<bool> Level::rooms_seen_through_portals(const ICamera& camera) const
     {
-        const auto num_rooms = level.num_rooms();
-        for (uint32_t i = 0u; i < num_rooms; ++i)
+        // An orthographic camera sees through the walls of the room that it is in, so there is nothing to gain.
+        if (camera.projection_mode() == ProjectionMode::Orthographic)
         {
-            auto room = level.get_room(i);
-            _rooms.push_back(std::make_unique<Room>(device, level, room, *_texture_storage.get(), *_mesh_storage.get(), i, *this));
+            return {};
         }
 
+        const Vector3 position = camera.rendering_position();
+        std::vector<PortalRoom> rooms(_rooms.size());
+        for (std::size_t i = 0; i < _rooms.size(); ++i)
+        {
+            const auto& room = *_rooms[i];
+            rooms[i].portals = &room.portals();
+            rooms[i].shown = !is_alternate_mismatch(room);
+            rooms[i].contains_camera = rooms[i].shown && room.contains(position);
+            rooms[i].shown_instead = room.alternate_room();
+        }
+        return trview::rooms_seen_through_portals(rooms, position, camera.view_projection());
+    }
+
+    void Level::link_alternate_rooms()
+    {
         std::set<uint32_t> alternate_groups;
 
         // Fix up the IsAlternate status of the rooms that are referenced by HasAlternate rooms.
@@ -345,6 +443,124 @@ namespace trview
         }
     }
 
+    void Level::queue_room_geometry()
+    {
+        if (_rooms.empty())
+        {
+            return;
+        }
+
+        uint32_t start_room = 0;
+        Item lara;
+        if (find_item_by_type_id(*this, 0u, lara) && lara.room() < _rooms.size())
+        {
+            start_room = lara.room();
+        }
+
+        std::vector<bool> queued(_rooms.size(), false);
+        auto queue = [&](uint32_t room)
+        {
+            if (room < _rooms.size() && !queued[room])
+            {
+                queued[room] = true;
+                _pending_rooms.push_back(room);
+            }
+        };
+
+        // Work outwards from the starting room through the portals. The pending list is used as the
+        // search queue so the rooms end up in the order that they were reached.
+        queue(start_room);
+        for (std::size_t i = 0; i < _pending_rooms.size(); ++i)
+        {
+            const auto& room = _rooms[_pending_rooms[i]];
+            for (const auto neighbour : room->neighbours())
+            {
+                queue(neighbour);
+            }
+
+            if (room->alternate_room() != -1)
+            {
+                queue(room->alternate_room());
+            }
+        }
+
+        // Rooms that can't be reached through portals are generated last.
+        for (uint32_t i = 0; i < _rooms.size(); ++i)
+        {
+            queue(i);
+        }
+    }
+
+    void Level::generate_pending_rooms(const graphics::Device& device, std::chrono::milliseconds budget)
+    {
+        if (_pending_rooms.empty())
+        {
+            return;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        do
+        {
+            const auto index = _pending_rooms.front();
+            _pending_rooms.pop_front();
+            auto geometry = _rooms[index]->build_geometry(_version, _level->room(index), *_texture_storage);
+            _rooms[index]->generate_geometry(device, geometry);
+            _generated_geometry->rooms[index] = std::move(geometry);
+        }
+        while (!_pending_rooms.empty() && std::chrono::steady_clock::now() - start < budget);
+
+        if (_pending_rooms.empty())
+        {
+            _level.reset();
+        }
+
+        _regenerate_transparency = true;
+        on_level_changed();
+    }
+
+    bool Level::rooms_pending() const
+    {
+        return !_pending_rooms.empty();
+    }
+
+    std::vector<uint8_t> Level::take_generated_geometry()
+    {
+        if (!_generated_geometry || rooms_pending())
+        {
+            return {};
+        }
+
+        const auto geometry = _generated_geometry->save_cache();
+        _generated_geometry.reset();
+        return geometry;
+    }
+
+    bool Level::load_cached_geometry(const graphics::Device& device, const trlevel::ILevel& level, const std::vector<uint8_t>& cached_geometry)
+    {
+        const auto geometry = LevelGeometry::load_cache(cached_geometry, level.num_mesh_pointers(), level.num_rooms(), _texture_storage->num_tiles());
+        if (!geometry)
+        {
+            return false;
+        }
+
+        // The sectors are built from the level rather than the cache, so geometry that was built for different
+        // sectors is not used.
+        for (uint32_t i = 0; i < _rooms.size(); ++i)
+        {
+            if (!_rooms[i]->matches(geometry->rooms[i]))
+            {
+                return false;
+            }
+        }
+
+        _mesh_storage = std::make_unique<MeshStorage>(device, geometry->meshes);
+        for (uint32_t i = 0; i < _rooms.size(); ++i)
+        {
+            _rooms[i]->generate_geometry(device, geometry->rooms[i]);
+        }
+        return true;
+    }
+
     void Level::generate_triggers()
     {
         for (auto i = 0u; i < _rooms.size(); ++i)
@@ -446,32 +662,119 @@ namespace trview
     // is also specified.
     PickResult Level::pick(const ICamera& camera, const DirectX::SimpleMath::Vector3& position, const DirectX::SimpleMath::Vector3& direction) const
     {
-        PickResult final_result;
-        
-        auto choose = [&](PickResult result)
+        const DirectX::BoundingFrustum frustum = camera.frustum();
+        const bool orthographic = camera.projection_mode() == ProjectionMode::Orthographic;
+        const bool neighbours_only = highlight_mode_enabled(RoomHighlightMode::Neighbours);
+        const std::vector<bool>& seen = _seen_through_portals;
+
+        // Whether the room is one that get_rooms_to_render would return. This is only checked for rooms that the ray reaches.
+        auto room_pickable = [&](uint32_t index)
         {
-            // Choose the nearest pick - but if the previous closest was trigger an entity should take priority over it.
-            if (result.hit && (result.distance < final_result.distance || (result.type == PickResult::Type::Entity && final_result.type == PickResult::Type::Trigger)))
+            const auto& room = *_rooms[index];
+            if (is_alternate_mismatch(room) || (neighbours_only && _neighbours.find(static_cast<uint16_t>(index)) == _neighbours.end()) ||
+                (index < seen.size() && !seen[index]))
             {
-                final_result.hit = true;
-                final_result.distance = result.distance;
-                final_result.position = result.position;
-                final_result.index = result.index;
-                final_result.type = result.type;
+                return false;
             }
+            return orthographic || frustum.Contains(room.bounding_box()) != DirectX::DISJOINT;
         };
 
-        auto rooms = get_rooms_to_render(camera);
-        for (auto& room : rooms)
+        // Entities in a room that has been flipped out are still shown in the alternate room, so they can still be picked.
+        auto entity_pickable = [&](uint32_t index)
         {
-            choose(room.room.pick(position, direction, true, _show_triggers, _show_hidden_geometry));
-            if (!is_alternate_mismatch(room.room) && room.room.alternate_mode() == Room::AlternateMode::IsAlternate)
+            if (room_pickable(index))
             {
-                auto& original_room = _rooms[room.room.alternate_room()];
-                choose(original_room->pick(position, direction, true, false, false, false));
+                return true;
+            }
+            const auto& room = *_rooms[index];
+            const int16_t alternate = room.alternate_room();
+            return room.alternate_mode() == Room::AlternateMode::HasAlternate && alternate != -1 &&
+                _rooms[alternate]->alternate_mode() == Room::AlternateMode::IsAlternate && room_pickable(alternate);
+        };
+
+        // An entity takes priority over a trigger, so triggers are kept apart from the entity and room hits. Only
+        // the entity and room hits are used to skip parts of the hierarchy, as an entity behind a trigger still wins.
+        PickResult nearest;
+        PickResult nearest_trigger;
+        bool entity_hit = false;
+        float nearest_distance = FLT_MAX;
+        _pick_hierarchy.traverse(position, direction, nearest_distance, [&](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                const auto& target = _pick_targets[i];
+                switch (target.type)
+                {
+                    case PickResult::Type::Room:
+                    {
+                        if (room_pickable(target.index))
+                        {
+                            nearest = nearest_result(nearest, _rooms[target.index]->pick(position, direction, false, false, _show_hidden_geometry));
+                        }
+                        break;
+                    }
+                    case PickResult::Type::Entity:
+                    {
+                        const auto& entity = *_entities[target.index];
+                        if (entity.visible() && entity_pickable(entity.room()))
+                        {
+                            const auto result = entity.pick(position, direction);
+                            entity_hit |= result.hit;
+                            nearest = nearest_result(nearest, result);
+                        }
+                        break;
+                    }
+                    case PickResult::Type::Trigger:
+                    {
+                        const auto& trigger = *_triggers[target.index];
+                        if (_show_triggers && !entity_hit && trigger.visible() && room_pickable(trigger.room()))
+                        {
+                            nearest_trigger = nearest_result(nearest_trigger, trigger.pick(position, direction));
+                        }
+                        break;
+                    }
+                }
             }
+            nearest_distance = nearest.distance;
+        });
+
+        if (entity_hit)
+        {
+            return nearest;
+        }
+        return nearest_result(nearest, nearest_trigger);
+    }
+
+    void Level::generate_pick_hierarchy()
+    {
+        std::vector<PickTarget> targets;
+        std::vector<BoundingVolumeHierarchy::Bounds> bounds;
+        for (uint32_t i = 0; i < _rooms.size(); ++i)
+        {
+            targets.push_back({ PickResult::Type::Room, i });
+            bounds.push_back(to_bounds(_rooms[i]->bounding_box()));
+        }
+
+        for (uint32_t i = 0; i < _entities.size(); ++i)
+        {
+            targets.push_back({ PickResult::Type::Entity, i });
+            bounds.push_back(to_bounds(_entities[i]->bounding_box()));
+        }
+
+        for (uint32_t i = 0; i < _triggers.size(); ++i)
+        {
+            targets.push_back({ PickResult::Type::Trigger, i });
+            bounds.push_back(to_bounds(_triggers[i]->bounding_box()));
+        }
+
+        // Store the targets in the order of the leaves so that each leaf is a range of targets.
+        _pick_hierarchy = BoundingVolumeHierarchy(bounds, 2);
+        _pick_targets.clear();
+        _pick_targets.reserve(targets.size());
+        for (const auto index : _pick_hierarchy.order())
+        {
+            _pick_targets.push_back(targets[index]);
         }
-        return final_result;
     }
 
     // Determines whether the room is currently being rendered.
@@ -6,14 +6,18 @@
 #include <vector>
 #include <SimpleMath.h>
 #include <set>
+#include <deque>
+#include <chrono>
 
 #include <trview.graphics/Texture.h>
 #include <trview.common/Event.h>
 #include <trlevel/ILevel.h>
 
+#include "LevelGeometry.h"
 #include "Room.h"
 #include "Entity.h"
 #include <trview.app/Geometry/Mesh.h>
+#include <trview.app/Geometry/BoundingVolumeHierarchy.h>
 #include "StaticMesh.h"
 #include <trview.app/Elements/Item.h>
 #include <trview.app/Elements/Trigger.h>
@@ -26,6 +30,7 @@ namespace trview
 {
     struct ILevelTextureStorage;
     struct ICamera;
+    class FloorData;
     class SelectionRenderer;
     struct ITypeNameLookup;
 
@@ -38,9 +43,37 @@ namespace trview
     class Level
     {
     public:
-        Level(const graphics::Device& device, const graphics::IShaderStorage& shader_storage, std::unique_ptr<trlevel::ILevel>&& level, const ITypeNameLookup& type_names);
+        /// Create the level.
+        /// @param device The graphics device to create the geometry with.
+        /// @param shader_storage The shaders to render with.
+        /// @param level The level data.
+        /// @param type_names The type names for entities.
+        /// @param cached_geometry Geometry stored by a previous load of the same level, from take_generated_geometry.
+        /// If this is usable only the buffers are created, otherwise the geometry is built from the level.
+        Level(const graphics::Device& device, const graphics::IShaderStorage& shader_storage, std::unique_ptr<trlevel::ILevel>&& level, const ITypeNameLookup& type_names, const std::vector<uint8_t>& cached_geometry = {});
+
+        /// Create a level that is still being loaded. The rooms are created by load_rooms as they are parsed and
+        /// everything else is created by finish_loading.
+        /// @param device The graphics device to create the geometry with.
+        /// @param shader_storage The shaders to render with.
+        Level(const graphics::Device& device, const graphics::IShaderStorage& shader_storage);
         ~Level();
 
+        /// Create the sectors, portals and neighbours of rooms while the rest of the level is still loading. The
+        /// room geometry is created by finish_loading, as it needs the object textures.
+        /// @param level The level data. Only the version, rooms and floordata are used.
+        /// @param rooms The indices of the rooms to create. Rooms that have already been created are skipped.
+        void load_rooms(const trlevel::ILevel& level, const std::vector<uint32_t>& rooms);
+
+        /// Create the rest of the level once the level data has been loaded, including any rooms that load_rooms
+        /// has not created.
+        /// @param device The graphics device to create the geometry with.
+        /// @param level The level data.
+        /// @param type_names The type names for entities.
+        /// @param cached_geometry Geometry stored by a previous load of the same level, from take_generated_geometry.
+        /// If this is usable only the buffers are created, otherwise the geometry is built from the level.
+        void finish_loading(const graphics::Device& device, std::unique_ptr<trlevel::ILevel>&& level, const ITypeNameLookup& type_names, const std::vector<uint8_t>& cached_geometry = {});
+
         enum class RoomHighlightMode
         {
             None,
@@ -87,6 +120,23 @@ namespace trview
         /// @param camera The current camera.
         void render_transparency(const graphics::Device& device, const ICamera& camera);
 
+        /// Generate the geometry for rooms that do not have any yet. Room geometry is generated a few rooms at
+        /// a time, starting with the room that Lara is in and then the rooms around it, so that the level can
+        /// be viewed before every room is ready.
+        /// @param device The graphics device to create the geometry with.
+        /// @param budget How long to spend generating geometry. At least one room is generated per call.
+        void generate_pending_rooms(const graphics::Device& device, std::chrono::milliseconds budget);
+
+        /// Gets whether there are rooms that are still waiting for their geometry to be generated.
+        /// @returns True if there are rooms without geometry.
+        bool rooms_pending() const;
+
+        /// Get the geometry that was built for the level so that it can be stored in the level cache. The geometry
+        /// is only available once every room has been generated, and is released once it has been taken.
+        /// @returns The geometry, or an empty vector if it was loaded from the cache, is not finished or has
+        /// already been taken.
+        std::vector<uint8_t> take_generated_geometry();
+
         void set_highlight_mode(RoomHighlightMode mode, bool enabled);
         bool highlight_mode_enabled(RoomHighlightMode mode) const;
         void set_selected_room(uint16_t index);
@@ -148,11 +198,13 @@ namespace trview
 
         trlevel::LevelVersion version() const;
     private:
-        void generate_rooms(const graphics::Device& device, const trlevel::ILevel& level);
+        void link_alternate_rooms();
         void generate_triggers();
         void generate_entities(const graphics::Device& device, const trlevel::ILevel& level, const ITypeNameLookup& type_names);
         void regenerate_neighbours();
         void generate_neighbours(std::set<uint16_t>& results, uint16_t selected_room, int32_t max_depth);
+        void queue_room_geometry();
+        bool load_cached_geometry(const graphics::Device& device, const trlevel::ILevel& level, const std::vector<uint8_t>& cached_geometry);
 
         // Render the rooms in the level.
         // context: The device context.
@@ -177,6 +229,11 @@ namespace trview
         // Returns: The rooms to render and their selection mode.
         std::vector<RoomToRender> get_rooms_to_render(const ICamera& camera) const;
 
+        /// Find the rooms that can be seen from the camera by looking through the portals of the room that the camera is in.
+        /// @param camera The current camera.
+        /// @returns Whether each room can be seen, or an empty list if the camera is not inside a room.
+        std::vector<bool> rooms_seen_through_portals(const ICamera& camera) const;
+
         // Determines whether the room is currently being rendered.
         // room: The room index.
         // Returns: True if the room is visible.
@@ -188,10 +245,22 @@ namespace trview
 
         bool is_alternate_group_set(uint16_t group) const;
 
+        /// Build the hierarchy used for picking from the bounding boxes of the rooms, entities and triggers.
+        void generate_pick_hierarchy();
+
+        /// Something that can be picked, in the order of the leaves of the pick hierarchy.
+        struct PickTarget
+        {
+            PickResult::Type type;
+            uint32_t index;
+        };
+
         std::vector<std::unique_ptr<Room>>   _rooms;
         std::vector<std::unique_ptr<Trigger>> _triggers;
         std::vector<std::unique_ptr<Entity>> _entities;
         std::vector<Item> _items;
+        BoundingVolumeHierarchy _pick_hierarchy;
+        std::vector<PickTarget> _pick_targets;
 
         graphics::IShader*          _vertex_shader;
         graphics::IShader*          _pixel_shader;
@@ -206,6 +275,9 @@ namespace trview
         Trigger*           _selected_trigger{ nullptr };
         uint32_t           _neighbour_depth{ 1 };
         std::set<uint16_t> _neighbours;
+        /// The rooms that could be seen through portals when the rooms were last rendered. Picking uses this
+        /// rather than flooding through the portals again on every mouse move. Empty if every room could be seen.
+        std::vector<bool> _seen_through_portals;
 
         std::unique_ptr<ILevelTextureStorage> _texture_storage;
         std::unique_ptr<IMeshStorage> _mesh_storage;
@@ -220,7 +292,17 @@ namespace trview
 
         std::unique_ptr<SelectionRenderer> _selection_renderer;
         std::set<uint32_t> _alternate_groups;
-        trlevel::LevelVersion _version;
+        trlevel::LevelVersion _version{ trlevel::LevelVersion::Unknown };
+
+        // The floordata is decoded when the first rooms are loaded and kept until every room has been created.
+        std::unique_ptr<FloorData> _floor_data;
+
+        // The level data is kept until every room has had its geometry generated.
+        std::unique_ptr<trlevel::ILevel> _level;
+        std::deque<uint32_t> _pending_rooms;
+
+        // The geometry built for the level, kept until it has been taken to be stored in the level cache.
+        std::unique_ptr<LevelGeometry> _generated_geometry;
     };
 
     /// Find the first item with the type id specified.
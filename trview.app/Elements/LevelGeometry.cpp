@@ -0,0 +1,98 @@
+#include "LevelGeometry.h"
+
+namespace trview
+{
+    namespace
+    {
+        // Increase this when anything about the way the geometry is built or stored changes, so that geometry
+        // built by an older version is built again.
+        const uint32_t GeometryFormat = 1;
+
+        bool textiles_match(const MeshGeometry& geometry, uint32_t num_textiles)
+        {
+            return (geometry.indices.empty() || geometry.indices.size() == num_textiles) &&
+                std::all_of(geometry.transparent_triangles.begin(), geometry.transparent_triangles.end(),
+                    [=](const auto& triangle) { return triangle.texture < num_textiles || triangle.texture == TransparentTriangle::Untextured; });
+        }
+    }
+
+    void RoomGeometry::save_cache(trlevel::DataWriter& writer) const
+    {
+        mesh.save_cache(writer);
+        unmatched.save_cache(writer);
+        writer.write_sized_vector<uint32_t>(sector_corners);
+    }
+
+    RoomGeometry RoomGeometry::load_cache(trlevel::DataReader& reader)
+    {
+        RoomGeometry geometry;
+        geometry.mesh = MeshGeometry::load_cache(reader);
+        geometry.unmatched = MeshGeometry::load_cache(reader);
+        geometry.sector_corners = reader.read_vector<uint32_t, std::array<float, 4>>();
+        return geometry;
+    }
+
+    std::vector<uint8_t> LevelGeometry::save_cache() const
+    {
+        trlevel::DataWriter writer;
+        writer.write(GeometryFormat);
+        writer.write(static_cast<uint32_t>(meshes.size()));
+        for (const auto& mesh : meshes)
+        {
+            mesh.save_cache(writer);
+        }
+        writer.write(static_cast<uint32_t>(rooms.size()));
+        for (const auto& room : rooms)
+        {
+            room.save_cache(writer);
+        }
+        return writer.data();
+    }
+
+    std::optional<LevelGeometry> LevelGeometry::load_cache(const std::vector<uint8_t>& data, uint32_t num_meshes, uint32_t num_rooms, uint32_t num_textiles)
+    {
+        if (data.empty())
+        {
+            return std::nullopt;
+        }
+
+        // Anything wrong with the stored geometry means it is built again, the same as if there had been none.
+        try
+        {
+            trlevel::DataReader reader(data);
+            if (reader.read<uint32_t>() != GeometryFormat || reader.read<uint32_t>() != num_meshes)
+            {
+                return std::nullopt;
+            }
+
+            LevelGeometry geometry;
+            for (uint32_t i = 0; i < num_meshes; ++i)
+            {
+                geometry.meshes.push_back(MeshGeometry::load_cache(reader));
+            }
+
+            if (reader.read<uint32_t>() != num_rooms)
+            {
+                return std::nullopt;
+            }
+
+            for (uint32_t i = 0; i < num_rooms; ++i)
+            {
+                geometry.rooms.push_back(RoomGeometry::load_cache(reader));
+            }
+
+            const bool valid = reader.position() == reader.size() &&
+                std::all_of(geometry.meshes.begin(), geometry.meshes.end(), [=](const auto& mesh) { return textiles_match(mesh, num_textiles); }) &&
+                std::all_of(geometry.rooms.begin(), geometry.rooms.end(), [=](const auto& room) { return textiles_match(room.mesh, num_textiles) && textiles_match(room.unmatched, num_textiles); });
+            if (!valid)
+            {
+                return std::nullopt;
+            }
+            return geometry;
+        }
+        catch (const std::exception&)
+        {
+            return std::nullopt;
+        }
+    }
+}
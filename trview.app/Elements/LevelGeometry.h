@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include <trlevel/DataReader.h>
+#include <trlevel/DataWriter.h>
+
+#include <trview.app/Geometry/MeshGeometry.h>
+
+namespace trview
+{
+    /// The geometry for a room apart from the D3D buffers.
+    struct RoomGeometry
+    {
+        /// The room geometry, with the collision triangles for any transparent faces that match the floor.
+        MeshGeometry mesh;
+        /// The walkable floors that have no matching room geometry.
+        MeshGeometry unmatched;
+        /// The corner heights of each sector at the time the geometry was built, in sector order.
+        std::vector<std::array<float, 4>> sector_corners;
+
+        /// Write the geometry so that it can be loaded again without being built.
+        /// @param writer The writer to write to.
+        void save_cache(trlevel::DataWriter& writer) const;
+
+        /// Load geometry written by save_cache.
+        /// @param reader The reader to read from.
+        /// @returns The geometry. Throws std::runtime_error if the geometry is not valid.
+        static RoomGeometry load_cache(trlevel::DataReader& reader);
+    };
+
+    /// The geometry built for every mesh and room in a level. This is stored in the level cache next to the
+    /// level so that opening the level again only has to create the buffers.
+    struct LevelGeometry
+    {
+        /// The geometry for each mesh pointer.
+        std::vector<MeshGeometry> meshes;
+        /// The geometry for each room.
+        std::vector<RoomGeometry> rooms;
+
+        /// Convert the geometry to the bytes that are stored in the level cache.
+        /// @returns The bytes.
+        std::vector<uint8_t> save_cache() const;
+
+        /// Load geometry from bytes created by save_cache.
+        /// @param data The bytes to load.
+        /// @param num_meshes The number of mesh pointers in the level.
+        /// @param num_rooms The number of rooms in the level.
+        /// @param num_textiles The number of textiles in the level.
+        /// @returns The geometry, or nothing if there is no geometry or it was not built for a level like this one.
+        static std::optional<LevelGeometry> load_cache(const std::vector<uint8_t>& data, uint32_t num_meshes, uint32_t num_rooms, uint32_t num_textiles);
+    };
+}
@@ -1,4 +1,5 @@
 #include "Room.h"
+#include <cmath>
 #include <trview.app/Geometry/MeshVertex.h>
 #include "Entity.h"
 #include <trview.app/Elements/Level.h>
@@ -6,6 +7,7 @@
 #include <trview.app/Graphics/ILevelTextureStorage.h>
 #include <trview.app/Graphics/IMeshStorage.h>
 #include <trview.app/Camera/ICamera.h>
+#include <trview.app/Geometry/FaceGrid.h>
 #include <trview.app/Geometry/Mesh.h>
 #include <trview.app/Geometry/TransparencyBuffer.h>
 
@@ -39,11 +41,9 @@ namespace trview
         }
     }
 
-    Room::Room(const graphics::Device& device, 
-        const trlevel::ILevel& level, 
+    Room::Room(const trlevel::ILevel& level, 
         const trlevel::tr3_room& room,
-        const ILevelTextureStorage& texture_storage,
-        const IMeshStorage& mesh_storage,
+        const FloorData& floor_data,
         uint32_t index,
         Level& parent_level)
         : _info { room.info.x, 0, room.info.z, room.info.yBottom, room.info.yTop }, 
@@ -61,10 +61,20 @@ namespace trview
         _alternate_mode = room.alternate_room != -1 ? AlternateMode::HasAlternate : AlternateMode::None;
 
         _room_offset = Matrix::CreateTranslation(room.info.x / trlevel::Scale_X, 0, room.info.z / trlevel::Scale_Z);
-        generate_sectors(level, room);
-        generate_geometry(level.get_version(), device, room, texture_storage);
+
+        // Portal vertices are relative to the room, so move them into world space.
+        for (const auto& portal : room.portals)
+        {
+            Portal world_portal{ portal.adjoining_room, convert_vertex(portal.normal) };
+            for (std::size_t i = 0; i < world_portal.vertices.size(); ++i)
+            {
+                world_portal.vertices[i] = Vector3::Transform(convert_vertex(portal.vertices[i]), _room_offset);
+            }
+            _portals.push_back(world_portal);
+        }
+
+        generate_sectors(level, room, floor_data);
         generate_adjacency();
-        generate_static_meshes(level, room, mesh_storage);
     }
 
     RoomInfo Room::info() const
@@ -93,7 +103,8 @@ namespace trview
             return PickResult();
         }
 
-        std::vector<PickResult> pick_results;
+        PickResult result;
+        bool entity_hit = false;
 
         if (include_entities)
         {
@@ -108,12 +119,13 @@ namespace trview
                 auto entity_result = entity->pick(position, direction);
                 if (entity_result.hit)
                 {
-                    pick_results.push_back(entity_result);
+                    entity_hit = true;
+                    result = nearest_result(result, entity_result);
                 }
             }
         }
 
-        if (include_triggers && pick_results.empty())
+        if (include_triggers && !entity_hit)
         {
             for (const auto& trigger : _triggers)
             {
@@ -122,15 +134,12 @@ namespace trview
                     continue;
                 }
 
-                auto trigger_result = trigger.second->pick(position, direction);
-                if (trigger_result.hit)
-                {
-                    pick_results.push_back(trigger_result);
-                }
+                result = nearest_result(result, trigger.second->pick(position, direction));
             }
         }
 
-        if (include_room_geometry)
+        // The room geometry may not have been generated yet if the level is still loading.
+        if (include_room_geometry && _mesh)
         {
             // Pick against the room geometry:
             auto room_offset = Matrix::CreateTranslation(-_info.x / trlevel::Scale_X, 0, -_info.z / trlevel::Scale_Z);
@@ -141,7 +150,7 @@ namespace trview
                 geometry_result.type = PickResult::Type::Room;
                 geometry_result.index = _index;
                 geometry_result.position = Vector3::Transform(geometry_result.position, _room_offset);
-                pick_results.push_back(geometry_result);
+                result = nearest_result(result, geometry_result);
             }
 
             if (include_hidden_geometry)
@@ -152,20 +161,12 @@ namespace trview
                     unmatched_result.type = PickResult::Type::Room;
                     unmatched_result.index = _index;
                     unmatched_result.position = Vector3::Transform(unmatched_result.position, _room_offset);
-                    pick_results.push_back(unmatched_result);
+                    result = nearest_result(result, unmatched_result);
                 }
             }
         }
 
-        if (pick_results.empty())
-        {
-            return PickResult();
-        }
-
-        // Choose the closest pick out of all results.
-        std::sort(pick_results.begin(), pick_results.end(),
-            [](const auto& l, const auto& r) { return l.distance < r.distance; });
-        return pick_results.front();
+        return result;
     }
 
     // Render the level geometry and the objects contained in this room.
@@ -180,10 +181,13 @@ namespace trview
 
         auto context = device.context();
 
-        _mesh->render(context, _room_offset * camera.view_projection(), texture_storage, colour);
-        if (show_hidden_geometry)
+        if (_mesh)
         {
-            _unmatched_mesh->render(context, _room_offset * camera.view_projection(), texture_storage, colour);
+            _mesh->render(context, _room_offset * camera.view_projection(), texture_storage, colour);
+            if (show_hidden_geometry)
+            {
+                _unmatched_mesh->render(context, _room_offset * camera.view_projection(), texture_storage, colour);
+            }
         }
 
         for (const auto& mesh : _static_meshes)
@@ -219,49 +223,69 @@ namespace trview
         }
     }
 
-    namespace
+    void Room::generate_geometry(trlevel::LevelVersion level_version, const graphics::Device& device, const trlevel::tr3_room& room, const ILevelTextureStorage& texture_storage)
     {
-        /// Check if the triangle points appear in the position source.
-        /// @param tri The triangle points.
-        /// @param source The point list.
-        bool triangle_contained(const std::vector<Vector3>& tri, const std::vector<Vector3>& source)
+        if (_mesh)
         {
-            auto v0 = std::find(source.begin(), source.end(), tri[0]);
-            auto v1 = std::find(source.begin(), source.end(), tri[1]);
-            auto v2 = std::find(source.begin(), source.end(), tri[2]);
-            return v0 != source.end() && v1 != source.end() && v2 != source.end();
+            return;
         }
+
+        generate_geometry(device, build_geometry(level_version, room, texture_storage));
     }
 
-    void Room::generate_geometry(trlevel::LevelVersion level_version, const graphics::Device& device, const trlevel::tr3_room& room, const ILevelTextureStorage& texture_storage)
+    void Room::generate_geometry(const graphics::Device& device, const RoomGeometry& geometry)
+    {
+        if (_mesh)
+        {
+            return;
+        }
+
+        _mesh = std::make_unique<Mesh>(device, geometry.mesh);
+        _unmatched_mesh = std::make_unique<Mesh>(device, geometry.unmatched);
+
+        // Generate the bounding box based on the room dimensions.
+        update_bounding_box();
+    }
+
+    RoomGeometry Room::build_geometry(trlevel::LevelVersion level_version, const trlevel::tr3_room& room, const ILevelTextureStorage& texture_storage) const
     {
         std::vector<trlevel::tr_vertex> room_vertices;
         std::transform(room.data.vertices.begin(), room.data.vertices.end(), std::back_inserter(room_vertices),
             [](const auto& v) { return v.vertex; });
 
-        std::vector<MeshVertex> vertices;
-        std::vector<TransparentTriangle> transparent_triangles;
+        RoomGeometry geometry;
 
         // The indices are grouped by the number of textiles so that it can be drawn as the selected texture.
-        std::vector<std::vector<uint32_t>> indices(texture_storage.num_tiles());
-        
+        geometry.mesh.indices.resize(texture_storage.num_tiles());
+
         std::vector<Triangle> collision_triangles;
+        process_textured_rectangles(level_version, room.data.rectangles, room_vertices, texture_storage, geometry.mesh.vertices, geometry.mesh.indices, geometry.mesh.transparent_triangles, collision_triangles, false);
+        process_textured_triangles(level_version, room.data.triangles, room_vertices, texture_storage, geometry.mesh.vertices, geometry.mesh.indices, geometry.mesh.transparent_triangles, collision_triangles, false);
+        process_collision_transparency(geometry.mesh.transparent_triangles, collision_triangles);
+        geometry.mesh.collision = TriangleBVH(std::move(collision_triangles));
 
-        process_textured_rectangles(level_version, room.data.rectangles, room_vertices, texture_storage, vertices, indices, transparent_triangles, collision_triangles, false);
-        process_textured_triangles(level_version, room.data.triangles, room_vertices, texture_storage, vertices, indices, transparent_triangles, collision_triangles, false);
-        process_collision_transparency(transparent_triangles, collision_triangles);
+        // Make the unmatched mesh.
+        std::vector<Triangle> unmatched_collision_triangles;
+        process_unmatched_geometry(room.data, room_vertices, geometry.mesh.transparent_triangles, geometry.unmatched.vertices, geometry.unmatched.untextured_indices, unmatched_collision_triangles);
+        geometry.unmatched.collision = TriangleBVH(std::move(unmatched_collision_triangles));
 
-        _mesh = std::make_unique<Mesh>(device, vertices, indices, std::vector<uint32_t>{}, transparent_triangles, collision_triangles);
+        for (const auto& sector : _sectors)
+        {
+            geometry.sector_corners.push_back(sector->corners());
+        }
+        return geometry;
+    }
 
-        // Make the unmatched mesh.
-        collision_triangles.clear();
-        vertices.clear();
-        std::vector<uint32_t> untextured_indices;
-        process_unmatched_geometry(room.data, room_vertices, transparent_triangles, vertices, untextured_indices, collision_triangles);
-        _unmatched_mesh = std::make_unique<Mesh>(device, vertices, std::vector<std::vector<uint32_t>>{}, untextured_indices, std::vector<TransparentTriangle>{}, collision_triangles);
+    bool Room::matches(const RoomGeometry& geometry) const
+    {
+        return geometry.sector_corners.size() == _sectors.size() &&
+            std::equal(_sectors.begin(), _sectors.end(), geometry.sector_corners.begin(),
+                [](const auto& sector, const auto& corners) { return sector->corners() == corners; });
+    }
 
-        // Generate the bounding box based on the room dimensions.
-        update_bounding_box();
+    bool Room::geometry_generated() const
+    {
+        return _mesh != nullptr;
     }
 
     void Room::generate_adjacency()
@@ -287,12 +311,12 @@ namespace trview
     }
 
     void 
-    Room::generate_sectors(const trlevel::ILevel& level, const trlevel::tr3_room& room)
+    Room::generate_sectors(const trlevel::ILevel& level, const trlevel::tr3_room& room, const FloorData& floor_data)
     {
         for (auto i = 0u; i < room.sector_list.size(); ++i)
         {
             const trlevel::tr_room_sector &sector = room.sector_list[i];
-            _sectors.push_back(std::make_shared<Sector>(level, room, sector, i, _index));
+            _sectors.push_back(std::make_shared<Sector>(level, room, sector, floor_data.record(sector.floordata_index), i, _index));
         }
     }
 
@@ -300,9 +324,12 @@ namespace trview
     {
         Color colour = room_colour(water() && show_water, selected);
 
-        for (const auto& triangle : _mesh->transparent_triangles())
+        if (_mesh)
         {
-            transparency.add(triangle.transform(_room_offset, colour));
+            for (const auto& triangle : _mesh->transparent_triangles())
+            {
+                transparency.add(triangle.transform(_room_offset, colour));
+            }
         }
 
         for (const auto& static_mesh : _static_meshes)
@@ -383,6 +410,19 @@ namespace trview
         return _bounding_box;
     }
 
+    const std::vector<Portal>& Room::portals() const
+    {
+        return _portals;
+    }
+
+    bool Room::contains(const Vector3& position) const
+    {
+        const float x = position.x - _info.x / trlevel::Scale_X;
+        const float z = position.z - _info.z / trlevel::Scale_Z;
+        return x >= 0 && x < _num_x_sectors && z >= 0 && z < _num_z_sectors &&
+            position.y >= _info.yTop / trlevel::Scale_Y && position.y <= _info.yBottom / trlevel::Scale_Y;
+    }
+
     void Room::generate_trigger_geometry()
     {
         for (auto& trigger_iter : _triggers)
@@ -528,51 +568,6 @@ namespace trview
 
     namespace
     {
-        /// Check if the triangle appears in any of the rectangles or triangles in the room.
-        /// @param triangle The points in the sector triangle.
-        /// @param data The room data containing the rectangles and triangles.
-        /// @param room_vertices The vertices for the room.
-        /// @param transparent_triangles Transparent triangles in the room.
-        bool geometry_matched(const std::vector<Vector3>& triangle, const trlevel::tr3_room_data& data,  const std::vector<Vector3>& room_vertices, const std::vector<TransparentTriangle>& transparent_triangles)
-        {
-            for (const auto& r : data.rectangles)
-            {
-                if (triangle_contained(triangle,
-                        {
-                            room_vertices[r.vertices[0]],
-                            room_vertices[r.vertices[1]],
-                            room_vertices[r.vertices[2]],
-                            room_vertices[r.vertices[3]]
-                        }))
-                {
-                    return true;
-                }
-            }
-
-            for (const auto& t : data.triangles)
-            {
-                if (triangle_contained(triangle,
-                        {
-                            room_vertices[t.vertices[0]],
-                            room_vertices[t.vertices[1]],
-                            room_vertices[t.vertices[2]]
-                        }))
-                {
-                    return true;
-                }
-            }
-
-            for (const auto& tt : transparent_triangles)
-            {
-                if (triangle_contained(triangle, { tt.vertices, tt.vertices + 3 }))
-                {
-                    return true;
-                }
-            }
-
-            return false;
-        }
-
         void add_triangle(
             const std::vector<Vector3>& tri,
             std::vector<MeshVertex>& output_vertices,
@@ -594,32 +589,56 @@ namespace trview
         }
     }
 
-    void Room::process_collision_transparency(const std::vector<TransparentTriangle>& transparent_triangles, std::vector<Triangle>& collision_triangles)
+    void Room::process_collision_transparency(const std::vector<TransparentTriangle>& transparent_triangles, std::vector<Triangle>& collision_triangles) const
     {
         for (const auto& triangle : transparent_triangles)
         {
-            for (const auto& sector : _sectors)
+            // A triangle that matches a sector has all of its points on the corners of that sector, so the centroid is
+            // in that sector or on its far edges. Only the sector at the centroid and the ones behind it need checking.
+            // They are checked in sector order so that the same sector is chosen as checking every sector would.
+            const Vector3 centroid = (triangle.vertices[0] + triangle.vertices[1] + triangle.vertices[2]) / 3.0f;
+            const int32_t centre_x = static_cast<int32_t>(std::floor(centroid.x));
+            const int32_t centre_z = static_cast<int32_t>(std::floor(centroid.z));
+
+            bool matched = false;
+            for (int32_t x = centre_x - 1; x <= centre_x && !matched; ++x)
             {
-                if (!sector->is_floor())
+                for (int32_t z = centre_z - 1; z <= centre_z && !matched; ++z)
                 {
-                    continue;
-                }
-
-                const float x = sector->x() + 0.5f;
-                const float z = sector->z() + 0.5f;
-                const auto corners = sector->corners();
-
-                if (triangle_contained(
-                    { triangle.vertices, triangle.vertices + 3 },
-                    { { x + 0.5f, corners[2], z - 0.5f },
-                      { x - 0.5f, corners[1], z + 0.5f },
-                      { x + 0.5f, corners[3], z + 0.5f },
-                      { x - 0.5f, corners[0], z - 0.5f } }))
-                {
-                    collision_triangles.push_back(Triangle(triangle.vertices[0], triangle.vertices[1], triangle.vertices[2]));
-
-                    // A triangle can only match in one sector, so stop after adding it once.
-                    break;
+                    if (x < 0 || x >= _num_x_sectors || z < 0 || z >= _num_z_sectors)
+                    {
+                        continue;
+                    }
+
+                    const auto& sector = _sectors[get_sector_id(x, z)];
+                    if (!sector->is_floor())
+                    {
+                        continue;
+                    }
+
+                    const float sector_x = sector->x() + 0.5f;
+                    const float sector_z = sector->z() + 0.5f;
+                    const auto corners = sector->corners();
+                    const Vector3 sector_corners[4] =
+                    {
+                        { sector_x + 0.5f, corners[2], sector_z - 0.5f },
+                        { sector_x - 0.5f, corners[1], sector_z + 0.5f },
+                        { sector_x + 0.5f, corners[3], sector_z + 0.5f },
+                        { sector_x - 0.5f, corners[0], sector_z - 0.5f }
+                    };
+
+                    auto is_corner = [&](const Vector3& point)
+                    {
+                        return std::find(std::begin(sector_corners), std::end(sector_corners), point) != std::end(sector_corners);
+                    };
+
+                    if (is_corner(triangle.vertices[0]) && is_corner(triangle.vertices[1]) && is_corner(triangle.vertices[2]))
+                    {
+                        collision_triangles.push_back(Triangle(triangle.vertices[0], triangle.vertices[1], triangle.vertices[2]));
+
+                        // A triangle can only match in one sector, so stop after adding it once.
+                        matched = true;
+                    }
                 }
             }
         }
@@ -631,22 +650,40 @@ namespace trview
         const std::vector<TransparentTriangle>& transparent_triangles,
         std::vector<MeshVertex>& output_vertices,
         std::vector<uint32_t>& output_indices,
-        std::vector<Triangle>& collision_triangles)
+        std::vector<Triangle>& collision_triangles) const
     {
-        std::vector<Vector3> transformed_room_vertices;
-        std::transform(room_vertices.begin(), room_vertices.end(), std::back_inserter(transformed_room_vertices), convert_vertex);
+        // Sector triangles are only compared against the faces in the same sector.
+        std::vector<FaceGrid::Face> faces;
+        faces.reserve(data.rectangles.size() + data.triangles.size() + transparent_triangles.size());
+        for (const auto& r : data.rectangles)
+        {
+            faces.push_back({ { convert_vertex(room_vertices[r.vertices[0]]), convert_vertex(room_vertices[r.vertices[1]]),
+                convert_vertex(room_vertices[r.vertices[2]]), convert_vertex(room_vertices[r.vertices[3]]) }, 4 });
+        }
+
+        for (const auto& t : data.triangles)
+        {
+            faces.push_back({ { convert_vertex(room_vertices[t.vertices[0]]), convert_vertex(room_vertices[t.vertices[1]]),
+                convert_vertex(room_vertices[t.vertices[2]]) }, 3 });
+        }
+
+        for (const auto& tt : transparent_triangles)
+        {
+            faces.push_back({ { tt.vertices[0], tt.vertices[1], tt.vertices[2] }, 3 });
+        }
 
+        const FaceGrid grid(_num_x_sectors, _num_z_sectors, faces);
         for (const auto& sector : _sectors)
         {
             if (sector->is_floor())
             {
                 const auto tris = sector->triangles();
-                if (!geometry_matched({ tris.begin(), tris.begin() + 3 }, data, transformed_room_vertices, transparent_triangles))
+                if (!grid.contains_triangle(&tris[0]))
                 {
                     add_triangle({ tris.begin(), tris.begin() + 3 }, output_vertices, output_indices, collision_triangles, get_unmatched_colour(_info, *sector));
                 }
 
-                if (!geometry_matched({ tris.begin() + 3, tris.end() }, data, transformed_room_vertices, transparent_triangles))
+                if (!grid.contains_triangle(&tris[3]))
                 {
                     add_triangle({ tris.begin() + 3, tris.end() }, output_vertices, output_indices, collision_triangles, get_unmatched_colour(_info, *sector));
                 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <vector>
 #include <cstdint>
 #include <set>
@@ -10,6 +11,7 @@
 #include <SimpleMath.h>
 
 #include <trview.app/Elements/RoomInfo.h>
+#include <trview.app/Elements/LevelGeometry.h>
 #include <trview.graphics/Texture.h>
 
 #include <trlevel/trtypes.h>
@@ -19,7 +21,9 @@
 #include <trview.app/Geometry/TransparencyBuffer.h>
 #include <trview.app/Geometry/Mesh.h>
 #include <trview.app/Elements/Sector.h>
+#include <trview.app/Elements/Trigger.h>
 #include <trview.app/Geometry/PickResult.h>
+#include <trview.app/Geometry/PortalVisibility.h>
 
 namespace trview
 {
@@ -50,11 +54,9 @@ namespace trview
             IsAlternate
         };
 
-        explicit Room(const graphics::Device& device, 
-            const trlevel::ILevel& level, 
+        explicit Room(const trlevel::ILevel& level, 
             const trlevel::tr3_room& room,
-            const ILevelTextureStorage& texture_storage,
-            const IMeshStorage& mesh_storage,
+            const FloorData& floor_data,
             uint32_t index,
             Level& parent_level);
 
@@ -80,6 +82,13 @@ namespace trview
 
         void render_contained(const graphics::Device& context, const ICamera& camera, const ILevelTextureStorage& texture_storage, SelectionMode selected, bool show_water, bool force_water = false);
 
+        /// Create the static meshes in the room. This is separate from the constructor so that the room can be created
+        /// before the meshes have been loaded.
+        /// @param level The level that contains the room.
+        /// @param room The room data.
+        /// @param mesh_storage The meshes for the level.
+        void generate_static_meshes(const trlevel::ILevel& level, const trlevel::tr3_room& room, const IMeshStorage& mesh_storage);
+
         // Add the specified entity to the room.
         // Entity: The entity to add.
         void add_entity(Entity* entity);
@@ -136,11 +145,50 @@ namespace trview
         /// @returns The bounding box for the room.
         const DirectX::BoundingBox& bounding_box() const;
 
+        /// Get the portals that lead out of the room.
+        /// @returns The portals.
+        const std::vector<Portal>& portals() const;
+
+        /// Determine whether a position is inside the sectors of the room and between its floor and ceiling.
+        /// @param position The world space position to test.
+        /// @returns True if the position is inside the room.
+        bool contains(const DirectX::SimpleMath::Vector3& position) const;
+
         void generate_trigger_geometry();
 
         uint32_t number() const;
         void update_bounding_box();
 
+        /// Create the meshes for the room geometry. Rooms have no geometry to render or pick until this has been
+        /// called, which allows the level to spread the work over several frames. Does nothing if the geometry
+        /// has already been generated.
+        /// @param level_version The version of the level the room is from.
+        /// @param device The device to create the meshes with.
+        /// @param room The room data that this room was created from.
+        /// @param texture_storage The textures for the level.
+        void generate_geometry(trlevel::LevelVersion level_version, const graphics::Device& device, const trlevel::tr3_room& room, const ILevelTextureStorage& texture_storage);
+
+        /// Create the meshes for the room from geometry that has already been built. Does nothing if the geometry
+        /// has already been generated.
+        /// @param device The device to create the meshes with.
+        /// @param geometry The geometry built by build_geometry.
+        void generate_geometry(const graphics::Device& device, const RoomGeometry& geometry);
+
+        /// Build the geometry for the room without creating any meshes.
+        /// @param level_version The version of the level the room is from.
+        /// @param room The room data that this room was created from.
+        /// @param texture_storage The textures for the level.
+        /// @returns The geometry.
+        RoomGeometry build_geometry(trlevel::LevelVersion level_version, const trlevel::tr3_room& room, const ILevelTextureStorage& texture_storage) const;
+
+        /// Gets whether the geometry was built for sectors that are the same as the sectors in this room.
+        /// @param geometry The geometry to check.
+        /// @returns True if the geometry can be used for this room.
+        bool matches(const RoomGeometry& geometry) const;
+
+        /// Gets whether the room geometry has been generated.
+        bool geometry_generated() const;
+
         /// Gets whether this room is outside (can see the skybox).
         bool outside() const;
 
@@ -150,19 +198,17 @@ namespace trview
         /// Gets whether this room is a quicksand room.
         bool quicksand() const;
     private:
-        void generate_geometry(trlevel::LevelVersion level_version, const graphics::Device& device, const trlevel::tr3_room& room, const ILevelTextureStorage& texture_storage);
         void generate_adjacency();
-        void generate_static_meshes(const trlevel::ILevel& level, const trlevel::tr3_room& room, const IMeshStorage& mesh_storage);
         void render_contained(const graphics::Device& device, const ICamera& camera, const ILevelTextureStorage& texture_storage, const DirectX::SimpleMath::Color& colour);
         void get_contained_transparent_triangles(TransparencyBuffer& transparency, const ICamera& camera, const DirectX::SimpleMath::Color& colour);
-        void generate_sectors(const trlevel::ILevel& level, const trlevel::tr3_room& room);
+        void generate_sectors(const trlevel::ILevel& level, const trlevel::tr3_room& room, const FloorData& floor_data);
         Sector*  get_trigger_sector(int32_t x, int32_t z);
         uint32_t get_sector_id(int32_t x, int32_t z) const;
 
         /// Find any transparent triangles that match floor data geometry.
         /// @param transparent_triangles The transparent triangles in the sector.
         /// @param collision_triangles The collision output vector.
-        void process_collision_transparency(const std::vector<TransparentTriangle>& transparent_triangles, std::vector<Triangle>& collision_triangles);
+        void process_collision_transparency(const std::vector<TransparentTriangle>& transparent_triangles, std::vector<Triangle>& collision_triangles) const;
 
         /// Process the sectors in the level and find where there are walkable floors that have no matching geometry.
         /// @param data The room data to check against.
@@ -175,10 +221,11 @@ namespace trview
             const std::vector<TransparentTriangle>& transparent_triangles,
             std::vector<MeshVertex>& output_vertices,
             std::vector<uint32_t>& output_indices,
-            std::vector<Triangle>& collision_triangles);
+            std::vector<Triangle>& collision_triangles) const;
 
         RoomInfo                           _info;
         std::set<uint16_t>                 _neighbours;
+        std::vector<Portal>                _portals;
         uint32_t _index;
 
         std::vector<std::unique_ptr<StaticMesh>> _static_meshes;
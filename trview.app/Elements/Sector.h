@@ -10,21 +10,15 @@
 #include "trlevel/trtypes.h"
 #include "trlevel/ILevel.h"
 #include "Types.h" 
+#include "FloorData.h"
 
 namespace trview
 {
-    enum class TriangulationDirection
-    {
-        None,
-        NwSe,
-        NeSw
-    };
-
     class Sector
     {
     public:
-        // Constructs sector object and parses floor data automatically 
-        Sector(const trlevel::ILevel &level, const trlevel::tr3_room& room, const trlevel::tr_room_sector &sector, int sector_id, uint32_t room_number);
+        // Constructs sector object from the decoded floor data for the sector 
+        Sector(const trlevel::ILevel &level, const trlevel::tr3_room& room, const trlevel::tr_room_sector &sector, const FloorDataRecord& floor_data, int sector_id, uint32_t room_number);
 
         // Returns the id of the room that this floor data points to 
         std::uint16_t portal() const; 
@@ -62,8 +56,7 @@ namespace trview
         /// Determines whether this is a walkable floor.
         bool is_floor() const;
     private:
-        bool parse(const trlevel::ILevel& level);
-        void parse_slope();
+        void apply_floor_data(const trlevel::ILevel& level, const FloorDataRecord& floor_data);
         void calculate_neighbours(const trlevel::ILevel& level);
 
         // Holds the "wall portal" that this sector points to - this is the id of the room 
@@ -6,66 +6,6 @@ using namespace Microsoft::WRL;
 
 namespace trview
 {
-    namespace
-    {
-        const std::unordered_map<TriggerType, std::wstring> trigger_type_names
-        {
-            { TriggerType::Trigger, L"Trigger" },
-            { TriggerType::Pad, L"Pad" },
-            { TriggerType::Switch, L"Switch" },
-            { TriggerType::Key, L"Key" },
-            { TriggerType::Pickup, L"Pickup" },
-            { TriggerType::HeavyTrigger, L"Heavy Trigger" },
-            { TriggerType::Antipad, L"Antipad" },
-            { TriggerType::Combat, L"Combat" },
-            { TriggerType::Dummy, L"Dummy" },
-            { TriggerType::AntiTrigger, L"Antitrigger" },
-            { TriggerType::HeavySwitch, L"Heavy Switch" },
-            { TriggerType::HeavyAntiTrigger, L"Heavy Antitrigger" },
-            { TriggerType::Monkey, L"Monkey" },
-            { TriggerType::Skeleton, L"Skeleton" },
-            { TriggerType::Tightrope, L"Tightrope" },
-            { TriggerType::Crawl, L"Crawl" },
-            { TriggerType::Climb, L"Climb"}
-        };
-
-        const std::unordered_map<TriggerCommandType, std::wstring> command_type_names
-        {
-            { TriggerCommandType::Object, L"Object" },
-            { TriggerCommandType::Camera, L"Camera" },
-            { TriggerCommandType::UnderwaterCurrent, L"Current" },
-            { TriggerCommandType::FlipMap, L"Flip Map" },
-            { TriggerCommandType::FlipOn, L"Flip On" },
-            { TriggerCommandType::FlipOff, L"Flip Off" },
-            { TriggerCommandType::LookAtItem, L"Look at Item" },
-            { TriggerCommandType::EndLevel, L"End Level" },
-            { TriggerCommandType::PlaySoundtrack, L"Music" },
-            { TriggerCommandType::Flipeffect, L"Flipeffect" },
-            { TriggerCommandType::SecretFound, L"Secret" },
-            { TriggerCommandType::ClearBodies, L"Clear Bodies" },
-            { TriggerCommandType::Flyby, L"Flyby" },
-            { TriggerCommandType::Cutscene, L"Cutscene" }
-        };
-
-        const std::unordered_map<std::wstring, TriggerCommandType> command_type_lookup
-        {
-            { L"Object", TriggerCommandType::Object },
-            { L"Camera", TriggerCommandType::Camera },
-            { L"Current", TriggerCommandType::UnderwaterCurrent },
-            { L"Flip Map", TriggerCommandType::FlipMap },
-            { L"Flip On", TriggerCommandType::FlipOn },
-            { L"Flip Off", TriggerCommandType::FlipOff },
-            { L"Look at Item", TriggerCommandType::LookAtItem },
-            { L"End Level", TriggerCommandType::EndLevel },
-            { L"Music", TriggerCommandType::PlaySoundtrack },
-            { L"Flipeffect", TriggerCommandType::Flipeffect },
-            { L"Secret", TriggerCommandType::SecretFound },
-            { L"Clear Bodies", TriggerCommandType::ClearBodies },
-            { L"Flyby", TriggerCommandType::Flyby },
-            { L"Cutscene", TriggerCommandType::Cutscene }
-        };
-    }
-
     Command::Command(uint32_t number, TriggerCommandType type, uint16_t index)
         : _number(number), _type(type), _index(index)
     {
@@ -169,6 +109,11 @@ namespace trview
         _mesh = std::make_unique<Mesh>(transparent_triangles, collision);
     }
 
+    DirectX::BoundingBox Trigger::bounding_box() const
+    {
+        return _mesh ? _mesh->bounding_box() : DirectX::BoundingBox(_position, DirectX::SimpleMath::Vector3::Zero);
+    }
+
     PickResult Trigger::pick(const DirectX::SimpleMath::Vector3& position, const DirectX::SimpleMath::Vector3& direction) const
     {
         if (_mesh)
@@ -227,34 +172,4 @@ namespace trview
     {
         _visible = value;
     }
-
-    std::wstring trigger_type_name(TriggerType type)
-    {
-        auto name = trigger_type_names.find(type);
-        if (name == trigger_type_names.end())
-        {
-            return L"Unknown";
-        } 
-        return name->second;
-    }
-
-    std::wstring command_type_name(TriggerCommandType type)
-    {
-        auto name = command_type_names.find(type);
-        if (name == command_type_names.end())
-        {
-            return L"Unknown";
-        }
-        return name->second;
-    }
-
-    TriggerCommandType command_from_name(const std::wstring& name)
-    {
-        auto type = command_type_lookup.find(name);
-        if (type == command_type_lookup.end())
-        {
-            return TriggerCommandType::Object;
-        }
-        return type->second;
-    }
 }
@@ -6,23 +6,10 @@
 #include <trview.app/Geometry/PickResult.h>
 #include <trview.app/Geometry/Mesh.h>
 #include <trview.app/Geometry/IRenderable.h>
+#include <trview.app/Elements/TriggerInfo.h>
 
 namespace trview
 {
-    struct TriggerInfo;
-
-    enum class TriggerType
-    {
-        Trigger, Pad, Switch, Key, Pickup, HeavyTrigger, Antipad, Combat, Dummy,
-        AntiTrigger, HeavySwitch, HeavyAntiTrigger, Monkey, Skeleton, Tightrope, Crawl, Climb
-    };
-
-    enum class TriggerCommandType
-    {
-        Object, Camera, UnderwaterCurrent, FlipMap, FlipOn, FlipOff, LookAtItem,
-        EndLevel, PlaySoundtrack, Flipeffect, SecretFound, ClearBodies, Flyby, Cutscene
-    };
-
     class Command final
     {
     public:
@@ -59,6 +46,9 @@ namespace trview
         const std::vector<TransparentTriangle>& triangles() const;
         void set_triangles(const std::vector<TransparentTriangle>& transparent_triangles);
         PickResult pick(const DirectX::SimpleMath::Vector3& position, const DirectX::SimpleMath::Vector3& direction) const;
+        /// Get the bounding box of the trigger geometry, in world space.
+        /// @returns The bounding box.
+        DirectX::BoundingBox bounding_box() const;
         bool has_command(TriggerCommandType type) const;
         bool has_any_command(const std::vector<TriggerCommandType>& type) const;
         void set_position(const DirectX::SimpleMath::Vector3& position);
@@ -84,19 +74,4 @@ namespace trview
         uint16_t _sector_id;
         bool _visible{ true };
     };
-
-    /// Get the string representation of the trigger type specified.
-    /// @param type The type to test.
-    /// @returns The string version of the enum.
-    std::wstring trigger_type_name(TriggerType type);
-
-    /// Get the string representation of the command type specified.
-    /// @param type The type to test.
-    /// @returns The string version of the enum.
-    std::wstring command_type_name(TriggerCommandType type);
-
-    /// Get the trigger command type from a string.
-    /// @param name The string to convert.
-    /// @returns The trigger command type.
-    TriggerCommandType command_from_name(const std::wstring& name);
 }
\ No newline at end of file
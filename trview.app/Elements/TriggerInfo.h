@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace trview
+{
+    enum class TriggerType
+    {
+        Trigger, Pad, Switch, Key, Pickup, HeavyTrigger, Antipad, Combat, Dummy,
+        AntiTrigger, HeavySwitch, HeavyAntiTrigger, Monkey, Skeleton, Tightrope, Crawl, Climb
+    };
+
+    enum class TriggerCommandType
+    {
+        Object, Camera, UnderwaterCurrent, FlipMap, FlipOn, FlipOff, LookAtItem,
+        EndLevel, PlaySoundtrack, Flipeffect, SecretFound, ClearBodies, Flyby, Cutscene
+    };
+
+    /// A trigger as stored in the floordata.
+    struct TriggerInfo
+    {
+        std::uint8_t timer, oneshot, mask;
+        TriggerType type;
+        uint16_t sector_id;
+        std::vector<std::pair<TriggerCommandType, std::uint16_t>> commands;
+    };
+
+    /// Get the string representation of the trigger type specified.
+    /// @param type The type to test.
+    /// @returns The string version of the enum.
+    std::wstring trigger_type_name(TriggerType type);
+
+    /// Get the string representation of the command type specified.
+    /// @param type The type to test.
+    /// @returns The string version of the enum.
+    std::wstring command_type_name(TriggerCommandType type);
+
+    /// Get the trigger command type from a string.
+    /// @param name The string to convert.
+    /// @returns The trigger command type.
+    TriggerCommandType command_from_name(const std::wstring& name);
+}
@@ -1,7 +1,7 @@
 #pragma once
 
 #include <vector>
-#include <trview.app/Elements/Trigger.h>
+#include <trview.app/Elements/TriggerInfo.h>
 
 namespace trview
 {
@@ -35,13 +35,5 @@ namespace trview
         Bottom = 0x4, 
         Left = 0x8
     };
-
-    struct TriggerInfo
-    {
-        std::uint8_t timer, oneshot, mask;
-        TriggerType type; 
-        uint16_t sector_id;
-        std::vector<std::pair<TriggerCommandType, std::uint16_t>> commands;
-    };
     
 }
\ No newline at end of file
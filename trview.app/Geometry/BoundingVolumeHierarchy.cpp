@@ -0,0 +1,208 @@
+#include "BoundingVolumeHierarchy.h"
+
+#include <numeric>
+
+using namespace DirectX::SimpleMath;
+
+namespace trview
+{
+    namespace
+    {
+        const uint32_t Bins = 12;
+
+        float axis(const Vector3& value, uint32_t index)
+        {
+            return index == 0 ? value.x : (index == 1 ? value.y : value.z);
+        }
+    }
+
+    void BoundingVolumeHierarchy::Bounds::add(const Vector3& point)
+    {
+        minimum = Vector3::Min(minimum, point);
+        maximum = Vector3::Max(maximum, point);
+    }
+
+    void BoundingVolumeHierarchy::Bounds::add(const Bounds& other)
+    {
+        minimum = Vector3::Min(minimum, other.minimum);
+        maximum = Vector3::Max(maximum, other.maximum);
+    }
+
+    float BoundingVolumeHierarchy::Bounds::area() const
+    {
+        if (minimum.x > maximum.x)
+        {
+            return 0.0f;
+        }
+        const Vector3 size = maximum - minimum;
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    BoundingVolumeHierarchy::BoundingVolumeHierarchy(const std::vector<Bounds>& bounds, uint32_t leaf_size)
+    {
+        if (bounds.empty())
+        {
+            return;
+        }
+
+        std::vector<Vector3> centroids;
+        centroids.reserve(bounds.size());
+        for (const auto& item : bounds)
+        {
+            centroids.push_back((item.minimum + item.maximum) * 0.5f);
+        }
+
+        _order.resize(bounds.size());
+        std::iota(_order.begin(), _order.end(), 0u);
+
+        _nodes.reserve(bounds.size() * 2 / std::max(leaf_size, 1u) + 1);
+        build(bounds, centroids, std::max(leaf_size, 1u), 0, static_cast<uint32_t>(bounds.size()), 0);
+    }
+
+    const std::vector<uint32_t>& BoundingVolumeHierarchy::order() const
+    {
+        return _order;
+    }
+
+    void BoundingVolumeHierarchy::save_cache(trlevel::DataWriter& writer) const
+    {
+        writer.write_sized_vector<uint32_t>(_nodes);
+        writer.write_sized_vector<uint32_t>(_order);
+    }
+
+    BoundingVolumeHierarchy BoundingVolumeHierarchy::load_cache(trlevel::DataReader& reader, std::size_t items)
+    {
+        BoundingVolumeHierarchy hierarchy;
+        hierarchy._nodes = reader.read_vector<uint32_t, Node>();
+        hierarchy._order = reader.read_vector<uint32_t, uint32_t>();
+
+        // Traversal trusts the nodes, so check that every child comes after its parent, that leaves stay inside
+        // the order and that the depth fits in the traversal stack.
+        const std::size_t num_nodes = hierarchy._nodes.size();
+        bool valid = hierarchy._order.size() == (num_nodes ? items : 0) &&
+            std::all_of(hierarchy._order.begin(), hierarchy._order.end(), [&](uint32_t index) { return index < items; });
+        std::vector<uint32_t> depth(num_nodes, 0);
+        for (std::size_t i = 0; i < num_nodes && valid; ++i)
+        {
+            const Node& node = hierarchy._nodes[i];
+            if (node.count)
+            {
+                valid = static_cast<uint64_t>(node.start) + node.count <= hierarchy._order.size();
+            }
+            else
+            {
+                valid = i + 1 < num_nodes && node.start > i + 1 && node.start < num_nodes && depth[i] < MaxDepth;
+                if (valid)
+                {
+                    depth[i + 1] = std::max(depth[i + 1], depth[i] + 1);
+                    depth[node.start] = std::max(depth[node.start], depth[i] + 1);
+                }
+            }
+        }
+
+        if (!valid)
+        {
+            throw std::runtime_error("Bounding volume hierarchy is not valid");
+        }
+        return hierarchy;
+    }
+
+    uint32_t BoundingVolumeHierarchy::build(const std::vector<Bounds>& bounds, const std::vector<Vector3>& centroids, uint32_t leaf_size, uint32_t begin, uint32_t end, uint32_t depth)
+    {
+        const uint32_t node_index = static_cast<uint32_t>(_nodes.size());
+        _nodes.push_back({});
+
+        Bounds node_bounds;
+        Bounds centroid_bounds;
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            node_bounds.add(bounds[_order[i]]);
+            centroid_bounds.add(centroids[_order[i]]);
+        }
+        _nodes[node_index].minimum = node_bounds.minimum;
+        _nodes[node_index].maximum = node_bounds.maximum;
+
+        const uint32_t count = end - begin;
+        auto make_leaf = [&]()
+        {
+            _nodes[node_index].start = begin;
+            _nodes[node_index].count = count;
+            return node_index;
+        };
+
+        if (count <= leaf_size || depth >= MaxDepth)
+        {
+            return make_leaf();
+        }
+
+        // Find the split with the lowest surface area heuristic cost by putting the centroids into bins along each axis.
+        float best_cost = FLT_MAX;
+        uint32_t best_axis = 0;
+        uint32_t best_split = 0;
+        for (uint32_t a = 0; a < 3; ++a)
+        {
+            const float low = axis(centroid_bounds.minimum, a);
+            const float extent = axis(centroid_bounds.maximum, a) - low;
+            if (extent <= 0.0f)
+            {
+                continue;
+            }
+
+            Bounds bin_bounds[Bins];
+            uint32_t bin_counts[Bins] = {};
+            const float scale = Bins / extent;
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                const uint32_t bin = std::min(Bins - 1, static_cast<uint32_t>((axis(centroids[_order[i]], a) - low) * scale));
+                bin_bounds[bin].add(bounds[_order[i]]);
+                ++bin_counts[bin];
+            }
+
+            // Sweep from the right to get the cost of everything to the right of each split.
+            float right_costs[Bins];
+            Bounds right;
+            uint32_t right_count = 0;
+            for (uint32_t bin = Bins - 1; bin > 0; --bin)
+            {
+                right.add(bin_bounds[bin]);
+                right_count += bin_counts[bin];
+                right_costs[bin] = right.area() * right_count;
+            }
+
+            Bounds left;
+            uint32_t left_count = 0;
+            for (uint32_t split = 1; split < Bins; ++split)
+            {
+                left.add(bin_bounds[split - 1]);
+                left_count += bin_counts[split - 1];
+                const float cost = left.area() * left_count + right_costs[split];
+                if (left_count && left_count < count && cost < best_cost)
+                {
+                    best_cost = cost;
+                    best_axis = a;
+                    best_split = split;
+                }
+            }
+        }
+
+        // Stop if every centroid is in the same place or splitting would cost more than testing every item.
+        if (best_split == 0 || best_cost >= node_bounds.area() * count)
+        {
+            return make_leaf();
+        }
+
+        const float low = axis(centroid_bounds.minimum, best_axis);
+        const float scale = Bins / (axis(centroid_bounds.maximum, best_axis) - low);
+        const auto middle = std::partition(_order.begin() + begin, _order.begin() + end, [&](uint32_t index)
+        {
+            return std::min(Bins - 1, static_cast<uint32_t>((axis(centroids[index], best_axis) - low) * scale)) < best_split;
+        });
+        const uint32_t split = static_cast<uint32_t>(middle - _order.begin());
+
+        build(bounds, centroids, leaf_size, begin, split, depth + 1);
+        const uint32_t right = build(bounds, centroids, leaf_size, split, end, depth + 1);
+        _nodes[node_index].start = right;
+        _nodes[node_index].count = 0;
+        return node_index;
+    }
+}
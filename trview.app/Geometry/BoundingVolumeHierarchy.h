@@ -0,0 +1,161 @@
+#pragma once
+
+#include <algorithm>
+#include <cfloat>
+#include <cstdint>
+#include <vector>
+#include <SimpleMath.h>
+
+#include <trlevel/DataReader.h>
+#include <trlevel/DataWriter.h>
+
+namespace trview
+{
+    /// Bounding volume hierarchy over a set of boxes. The hierarchy only stores the order of the items, so
+    /// it can be used for anything that has a bounding box - the caller tests the items in each leaf.
+    class BoundingVolumeHierarchy final
+    {
+    public:
+        /// An axis aligned box that starts out empty.
+        struct Bounds
+        {
+            DirectX::SimpleMath::Vector3 minimum{ FLT_MAX, FLT_MAX, FLT_MAX };
+            DirectX::SimpleMath::Vector3 maximum{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+            void add(const DirectX::SimpleMath::Vector3& point);
+            void add(const Bounds& other);
+            float area() const;
+        };
+
+        /// Nodes at this depth are always leaves, so traversal can use a fixed size stack.
+        static const uint32_t MaxDepth = 48;
+
+        /// Create an empty hierarchy that nothing can hit.
+        BoundingVolumeHierarchy() = default;
+
+        /// Build the hierarchy using the surface area heuristic.
+        /// @param bounds The bounds of each item.
+        /// @param leaf_size Nodes with this many items or fewer are not split.
+        BoundingVolumeHierarchy(const std::vector<Bounds>& bounds, uint32_t leaf_size);
+
+        /// Get the items in the order that the leaves refer to them. The items in each leaf are next to each other.
+        /// @returns The index of the item at each position.
+        const std::vector<uint32_t>& order() const;
+
+        /// Write the hierarchy so that it can be loaded again without being built.
+        /// @param writer The writer to write to.
+        void save_cache(trlevel::DataWriter& writer) const;
+
+        /// Load a hierarchy written by save_cache.
+        /// @param reader The reader to read from.
+        /// @param items The number of items that the hierarchy was built from.
+        /// @returns The hierarchy. Throws std::runtime_error if the data is not a valid hierarchy over that many items.
+        static BoundingVolumeHierarchy load_cache(trlevel::DataReader& reader, std::size_t items);
+
+        /// Visit the leaves that a ray passes through, nearer leaves first. Leaves that the ray reaches
+        /// after the nearest distance are skipped.
+        /// @param position The start of the ray.
+        /// @param direction The direction of the ray.
+        /// @param nearest The distance to the nearest hit so far. The visitor lowers this as it finds hits.
+        /// @param visit Called with the first position and the end position in order() of each leaf.
+        template <typename Visit>
+        void traverse(const DirectX::SimpleMath::Vector3& position, const DirectX::SimpleMath::Vector3& direction, float& nearest, Visit&& visit) const;
+    private:
+        /// A node in the hierarchy. The left child of an interior node is the next node, so only the right
+        /// child needs to be stored.
+        struct Node
+        {
+            DirectX::SimpleMath::Vector3 minimum;
+            DirectX::SimpleMath::Vector3 maximum;
+            /// The first position in the order for a leaf, or the right child for an interior node.
+            uint32_t start;
+            /// The number of items in a leaf. Interior nodes have no items.
+            uint32_t count;
+        };
+
+        uint32_t build(const std::vector<Bounds>& bounds, const std::vector<DirectX::SimpleMath::Vector3>& centroids, uint32_t leaf_size, uint32_t begin, uint32_t end, uint32_t depth);
+
+        /// Slab test for a ray against a node's box.
+        /// @param near Set to the distance at which the ray enters the box.
+        /// @returns Whether the ray hits the box nearer than the maximum distance.
+        static bool intersects_box(const Node& node, const DirectX::SimpleMath::Vector3& position, const DirectX::SimpleMath::Vector3& inverse_direction, float max_distance, float& near);
+
+        std::vector<Node> _nodes;
+        std::vector<uint32_t> _order;
+    };
+
+    inline bool BoundingVolumeHierarchy::intersects_box(const Node& node, const DirectX::SimpleMath::Vector3& position, const DirectX::SimpleMath::Vector3& inverse_direction, float max_distance, float& near)
+    {
+        const float x1 = (node.minimum.x - position.x) * inverse_direction.x;
+        const float x2 = (node.maximum.x - position.x) * inverse_direction.x;
+        const float y1 = (node.minimum.y - position.y) * inverse_direction.y;
+        const float y2 = (node.maximum.y - position.y) * inverse_direction.y;
+        const float z1 = (node.minimum.z - position.z) * inverse_direction.z;
+        const float z2 = (node.maximum.z - position.z) * inverse_direction.z;
+        near = std::max(std::max(std::min(x1, x2), std::min(y1, y2)), std::min(z1, z2));
+        const float far = std::min(std::min(std::max(x1, x2), std::max(y1, y2)), std::max(z1, z2));
+        return far >= std::max(near, 0.0f) && near < max_distance;
+    }
+
+    template <typename Visit>
+    void BoundingVolumeHierarchy::traverse(const DirectX::SimpleMath::Vector3& position, const DirectX::SimpleMath::Vector3& direction, float& nearest, Visit&& visit) const
+    {
+        if (_nodes.empty())
+        {
+            return;
+        }
+
+        const DirectX::SimpleMath::Vector3 inverse_direction(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+        float near = 0;
+        if (!intersects_box(_nodes[0], position, inverse_direction, nearest, near))
+        {
+            return;
+        }
+
+        struct Entry
+        {
+            uint32_t node;
+            float near;
+        };
+
+        Entry stack[MaxDepth + 1];
+        uint32_t stack_size = 0;
+        stack[stack_size++] = { 0, near };
+
+        while (stack_size)
+        {
+            // A hit found since the node was pushed may be nearer than the node.
+            const Entry entry = stack[--stack_size];
+            if (entry.near >= nearest)
+            {
+                continue;
+            }
+
+            const Node& node = _nodes[entry.node];
+            if (node.count)
+            {
+                visit(node.start, node.start + node.count);
+                continue;
+            }
+
+            // Visit the nearer child first so that its hits can rule out the further child.
+            Entry children[2] = { { entry.node + 1 }, { node.start } };
+            const bool left_hit = intersects_box(_nodes[children[0].node], position, inverse_direction, nearest, children[0].near);
+            const bool right_hit = intersects_box(_nodes[children[1].node], position, inverse_direction, nearest, children[1].near);
+            if (left_hit && right_hit)
+            {
+                const bool left_first = children[0].near <= children[1].near;
+                stack[stack_size++] = children[left_first ? 1 : 0];
+                stack[stack_size++] = children[left_first ? 0 : 1];
+            }
+            else if (left_hit)
+            {
+                stack[stack_size++] = children[0];
+            }
+            else if (right_hit)
+            {
+                stack[stack_size++] = children[1];
+            }
+        }
+    }
+}
@@ -0,0 +1,317 @@
+#include "CollisionTriangles.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <trview.common/CpuFeatures.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define TRVIEW_COLLISION_SIMD
+#include <immintrin.h>
+#ifdef _MSC_VER
+// MSVC allows AVX2 intrinsics in any function, GCC and Clang have to be told which functions use them.
+#define TRVIEW_TARGET_AVX2
+#else
+#define TRVIEW_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+using namespace DirectX::SimpleMath;
+
+namespace trview
+{
+    namespace
+    {
+        /// The widest batch of triangles that is tested at once. The arrays are padded by this many degenerate
+        /// triangles so that a batch can be loaded from any triangle without reading past the end.
+        const std::size_t MaxLanes = 8;
+
+        /// The coordinates of each component for the triangles, in the order of the components.
+        using ComponentPointers = std::array<const float*, 9>;
+
+        /// Moller-Trumbore test for one triangle. A triangle only faces the ray when the determinant is negative,
+        /// which is the same as the ray being against the triangle normal.
+        bool intersects_triangle(const ComponentPointers& c, std::size_t i, const Vector3& o, const Vector3& d, float& distance)
+        {
+            const float e1x = c[3][i], e1y = c[4][i], e1z = c[5][i];
+            const float e2x = c[6][i], e2y = c[7][i], e2z = c[8][i];
+
+            const float px = d.y * e2z - d.z * e2y;
+            const float py = d.z * e2x - d.x * e2z;
+            const float pz = d.x * e2y - d.y * e2x;
+            const float det = e1x * px + e1y * py + e1z * pz;
+            if (!(det < 0.0f))
+            {
+                return false;
+            }
+
+            const float inverse = 1.0f / det;
+            const float tx = o.x - c[0][i], ty = o.y - c[1][i], tz = o.z - c[2][i];
+            const float u = (tx * px + ty * py + tz * pz) * inverse;
+            if (u < 0.0f || u > 1.0f)
+            {
+                return false;
+            }
+
+            const float qx = ty * e1z - tz * e1y;
+            const float qy = tz * e1x - tx * e1z;
+            const float qz = tx * e1y - ty * e1x;
+            const float v = (d.x * qx + d.y * qy + d.z * qz) * inverse;
+            if (v < 0.0f || u + v > 1.0f)
+            {
+                return false;
+            }
+
+            const float t = (e2x * qx + e2y * qy + e2z * qz) * inverse;
+            if (t < 0.0f || t >= distance)
+            {
+                return false;
+            }
+
+            distance = t;
+            return true;
+        }
+
+        /// Test each triangle in turn. Used when SIMD isn't available.
+        /// @returns The distance to the nearest hit, or the distance passed in if nothing nearer was hit.
+        float intersects_scalar(const ComponentPointers& c, std::size_t begin, std::size_t end, const Vector3& o, const Vector3& d, float distance)
+        {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                intersects_triangle(c, i, o, d, distance);
+            }
+            return distance;
+        }
+
+        std::atomic<CollisionTrianglesPath> forced_path{ CollisionTrianglesPath::Default };
+
+        /// The path to use, taking into account the processor and any path forced by the tests.
+        CollisionTrianglesPath current_path()
+        {
+            const auto forced = forced_path.load(std::memory_order_relaxed);
+            if (forced != CollisionTrianglesPath::Default)
+            {
+                return forced;
+            }
+#ifdef TRVIEW_COLLISION_SIMD
+            return cpu_supports_avx2() ? CollisionTrianglesPath::Avx2 : CollisionTrianglesPath::Sse2;
+#else
+            return CollisionTrianglesPath::Scalar;
+#endif
+        }
+
+#ifdef TRVIEW_COLLISION_SIMD
+        float horizontal_min(__m128 values)
+        {
+            values = _mm_min_ps(values, _mm_shuffle_ps(values, values, _MM_SHUFFLE(2, 3, 0, 1)));
+            values = _mm_min_ps(values, _mm_shuffle_ps(values, values, _MM_SHUFFLE(1, 0, 3, 2)));
+            return _mm_cvtss_f32(values);
+        }
+
+        /// The same test as the scalar version on four triangles at a time.
+        /// @returns The distance to the nearest hit, or the distance passed in if nothing nearer was hit.
+        float intersects_sse2(const ComponentPointers& c, std::size_t begin, std::size_t end, const Vector3& o, const Vector3& d, float distance)
+        {
+            const __m128 dx = _mm_set1_ps(d.x), dy = _mm_set1_ps(d.y), dz = _mm_set1_ps(d.z);
+            const __m128 ox = _mm_set1_ps(o.x), oy = _mm_set1_ps(o.y), oz = _mm_set1_ps(o.z);
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128i lanes = _mm_setr_epi32(0, 1, 2, 3);
+            const __m128i last = _mm_set1_epi32(static_cast<int>(end));
+            __m128 nearest = _mm_set1_ps(distance);
+
+            for (std::size_t i = begin; i < end; i += 4)
+            {
+                const __m128 e1x = _mm_loadu_ps(c[3] + i), e1y = _mm_loadu_ps(c[4] + i), e1z = _mm_loadu_ps(c[5] + i);
+                const __m128 e2x = _mm_loadu_ps(c[6] + i), e2y = _mm_loadu_ps(c[7] + i), e2z = _mm_loadu_ps(c[8] + i);
+
+                const __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+                const __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+                const __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+                const __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+                const __m128 inverse = _mm_div_ps(one, det);
+
+                const __m128 tx = _mm_sub_ps(ox, _mm_loadu_ps(c[0] + i));
+                const __m128 ty = _mm_sub_ps(oy, _mm_loadu_ps(c[1] + i));
+                const __m128 tz = _mm_sub_ps(oz, _mm_loadu_ps(c[2] + i));
+                const __m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, px), _mm_mul_ps(ty, py)), _mm_mul_ps(tz, pz)), inverse);
+
+                const __m128 qx = _mm_sub_ps(_mm_mul_ps(ty, e1z), _mm_mul_ps(tz, e1y));
+                const __m128 qy = _mm_sub_ps(_mm_mul_ps(tz, e1x), _mm_mul_ps(tx, e1z));
+                const __m128 qz = _mm_sub_ps(_mm_mul_ps(tx, e1y), _mm_mul_ps(ty, e1x));
+                const __m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), inverse);
+                const __m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), inverse);
+
+                // Lanes past the end of the range belong to other nodes or are padding.
+                const __m128 in_range = _mm_castsi128_ps(_mm_cmplt_epi32(_mm_add_epi32(lanes, _mm_set1_epi32(static_cast<int>(i))), last));
+                __m128 hit = _mm_and_ps(in_range, _mm_cmplt_ps(det, zero));
+                hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmple_ps(u, one)));
+                hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpge_ps(v, zero), _mm_cmple_ps(_mm_add_ps(u, v), one)));
+                hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpge_ps(t, zero), _mm_cmplt_ps(t, nearest)));
+                nearest = _mm_or_ps(_mm_and_ps(hit, t), _mm_andnot_ps(hit, nearest));
+            }
+            return horizontal_min(nearest);
+        }
+
+        /// The same test as the scalar version on eight triangles at a time.
+        /// @returns The distance to the nearest hit, or the distance passed in if nothing nearer was hit.
+        TRVIEW_TARGET_AVX2
+        float intersects_avx2(const ComponentPointers& c, std::size_t begin, std::size_t end, const Vector3& o, const Vector3& d, float distance)
+        {
+            const __m256 dx = _mm256_set1_ps(d.x), dy = _mm256_set1_ps(d.y), dz = _mm256_set1_ps(d.z);
+            const __m256 ox = _mm256_set1_ps(o.x), oy = _mm256_set1_ps(o.y), oz = _mm256_set1_ps(o.z);
+            const __m256 zero = _mm256_setzero_ps();
+            const __m256 one = _mm256_set1_ps(1.0f);
+            const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+            const __m256i last = _mm256_set1_epi32(static_cast<int>(end));
+            __m256 nearest = _mm256_set1_ps(distance);
+
+            for (std::size_t i = begin; i < end; i += 8)
+            {
+                const __m256 e1x = _mm256_loadu_ps(c[3] + i), e1y = _mm256_loadu_ps(c[4] + i), e1z = _mm256_loadu_ps(c[5] + i);
+                const __m256 e2x = _mm256_loadu_ps(c[6] + i), e2y = _mm256_loadu_ps(c[7] + i), e2z = _mm256_loadu_ps(c[8] + i);
+
+                const __m256 px = _mm256_sub_ps(_mm256_mul_ps(dy, e2z), _mm256_mul_ps(dz, e2y));
+                const __m256 py = _mm256_sub_ps(_mm256_mul_ps(dz, e2x), _mm256_mul_ps(dx, e2z));
+                const __m256 pz = _mm256_sub_ps(_mm256_mul_ps(dx, e2y), _mm256_mul_ps(dy, e2x));
+                const __m256 det = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e1x, px), _mm256_mul_ps(e1y, py)), _mm256_mul_ps(e1z, pz));
+                const __m256 inverse = _mm256_div_ps(one, det);
+
+                const __m256 tx = _mm256_sub_ps(ox, _mm256_loadu_ps(c[0] + i));
+                const __m256 ty = _mm256_sub_ps(oy, _mm256_loadu_ps(c[1] + i));
+                const __m256 tz = _mm256_sub_ps(oz, _mm256_loadu_ps(c[2] + i));
+                const __m256 u = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(tx, px), _mm256_mul_ps(ty, py)), _mm256_mul_ps(tz, pz)), inverse);
+
+                const __m256 qx = _mm256_sub_ps(_mm256_mul_ps(ty, e1z), _mm256_mul_ps(tz, e1y));
+                const __m256 qy = _mm256_sub_ps(_mm256_mul_ps(tz, e1x), _mm256_mul_ps(tx, e1z));
+                const __m256 qz = _mm256_sub_ps(_mm256_mul_ps(tx, e1y), _mm256_mul_ps(ty, e1x));
+                const __m256 v = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, qx), _mm256_mul_ps(dy, qy)), _mm256_mul_ps(dz, qz)), inverse);
+                const __m256 t = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e2x, qx), _mm256_mul_ps(e2y, qy)), _mm256_mul_ps(e2z, qz)), inverse);
+
+                // Lanes past the end of the range belong to other nodes or are padding.
+                const __m256 in_range = _mm256_castsi256_ps(_mm256_cmpgt_epi32(last, _mm256_add_epi32(lanes, _mm256_set1_epi32(static_cast<int>(i)))));
+                __m256 hit = _mm256_and_ps(in_range, _mm256_cmp_ps(det, zero, _CMP_LT_OQ));
+                hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(u, zero, _CMP_GE_OQ), _mm256_cmp_ps(u, one, _CMP_LE_OQ)));
+                hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(v, zero, _CMP_GE_OQ), _mm256_cmp_ps(_mm256_add_ps(u, v), one, _CMP_LE_OQ)));
+                hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(t, zero, _CMP_GE_OQ), _mm256_cmp_ps(t, nearest, _CMP_LT_OQ)));
+                nearest = _mm256_blendv_ps(nearest, t, hit);
+            }
+            return horizontal_min(_mm_min_ps(_mm256_castps256_ps128(nearest), _mm256_extractf128_ps(nearest, 1)));
+        }
+#endif
+    }
+
+    CollisionTriangles::CollisionTriangles(const std::vector<Triangle>& triangles)
+        : _size(triangles.size())
+    {
+        for (auto& component : _components)
+        {
+            component.resize(triangles.size() + MaxLanes);
+        }
+
+        // The padding is left as zero, which makes degenerate triangles that can't be hit.
+        for (std::size_t i = 0; i < triangles.size(); ++i)
+        {
+            const auto& triangle = triangles[i];
+            const Vector3 e1 = triangle.v1 - triangle.v0;
+            const Vector3 e2 = triangle.v2 - triangle.v0;
+            const float values[Components] = { triangle.v0.x, triangle.v0.y, triangle.v0.z, e1.x, e1.y, e1.z, e2.x, e2.y, e2.z };
+            for (std::size_t c = 0; c < Components; ++c)
+            {
+                _components[c][i] = values[c];
+            }
+        }
+    }
+
+    std::size_t CollisionTriangles::size() const
+    {
+        return _size;
+    }
+
+    void CollisionTriangles::save_cache(trlevel::DataWriter& writer) const
+    {
+        writer.write(static_cast<uint64_t>(_size));
+        for (const auto& component : _components)
+        {
+            writer.write_sized_vector<uint32_t>(component);
+        }
+    }
+
+    CollisionTriangles CollisionTriangles::load_cache(trlevel::DataReader& reader)
+    {
+        CollisionTriangles triangles;
+        triangles._size = static_cast<std::size_t>(reader.read<uint64_t>());
+        for (auto& component : triangles._components)
+        {
+            component = reader.read_vector<uint32_t, float>();
+            // The padding has to be there as well, as batches can be loaded from any triangle. Empty sets of
+            // triangles have no padding.
+            const bool empty = triangles._size == 0 && component.empty();
+            if (!empty && component.size() != triangles._size + MaxLanes)
+            {
+                throw std::runtime_error("Collision triangles are not valid");
+            }
+        }
+        return triangles;
+    }
+
+    bool CollisionTriangles::intersects(const Vector3& position, const Vector3& direction, std::size_t begin, std::size_t end, float& distance) const
+    {
+        end = std::min(end, _size);
+        if (begin >= end)
+        {
+            return false;
+        }
+
+        ComponentPointers components;
+        for (std::size_t c = 0; c < Components; ++c)
+        {
+            components[c] = _components[c].data();
+        }
+
+        float nearest = distance;
+        switch (current_path())
+        {
+#ifdef TRVIEW_COLLISION_SIMD
+            case CollisionTrianglesPath::Avx2:
+                nearest = intersects_avx2(components, begin, end, position, direction, distance);
+                break;
+            case CollisionTrianglesPath::Sse2:
+                nearest = intersects_sse2(components, begin, end, position, direction, distance);
+                break;
+#endif
+            default:
+                nearest = intersects_scalar(components, begin, end, position, direction, distance);
+                break;
+        }
+
+        if (nearest < distance)
+        {
+            distance = nearest;
+            return true;
+        }
+        return false;
+    }
+
+    bool collision_triangles_use_avx2()
+    {
+        return current_path() == CollisionTrianglesPath::Avx2;
+    }
+
+    bool force_collision_triangles_path(CollisionTrianglesPath path)
+    {
+#ifdef TRVIEW_COLLISION_SIMD
+        if (path == CollisionTrianglesPath::Avx2 && !cpu_supports_avx2())
+        {
+            return false;
+        }
+#else
+        if (path == CollisionTrianglesPath::Sse2 || path == CollisionTrianglesPath::Avx2)
+        {
+            return false;
+        }
+#endif
+        forced_path = path;
+        return true;
+    }
+}
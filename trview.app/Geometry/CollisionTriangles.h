@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include <SimpleMath.h>
+
+#include <trlevel/DataReader.h>
+#include <trlevel/DataWriter.h>
+
+#include "Triangle.h"
+
+namespace trview
+{
+    /// Collision triangles stored as a structure of arrays so that a ray can be tested against several
+    /// triangles at once. Uses AVX2 when the processor supports it and SSE2 otherwise.
+    class CollisionTriangles final
+    {
+    public:
+        /// Create an empty set of triangles.
+        CollisionTriangles() = default;
+
+        /// Store the triangles, in the same order.
+        /// @param triangles The triangles to store.
+        explicit CollisionTriangles(const std::vector<Triangle>& triangles);
+
+        /// Get the number of triangles.
+        /// @returns The number of triangles.
+        std::size_t size() const;
+
+        /// Write the triangles so that they can be loaded again without being converted.
+        /// @param writer The writer to write to.
+        void save_cache(trlevel::DataWriter& writer) const;
+
+        /// Load triangles written by save_cache.
+        /// @param reader The reader to read from.
+        /// @returns The triangles. Throws std::runtime_error if the components are not all the right size.
+        static CollisionTriangles load_cache(trlevel::DataReader& reader);
+
+        /// Find the nearest triangle in a range that faces the ray and is nearer than a distance.
+        /// @param position The start of the ray.
+        /// @param direction The direction of the ray.
+        /// @param begin The first triangle to test.
+        /// @param end One past the last triangle to test.
+        /// @param distance The distance that a hit has to be nearer than. Set to the distance to the hit, if there is one.
+        /// @returns Whether a nearer triangle was hit.
+        bool intersects(const DirectX::SimpleMath::Vector3& position, const DirectX::SimpleMath::Vector3& direction,
+            std::size_t begin, std::size_t end, float& distance) const;
+    private:
+        /// The first vertex and the two edges from it, one array per coordinate.
+        enum Component
+        {
+            V0X, V0Y, V0Z,
+            E1X, E1Y, E1Z,
+            E2X, E2Y, E2Z,
+            Components
+        };
+
+        std::array<std::vector<float>, Components> _components;
+        std::size_t _size{ 0u };
+    };
+
+    /// The ways that a ray can be tested against the collision triangles.
+    enum class CollisionTrianglesPath
+    {
+        /// AVX2 if the processor supports it, otherwise SSE2, otherwise one triangle at a time.
+        Default,
+        /// One triangle at a time.
+        Scalar,
+        Sse2,
+        Avx2
+    };
+
+    /// Whether the collision triangle tests are able to use AVX2 on this machine.
+    /// @returns True if AVX2 is in use.
+    bool collision_triangles_use_avx2();
+
+    /// Make the collision triangle tests use one path so that the paths can be compared. Only for use in tests.
+    /// @param path The path to use.
+    /// @returns False if this machine can't use the path, in which case the path in use is not changed.
+    bool force_collision_triangles_path(CollisionTrianglesPath path);
+}
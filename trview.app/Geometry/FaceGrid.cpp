@@ -0,0 +1,108 @@
+#include "FaceGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace DirectX::SimpleMath;
+
+namespace trview
+{
+    namespace
+    {
+        bool has_corner(const FaceGrid::Face& face, const Vector3& point)
+        {
+            for (uint32_t i = 0; i < face.count; ++i)
+            {
+                if (face.vertices[i] == point)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+    }
+
+    FaceGrid::FaceGrid(uint32_t width, uint32_t depth, const std::vector<Face>& faces)
+        : _width(std::max(width, 1u)), _depth(std::max(depth, 1u)), _faces(faces), _cell_offsets(_width * _depth + 1, 0)
+    {
+        struct Footprint
+        {
+            uint32_t min_x;
+            uint32_t max_x;
+            uint32_t min_z;
+            uint32_t max_z;
+        };
+
+        // A face is added to every sector that its footprint touches, including along the edges, so a face
+        // that has a point as a corner is always in the sector that the point is in.
+        std::vector<Footprint> footprints;
+        footprints.reserve(_faces.size());
+        for (const auto& face : _faces)
+        {
+            float min_x = face.vertices[0].x;
+            float max_x = face.vertices[0].x;
+            float min_z = face.vertices[0].z;
+            float max_z = face.vertices[0].z;
+            for (uint32_t i = 1; i < face.count; ++i)
+            {
+                min_x = std::min(min_x, face.vertices[i].x);
+                max_x = std::max(max_x, face.vertices[i].x);
+                min_z = std::min(min_z, face.vertices[i].z);
+                max_z = std::max(max_z, face.vertices[i].z);
+            }
+
+            const Footprint footprint{ cell_x(min_x), cell_x(max_x), cell_z(min_z), cell_z(max_z) };
+            for (uint32_t z = footprint.min_z; z <= footprint.max_z; ++z)
+            {
+                for (uint32_t x = footprint.min_x; x <= footprint.max_x; ++x)
+                {
+                    ++_cell_offsets[z * _width + x + 1];
+                }
+            }
+            footprints.push_back(footprint);
+        }
+
+        for (std::size_t i = 1; i < _cell_offsets.size(); ++i)
+        {
+            _cell_offsets[i] += _cell_offsets[i - 1];
+        }
+
+        _cell_faces.resize(_cell_offsets.back());
+        std::vector<uint32_t> next(_cell_offsets.begin(), _cell_offsets.end() - 1);
+        for (uint32_t f = 0; f < footprints.size(); ++f)
+        {
+            const auto& footprint = footprints[f];
+            for (uint32_t z = footprint.min_z; z <= footprint.max_z; ++z)
+            {
+                for (uint32_t x = footprint.min_x; x <= footprint.max_x; ++x)
+                {
+                    _cell_faces[next[z * _width + x]++] = f;
+                }
+            }
+        }
+    }
+
+    bool FaceGrid::contains_triangle(const Vector3* triangle) const
+    {
+        const uint32_t cell = cell_z(triangle[0].z) * _width + cell_x(triangle[0].x);
+        for (uint32_t i = _cell_offsets[cell]; i < _cell_offsets[cell + 1]; ++i)
+        {
+            const auto& face = _faces[_cell_faces[i]];
+            if (has_corner(face, triangle[0]) && has_corner(face, triangle[1]) && has_corner(face, triangle[2]))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint32_t FaceGrid::cell_x(float x) const
+    {
+        return static_cast<uint32_t>(std::clamp(std::floor(x), 0.0f, static_cast<float>(_width - 1)));
+    }
+
+    uint32_t FaceGrid::cell_z(float z) const
+    {
+        return static_cast<uint32_t>(std::clamp(std::floor(z), 0.0f, static_cast<float>(_depth - 1)));
+    }
+}
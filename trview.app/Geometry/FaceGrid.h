@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include <SimpleMath.h>
+
+namespace trview
+{
+    /// Buckets the faces of a room into the sectors of the room by their X/Z footprint, so that finding the
+    /// faces at a position only has to look at the faces in one sector.
+    class FaceGrid final
+    {
+    public:
+        /// The corners of a triangle or rectangle.
+        struct Face
+        {
+            std::array<DirectX::SimpleMath::Vector3, 4> vertices;
+            /// The number of vertices used - 3 for a triangle or 4 for a rectangle.
+            uint32_t count;
+        };
+
+        /// Create the grid. Faces outside of the grid are put in the nearest edge sector.
+        /// @param width The number of sectors along the X axis.
+        /// @param depth The number of sectors along the Z axis.
+        /// @param faces The faces to add, in room space.
+        FaceGrid(uint32_t width, uint32_t depth, const std::vector<Face>& faces);
+
+        /// Determine whether any face has all three points of a triangle as corners.
+        /// @param triangle The three points of the triangle.
+        /// @returns True if a face contains the triangle.
+        bool contains_triangle(const DirectX::SimpleMath::Vector3* triangle) const;
+    private:
+        uint32_t cell_x(float x) const;
+        uint32_t cell_z(float z) const;
+
+        uint32_t _width;
+        uint32_t _depth;
+        std::vector<Face> _faces;
+        /// The start of the faces for each sector in _cell_faces. There is one extra entry at the end.
+        std::vector<uint32_t> _cell_offsets;
+        std::vector<uint32_t> _cell_faces;
+    };
+}
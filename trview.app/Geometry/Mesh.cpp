@@ -32,7 +32,31 @@ namespace trview
         const std::vector<uint32_t>& untextured_indices, 
         const std::vector<TransparentTriangle>& transparent_triangles,
         const std::vector<Triangle>& collision_triangles)
-        : _transparent_triangles(transparent_triangles), _collision_triangles(collision_triangles)
+        : _transparent_triangles(transparent_triangles), _collision(collision_triangles)
+    {
+        create_buffers(device, vertices, indices, untextured_indices);
+
+        // Generate the bounding box for use in picking.
+        calculate_bounding_box(vertices, transparent_triangles);
+    }
+
+    Mesh::Mesh(const graphics::Device& device, const MeshGeometry& geometry)
+        : _transparent_triangles(geometry.transparent_triangles), _collision(geometry.collision)
+    {
+        create_buffers(device, geometry.vertices, geometry.indices, geometry.untextured_indices);
+        calculate_bounding_box(geometry.vertices, geometry.transparent_triangles);
+    }
+
+    Mesh::Mesh(const std::vector<TransparentTriangle>& transparent_triangles, const std::vector<Triangle>& collision_triangles)
+        : _transparent_triangles(transparent_triangles), _collision(collision_triangles)
+    {
+        calculate_bounding_box({}, transparent_triangles);
+    }
+
+    void Mesh::create_buffers(const graphics::Device& device,
+        const std::vector<MeshVertex>& vertices,
+        const std::vector<std::vector<uint32_t>>& indices,
+        const std::vector<uint32_t>& untextured_indices)
     {
         if (!vertices.empty())
         {
@@ -100,15 +124,6 @@ namespace trview
 
             device.device()->CreateBuffer(&matrix_desc, nullptr, &_matrix_buffer);
         }
-
-        // Generate the bounding box for use in picking.
-        calculate_bounding_box(vertices, transparent_triangles);
-    }
-
-    Mesh::Mesh(const std::vector<TransparentTriangle>& transparent_triangles, const std::vector<Triangle>& collision_triangles)
-        : _transparent_triangles(transparent_triangles), _collision_triangles(collision_triangles)
-    {
-        calculate_bounding_box({}, transparent_triangles);
     }
 
     void Mesh::calculate_bounding_box(const std::vector<MeshVertex>& vertices, const std::vector<TransparentTriangle>& transparent_triangles)
@@ -192,20 +207,9 @@ namespace trview
 
     PickResult Mesh::pick(const DirectX::SimpleMath::Vector3& position, const DirectX::SimpleMath::Vector3& direction) const
     {
-        using namespace DirectX::TriangleTests;
-
         PickResult result;
         result.type = PickResult::Type::Mesh;
-        for (const auto& tri : _collision_triangles)
-        {
-            float distance = 0;
-            if (direction.Dot(tri.normal) < 0 &&
-                Intersects(position, direction, tri.v0, tri.v1, tri.v2, distance))
-            {
-                result.hit = true;
-                result.distance = std::min(distance, result.distance);
-            }
-        }
+        result.hit = _collision.intersects(position, direction, result.distance);
 
         // Calculate the world space hit position, if there was a hit.
         if (result.hit)
@@ -218,18 +222,22 @@ namespace trview
 
     std::unique_ptr<Mesh> create_mesh(trlevel::LevelVersion level_version, const trlevel::tr_mesh& mesh, const graphics::Device& device, const ILevelTextureStorage& texture_storage, bool transparent_collision)
     {
-        std::vector<std::vector<uint32_t>> indices(texture_storage.num_tiles());
-        std::vector<MeshVertex> vertices;
-        std::vector<uint32_t> untextured_indices;
-        std::vector<TransparentTriangle> transparent_triangles;
+        return std::make_unique<Mesh>(device, create_mesh_geometry(level_version, mesh, texture_storage, transparent_collision));
+    }
+
+    MeshGeometry create_mesh_geometry(trlevel::LevelVersion level_version, const trlevel::tr_mesh& mesh, const ILevelTextureStorage& texture_storage, bool transparent_collision)
+    {
+        MeshGeometry geometry;
+        geometry.indices.resize(texture_storage.num_tiles());
         std::vector<Triangle> collision_triangles;
 
-        process_textured_rectangles(level_version, mesh.textured_rectangles, mesh.vertices, texture_storage, vertices, indices, transparent_triangles, collision_triangles, transparent_collision);
-        process_textured_triangles(level_version, mesh.textured_triangles, mesh.vertices, texture_storage, vertices, indices, transparent_triangles, collision_triangles, transparent_collision);
-        process_coloured_rectangles(mesh.coloured_rectangles, mesh.vertices, texture_storage, vertices, untextured_indices, collision_triangles);
-        process_coloured_triangles(mesh.coloured_triangles, mesh.vertices, texture_storage, vertices, untextured_indices, collision_triangles);
+        process_textured_rectangles(level_version, mesh.textured_rectangles, mesh.vertices, texture_storage, geometry.vertices, geometry.indices, geometry.transparent_triangles, collision_triangles, transparent_collision);
+        process_textured_triangles(level_version, mesh.textured_triangles, mesh.vertices, texture_storage, geometry.vertices, geometry.indices, geometry.transparent_triangles, collision_triangles, transparent_collision);
+        process_coloured_rectangles(mesh.coloured_rectangles, mesh.vertices, texture_storage, geometry.vertices, geometry.untextured_indices, collision_triangles);
+        process_coloured_triangles(mesh.coloured_triangles, mesh.vertices, texture_storage, geometry.vertices, geometry.untextured_indices, collision_triangles);
 
-        return std::make_unique<Mesh>(device, vertices, indices, untextured_indices, transparent_triangles, collision_triangles);
+        geometry.collision = TriangleBVH(std::move(collision_triangles));
+        return geometry;
     }
 
     std::unique_ptr<Mesh> create_cube_mesh(const graphics::Device& device)
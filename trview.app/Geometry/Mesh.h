@@ -8,9 +8,11 @@
 #include <trlevel/LevelVersion.h>
 #include <trview.graphics/Device.h>
 
+#include "MeshGeometry.h"
 #include "MeshVertex.h"
 #include "TransparentTriangle.h"
 #include "Triangle.h"
+#include "TriangleBVH.h"
 #include <trview.app/Geometry/PickResult.h>
 
 namespace trview
@@ -34,6 +36,11 @@ namespace trview
              const std::vector<TransparentTriangle>& transparent_triangles,
              const std::vector<Triangle>& collision_triangles);
 
+        /// Create the buffers for geometry that has already been built.
+        /// @param device The D3D device to create the mesh.
+        /// @param geometry The geometry for the mesh.
+        Mesh(const graphics::Device& device, const MeshGeometry& geometry);
+
         /// Create a mesh using the specified vertices and indices.
         /// @param transparent_triangles The triangles to use to create the mesh.
         /// @param collision_triangles The triangles for picking.
@@ -51,6 +58,10 @@ namespace trview
 
         PickResult pick(const DirectX::SimpleMath::Vector3& position, const DirectX::SimpleMath::Vector3& direction) const;
     private:
+        void create_buffers(const graphics::Device& device,
+            const std::vector<MeshVertex>& vertices,
+            const std::vector<std::vector<uint32_t>>& indices,
+            const std::vector<uint32_t>& untextured_indices);
         void calculate_bounding_box(const std::vector<MeshVertex>& vertices, const std::vector<TransparentTriangle>& transparent_triangles);
 
         Microsoft::WRL::ComPtr<ID3D11Buffer>              _vertex_buffer;
@@ -60,7 +71,7 @@ namespace trview
         Microsoft::WRL::ComPtr<ID3D11Buffer>              _untextured_index_buffer;
         uint32_t                                          _untextured_index_count;
         std::vector<TransparentTriangle>                  _transparent_triangles;
-        std::vector<Triangle>                             _collision_triangles;
+        TriangleBVH                                       _collision;
         DirectX::BoundingBox                              _bounding_box;
     };
 
@@ -73,6 +84,14 @@ namespace trview
     /// @returns The new mesh.
     std::unique_ptr<Mesh> create_mesh(trlevel::LevelVersion level_version, const trlevel::tr_mesh& mesh, const graphics::Device& device, const ILevelTextureStorage& texture_storage, bool transparent_collision = true);
 
+    /// Build the geometry for a mesh without creating any buffers.
+    /// @param level_version The level version - affects texture index
+    /// @param mesh The level mesh to generate.
+    /// @param texture_storage The textures for the level.
+    /// @param transparent_collision Whether to include transparent triangles in collision triangles.
+    /// @returns The geometry.
+    MeshGeometry create_mesh_geometry(trlevel::LevelVersion level_version, const trlevel::tr_mesh& mesh, const ILevelTextureStorage& texture_storage, bool transparent_collision = true);
+
     /// Create a new cube mesh.
     std::unique_ptr<Mesh> create_cube_mesh(const graphics::Device& device);
 
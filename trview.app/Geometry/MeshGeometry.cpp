@@ -0,0 +1,88 @@
+#include "MeshGeometry.h"
+
+using namespace DirectX::SimpleMath;
+
+namespace trview
+{
+    namespace
+    {
+        void write_transparent_triangle(trlevel::DataWriter& writer, const TransparentTriangle& triangle)
+        {
+            for (const auto& vertex : triangle.vertices)
+            {
+                writer.write(vertex);
+            }
+            for (const auto& uv : triangle.uvs)
+            {
+                writer.write(uv);
+            }
+            writer.write(triangle.texture);
+            writer.write(static_cast<uint32_t>(triangle.mode));
+            writer.write(triangle.colour);
+        }
+
+        TransparentTriangle read_transparent_triangle(trlevel::DataReader& reader)
+        {
+            const auto v0 = reader.read<Vector3>();
+            const auto v1 = reader.read<Vector3>();
+            const auto v2 = reader.read<Vector3>();
+            const auto uv0 = reader.read<Vector2>();
+            const auto uv1 = reader.read<Vector2>();
+            const auto uv2 = reader.read<Vector2>();
+            const auto texture = reader.read<uint32_t>();
+            const auto mode = reader.read<uint32_t>();
+            if (mode > static_cast<uint32_t>(TransparentTriangle::Mode::Additive))
+            {
+                throw std::runtime_error("Transparent triangle mode is not valid");
+            }
+            const auto colour = reader.read<Color>();
+            return TransparentTriangle(v0, v1, v2, uv0, uv1, uv2, texture, static_cast<TransparentTriangle::Mode>(mode), colour);
+        }
+    }
+
+    void MeshGeometry::save_cache(trlevel::DataWriter& writer) const
+    {
+        writer.write_sized_vector<uint32_t>(vertices);
+        writer.write(static_cast<uint32_t>(indices.size()));
+        for (const auto& textile_indices : indices)
+        {
+            writer.write_sized_vector<uint32_t>(textile_indices);
+        }
+        writer.write_sized_vector<uint32_t>(untextured_indices);
+        writer.write(static_cast<uint32_t>(transparent_triangles.size()));
+        for (const auto& triangle : transparent_triangles)
+        {
+            write_transparent_triangle(writer, triangle);
+        }
+        collision.save_cache(writer);
+    }
+
+    MeshGeometry MeshGeometry::load_cache(trlevel::DataReader& reader)
+    {
+        MeshGeometry geometry;
+        geometry.vertices = reader.read_vector<uint32_t, MeshVertex>();
+        const auto num_textiles = reader.read<uint32_t>();
+        for (uint32_t i = 0; i < num_textiles; ++i)
+        {
+            geometry.indices.push_back(reader.read_vector<uint32_t, uint32_t>());
+        }
+        geometry.untextured_indices = reader.read_vector<uint32_t, uint32_t>();
+        const auto num_transparent_triangles = reader.read<uint32_t>();
+        for (uint32_t i = 0; i < num_transparent_triangles; ++i)
+        {
+            geometry.transparent_triangles.push_back(read_transparent_triangle(reader));
+        }
+        geometry.collision = TriangleBVH::load_cache(reader);
+
+        // The indices go straight to the GPU, so they have to be checked before the buffers are created.
+        const auto in_range = [&](const std::vector<uint32_t>& values)
+        {
+            return std::all_of(values.begin(), values.end(), [&](uint32_t index) { return index < geometry.vertices.size(); });
+        };
+        if (!std::all_of(geometry.indices.begin(), geometry.indices.end(), in_range) || !in_range(geometry.untextured_indices))
+        {
+            throw std::runtime_error("Mesh geometry has indices outside of its vertices");
+        }
+        return geometry;
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <trlevel/DataReader.h>
+#include <trlevel/DataWriter.h>
+
+#include "MeshVertex.h"
+#include "TransparentTriangle.h"
+#include "TriangleBVH.h"
+
+namespace trview
+{
+    /// Everything that a mesh is made of apart from the D3D buffers. This is plain data so that it can be built away
+    /// from the device and stored in the level cache.
+    struct MeshGeometry
+    {
+        /// The vertices that make up the mesh.
+        std::vector<MeshVertex> vertices;
+        /// The indices for triangles that use level textures, one list for each textile.
+        std::vector<std::vector<uint32_t>> indices;
+        /// The indices for triangles that do not use level textures.
+        std::vector<uint32_t> untextured_indices;
+        /// The triangles that are drawn with transparency.
+        std::vector<TransparentTriangle> transparent_triangles;
+        /// The triangles for picking.
+        TriangleBVH collision;
+
+        /// Write the geometry so that it can be loaded again without being built.
+        /// @param writer The writer to write to.
+        void save_cache(trlevel::DataWriter& writer) const;
+
+        /// Load geometry written by save_cache.
+        /// @param reader The reader to read from.
+        /// @returns The geometry. Throws std::runtime_error if the geometry is not valid.
+        static MeshGeometry load_cache(trlevel::DataReader& reader);
+    };
+}
@@ -0,0 +1,147 @@
+#include "PortalVisibility.h"
+
+#include <algorithm>
+
+using namespace DirectX::SimpleMath;
+
+namespace trview
+{
+    ScreenRect ScreenRect::whole_screen()
+    {
+        return { -1.0f, -1.0f, 1.0f, 1.0f };
+    }
+
+    bool ScreenRect::empty() const
+    {
+        return min_x >= max_x || min_y >= max_y;
+    }
+
+    void ScreenRect::add(const ScreenRect& other)
+    {
+        min_x = std::min(min_x, other.min_x);
+        min_y = std::min(min_y, other.min_y);
+        max_x = std::max(max_x, other.max_x);
+        max_y = std::max(max_y, other.max_y);
+    }
+
+    void ScreenRect::clip(const ScreenRect& other)
+    {
+        min_x = std::max(min_x, other.min_x);
+        min_y = std::max(min_y, other.min_y);
+        max_x = std::min(max_x, other.max_x);
+        max_y = std::min(max_y, other.max_y);
+    }
+
+    bool ScreenRect::operator==(const ScreenRect& other) const
+    {
+        return min_x == other.min_x && min_y == other.min_y && max_x == other.max_x && max_y == other.max_y;
+    }
+
+    ScreenRect project_portal(const Portal& portal, const Matrix& view_projection, const ScreenRect& window)
+    {
+        ScreenRect result;
+        uint32_t behind = 0;
+        for (const auto& vertex : portal.vertices)
+        {
+            Vector4 clip;
+            Vector3::Transform(vertex, view_projection, clip);
+            if (clip.w <= 0.0001f)
+            {
+                ++behind;
+                continue;
+            }
+            const float x = clip.x / clip.w;
+            const float y = clip.y / clip.w;
+            result.add({ x, y, x, y });
+        }
+
+        if (behind == portal.vertices.size())
+        {
+            return ScreenRect();
+        }
+
+        // A portal that crosses the plane of the camera could cover any part of the window.
+        if (behind)
+        {
+            return window;
+        }
+
+        result.clip(window);
+        return result;
+    }
+
+    std::vector<bool> rooms_seen_through_portals(const std::vector<PortalRoom>& rooms, const Vector3& position, const Matrix& view_projection)
+    {
+        // The camera can be in more than one room where rooms overlap, so start from all of them.
+        std::vector<ScreenRect> windows(rooms.size());
+        std::vector<uint16_t> to_visit;
+        for (uint16_t i = 0; i < rooms.size(); ++i)
+        {
+            if (rooms[i].shown && rooms[i].contains_camera)
+            {
+                windows[i] = ScreenRect::whole_screen();
+                to_visit.push_back(i);
+            }
+        }
+
+        // The camera is outside of the level, so every room could be seen.
+        if (to_visit.empty())
+        {
+            return {};
+        }
+
+        while (!to_visit.empty())
+        {
+            const uint16_t index = to_visit.back();
+            to_visit.pop_back();
+            const ScreenRect window = windows[index];
+            if (!rooms[index].portals)
+            {
+                continue;
+            }
+
+            for (const auto& portal : *rooms[index].portals)
+            {
+                // Portals face into the room that they belong to, so they can only be seen through from that side.
+                if (portal.normal.Dot(position - portal.vertices[0]) <= 0)
+                {
+                    continue;
+                }
+
+                // Portals lead to the original room, so use the alternate room instead if that is the one being shown.
+                uint16_t next = portal.room;
+                if (next >= rooms.size())
+                {
+                    continue;
+                }
+                if (!rooms[next].shown && rooms[next].shown_instead != -1)
+                {
+                    next = static_cast<uint16_t>(rooms[next].shown_instead);
+                }
+
+                const ScreenRect through = project_portal(portal, view_projection, window);
+                if (through.empty())
+                {
+                    continue;
+                }
+
+                // Only look through the room again if more of it can be seen than before. Windows only ever
+                // grow and are built from a limited set of corners, so loops of portals always end.
+                ScreenRect merged = windows[next];
+                merged.add(through);
+                if (!(merged == windows[next]))
+                {
+                    windows[next] = merged;
+                    to_visit.push_back(next);
+                }
+            }
+        }
+
+        std::vector<bool> seen(rooms.size());
+        for (std::size_t i = 0; i < rooms.size(); ++i)
+        {
+            seen[i] = !windows[i].empty();
+        }
+        return seen;
+    }
+}
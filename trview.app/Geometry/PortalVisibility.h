@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <cfloat>
+#include <cstdint>
+#include <vector>
+#include <SimpleMath.h>
+
+namespace trview
+{
+    /// An opening from one room into another.
+    struct Portal
+    {
+        /// The room that can be seen through the portal.
+        uint16_t room;
+        /// The direction that the portal faces. This points into the room that the portal belongs to.
+        DirectX::SimpleMath::Vector3 normal;
+        /// The corners of the portal in world space.
+        std::array<DirectX::SimpleMath::Vector3, 4> vertices;
+    };
+
+    /// An area of the screen in normalised device coordinates.
+    struct ScreenRect
+    {
+        float min_x{ FLT_MAX };
+        float min_y{ FLT_MAX };
+        float max_x{ -FLT_MAX };
+        float max_y{ -FLT_MAX };
+
+        static ScreenRect whole_screen();
+
+        bool empty() const;
+
+        /// Grow the area to include another area.
+        void add(const ScreenRect& other);
+
+        /// Shrink the area to the part that is inside another area.
+        void clip(const ScreenRect& other);
+
+        bool operator==(const ScreenRect& other) const;
+    };
+
+    /// Find the part of the window that can be seen through a portal.
+    /// @param portal The portal to look through.
+    /// @param view_projection The view projection matrix of the camera.
+    /// @param window The part of the screen that the portal is being looked at through.
+    /// @returns The area of the screen covered by the portal, clipped to the window. This is empty if the portal can't be seen.
+    ScreenRect project_portal(const Portal& portal, const DirectX::SimpleMath::Matrix& view_projection, const ScreenRect& window);
+
+    /// What the portal flood needs to know about a room.
+    struct PortalRoom
+    {
+        /// The portals that lead out of the room.
+        const std::vector<Portal>* portals{ nullptr };
+        /// Whether the camera is inside the room.
+        bool contains_camera{ false };
+        /// Whether the room is shown. Rooms that have been flipped out are not shown.
+        bool shown{ true };
+        /// The room that is shown instead of this room when it is not shown, or -1 if there isn't one.
+        int16_t shown_instead{ -1 };
+    };
+
+    /// Find the rooms that can be seen from a camera by looking through the portals of the rooms that the camera is in.
+    /// Each portal is clipped to the part of the screen that it is seen through and portals that face away from the
+    /// camera are skipped.
+    /// @param rooms The rooms of the level.
+    /// @param position The position of the camera.
+    /// @param view_projection The view projection matrix of the camera.
+    /// @returns Whether each room can be seen, or an empty list if the camera is not inside a shown room.
+    std::vector<bool> rooms_seen_through_portals(const std::vector<PortalRoom>& rooms, const DirectX::SimpleMath::Vector3& position,
+        const DirectX::SimpleMath::Matrix& view_projection);
+}
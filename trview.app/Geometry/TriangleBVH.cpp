@@ -0,0 +1,75 @@
+#include "TriangleBVH.h"
+
+using namespace DirectX::SimpleMath;
+
+namespace trview
+{
+    namespace
+    {
+        /// Leaves are tested eight triangles at a time, so there is no benefit to making them smaller.
+        const uint32_t LeafTriangles = 8;
+    }
+
+    TriangleBVH::TriangleBVH(std::vector<Triangle> triangles)
+    {
+        if (triangles.empty())
+        {
+            return;
+        }
+
+        std::vector<BoundingVolumeHierarchy::Bounds> bounds(triangles.size());
+        for (std::size_t i = 0; i < triangles.size(); ++i)
+        {
+            const auto& triangle = triangles[i];
+            bounds[i].add(triangle.v0);
+            bounds[i].add(triangle.v1);
+            bounds[i].add(triangle.v2);
+        }
+
+        // Triangles are grouped by leaf while building, so put them into their new order afterwards.
+        _hierarchy = BoundingVolumeHierarchy(bounds, LeafTriangles);
+
+        std::vector<Triangle> ordered;
+        ordered.reserve(triangles.size());
+        for (const auto index : _hierarchy.order())
+        {
+            ordered.push_back(triangles[index]);
+        }
+        _triangles = CollisionTriangles(ordered);
+    }
+
+    bool TriangleBVH::intersects(const Vector3& position, const Vector3& direction, float& distance) const
+    {
+        float nearest = FLT_MAX;
+        bool hit = false;
+        _hierarchy.traverse(position, direction, nearest, [&](uint32_t begin, uint32_t end)
+        {
+            hit |= _triangles.intersects(position, direction, begin, end, nearest);
+        });
+
+        if (hit)
+        {
+            distance = nearest;
+        }
+        return hit;
+    }
+
+    std::size_t TriangleBVH::size() const
+    {
+        return _triangles.size();
+    }
+
+    void TriangleBVH::save_cache(trlevel::DataWriter& writer) const
+    {
+        _triangles.save_cache(writer);
+        _hierarchy.save_cache(writer);
+    }
+
+    TriangleBVH TriangleBVH::load_cache(trlevel::DataReader& reader)
+    {
+        TriangleBVH bvh;
+        bvh._triangles = CollisionTriangles::load_cache(reader);
+        bvh._hierarchy = BoundingVolumeHierarchy::load_cache(reader, bvh._triangles.size());
+        return bvh;
+    }
+}
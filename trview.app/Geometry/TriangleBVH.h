@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <SimpleMath.h>
+
+#include "BoundingVolumeHierarchy.h"
+#include "CollisionTriangles.h"
+#include "Triangle.h"
+
+namespace trview
+{
+    /// Bounding volume hierarchy over a set of collision triangles, used to find the nearest triangle
+    /// hit by a ray without testing every triangle.
+    class TriangleBVH final
+    {
+    public:
+        /// Create an empty hierarchy that nothing can hit.
+        TriangleBVH() = default;
+
+        /// Build the hierarchy using the surface area heuristic. The triangles are reordered so that
+        /// the triangles in each leaf are next to each other.
+        /// @param triangles The triangles to build the hierarchy from.
+        explicit TriangleBVH(std::vector<Triangle> triangles);
+
+        /// Find the nearest triangle that faces the ray.
+        /// @param position The start of the ray.
+        /// @param direction The direction of the ray.
+        /// @param distance Set to the distance to the nearest hit, if there is one.
+        /// @returns Whether a triangle was hit.
+        bool intersects(const DirectX::SimpleMath::Vector3& position, const DirectX::SimpleMath::Vector3& direction, float& distance) const;
+
+        /// Get the number of triangles in the hierarchy.
+        /// @returns The number of triangles.
+        std::size_t size() const;
+
+        /// Write the hierarchy and its triangles so that they can be loaded again without being built.
+        /// @param writer The writer to write to.
+        void save_cache(trlevel::DataWriter& writer) const;
+
+        /// Load a hierarchy written by save_cache.
+        /// @param reader The reader to read from.
+        /// @returns The hierarchy. Throws std::runtime_error if the data is not valid.
+        static TriangleBVH load_cache(trlevel::DataReader& reader);
+    private:
+        BoundingVolumeHierarchy _hierarchy;
+        CollisionTriangles _triangles;
+    };
+}
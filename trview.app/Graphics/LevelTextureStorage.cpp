@@ -6,9 +6,10 @@ namespace trview
     LevelTextureStorage::LevelTextureStorage(const graphics::Device& device, const trlevel::ILevel& level)
         : _device(device), _texture_storage(std::make_unique<TextureStorage>(device)), _version(level.get_version())
     {
+        std::vector<uint32_t> data;
         for (uint32_t i = 0; i < level.num_textiles(); ++i)
         {
-            std::vector<uint32_t> data = level.get_textile(i);
+            level.get_textile(i, data);
             _tiles.emplace_back(device, 256, 256, data);
         }
 
@@ -3,14 +3,15 @@
 namespace trview
 {
     MeshStorage::MeshStorage(const graphics::Device& device, const trlevel::ILevel& level, const ILevelTextureStorage& texture_storage)
-        : _device(device), _texture_storage(texture_storage)
+        : MeshStorage(device, create_mesh_geometry(level, texture_storage))
     {
-        const uint32_t pointers = level.num_mesh_pointers();
-        for (uint32_t i = 0; i < pointers; ++i)
+    }
+
+    MeshStorage::MeshStorage(const graphics::Device& device, const std::vector<MeshGeometry>& meshes)
+    {
+        for (uint32_t i = 0; i < meshes.size(); ++i)
         {
-            auto level_mesh = level.get_mesh_by_pointer(i);
-            auto new_mesh = create_mesh(level.get_version(), level_mesh, _device, _texture_storage);
-            _meshes.insert({ i, std::move(new_mesh) });
+            _meshes.insert({ i, std::make_unique<Mesh>(device, meshes[i]) });
         }
     }
 
@@ -23,4 +24,15 @@ namespace trview
         }
         return nullptr;
     }
+
+    std::vector<MeshGeometry> create_mesh_geometry(const trlevel::ILevel& level, const ILevelTextureStorage& texture_storage)
+    {
+        std::vector<MeshGeometry> meshes;
+        const uint32_t pointers = level.num_mesh_pointers();
+        for (uint32_t i = 0; i < pointers; ++i)
+        {
+            meshes.push_back(create_mesh_geometry(level.get_version(), level.mesh(i), texture_storage));
+        }
+        return meshes;
+    }
 }
@@ -5,11 +5,13 @@
 #include <unordered_map>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include <trlevel/ILevel.h>
 
 #include "IMeshStorage.h"
 #include <trview.app/Geometry/Mesh.h>
+#include <trview.app/Geometry/MeshGeometry.h>
 #include <trview.graphics/Device.h>
 
 namespace trview
@@ -21,12 +23,21 @@ namespace trview
     public:
         explicit MeshStorage(const graphics::Device& device, const trlevel::ILevel& level, const ILevelTextureStorage& texture_storage);
 
+        /// Create the meshes from geometry that has already been built.
+        /// @param device The device to create the meshes with.
+        /// @param meshes The geometry for each mesh pointer.
+        explicit MeshStorage(const graphics::Device& device, const std::vector<MeshGeometry>& meshes);
+
         virtual ~MeshStorage() = default;
 
         virtual Mesh* mesh(uint32_t mesh_pointer) const override;
     private:
-        const graphics::Device& _device;
-        const ILevelTextureStorage& _texture_storage;
         mutable std::unordered_map<uint32_t, std::unique_ptr<Mesh>> _meshes;
     };
+
+    /// Build the geometry for every mesh pointer in the level without creating any buffers.
+    /// @param level The level to build the meshes for.
+    /// @param texture_storage The textures for the level.
+    /// @returns The geometry for each mesh pointer.
+    std::vector<MeshGeometry> create_mesh_geometry(const trlevel::ILevel& level, const ILevelTextureStorage& texture_storage);
 }
@@ -1,5 +1,7 @@
 #include "UserSettings.h"
 
+#include <trview.common/Strings.h>
+
 namespace trview
 {
     namespace
@@ -135,4 +137,14 @@ namespace trview
         {
         }
     }
+
+    std::string level_cache_directory()
+    {
+        SafePath path;
+        if (S_OK != SHGetKnownFolderPath(FOLDERID_LocalAppData, 0, nullptr, &path.path))
+        {
+            return std::string();
+        }
+        return to_utf8(std::wstring(path.path) + L"\\trview\\cache");
+    }
 }
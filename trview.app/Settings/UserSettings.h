@@ -30,5 +30,9 @@ namespace trview
 
     // Save the user settings to the settings file.
     void         save_user_settings(const UserSettings& settings);
+
+    // Get the directory that parsed levels are cached in. This is next to the settings file.
+    // Returns: The directory, or an empty string if the directory could not be found.
+    std::string  level_cache_directory();
 }
 
@@ -0,0 +1,111 @@
+#include "gtest/gtest.h"
+#include <trview.common/ThreadPool.h>
+#include <chrono>
+
+using namespace trview;
+
+/// Tests that all tasks added to a task group are run before wait returns.
+TEST(TaskGroup, RunsAllTasks)
+{
+    ThreadPool pool(4);
+    std::atomic<int> count{ 0 };
+
+    TaskGroup group(pool);
+    for (int i = 0; i < 100; ++i)
+    {
+        group.run([&]() { ++count; });
+    }
+    group.wait();
+
+    ASSERT_EQ(100, count);
+}
+
+/// Tests that an exception thrown by a task is rethrown by wait.
+TEST(TaskGroup, WaitRethrowsException)
+{
+    ThreadPool pool(2);
+    TaskGroup group(pool);
+    group.run([]() { throw std::runtime_error("failed"); });
+    group.run([]() {});
+    ASSERT_THROW(group.wait(), std::runtime_error);
+}
+
+/// Tests that tasks that have finished are removed when another task is added, so that a group that is
+/// never waited on does not keep growing.
+TEST(TaskGroup, RunRemovesFinishedTasks)
+{
+    ThreadPool pool(2);
+    std::atomic<int> count{ 0 };
+
+    TaskGroup group(pool);
+    for (int i = 0; i < 10; ++i)
+    {
+        group.run([&]() { ++count; });
+    }
+    while (count < 10)
+    {
+        std::this_thread::yield();
+    }
+
+    // The tasks are marked as finished just after they have run, so give them a moment.
+    for (int attempt = 0; attempt < 100 && group.size() > 1; ++attempt)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        group.run([&]() { ++count; });
+    }
+    ASSERT_EQ(1u, group.size());
+    group.wait();
+}
+
+/// Tests that an exception thrown by a task that was removed by run is still rethrown by wait.
+TEST(TaskGroup, WaitRethrowsExceptionFromRemovedTask)
+{
+    ThreadPool pool(1);
+    std::atomic<bool> thrown{ false };
+
+    TaskGroup group(pool);
+    group.run([&]() { thrown = true; throw std::runtime_error("failed"); });
+    while (!thrown)
+    {
+        std::this_thread::yield();
+    }
+
+    // Once only the newest task is left the task that threw has been removed.
+    int attempt = 0;
+    do
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        group.run([]() {});
+    } while (group.size() > 1 && ++attempt < 100);
+    ASSERT_EQ(1u, group.size());
+    ASSERT_THROW(group.wait(), std::runtime_error);
+    ASSERT_NO_THROW(group.wait());
+}
+
+/// Tests that parallel_for calls the function exactly once for every index.
+TEST(ParallelFor, CallsEveryIndexOnce)
+{
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> calls(1000);
+
+    parallel_for(pool, calls.size(), [&](std::size_t index) { ++calls[index]; });
+
+    for (const auto& value : calls)
+    {
+        ASSERT_EQ(1, value);
+    }
+}
+
+/// Tests that a parallel_for inside a task does not deadlock when every thread in the pool is busy.
+TEST(ParallelFor, NestedDoesNotDeadlock)
+{
+    ThreadPool pool(1);
+    std::atomic<int> count{ 0 };
+
+    parallel_for(pool, 4, [&](std::size_t)
+    {
+        parallel_for(pool, 4, [&](std::size_t) { ++count; });
+    });
+
+    ASSERT_EQ(16, count);
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+namespace trview
+{
+    /// Whether the processor supports AVX2 and the operating system saves the AVX registers. The result is
+    /// worked out the first time this is called.
+    /// @returns True if AVX2 instructions can be used.
+    bool cpu_supports_avx2();
+}
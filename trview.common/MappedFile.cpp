@@ -0,0 +1,121 @@
+#include "MappedFile.h"
+#include "Strings.h"
+
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace trview
+{
+#ifdef _WIN32
+    MappedFile::MappedFile(const std::string& filename)
+    {
+        _file = CreateFile(to_utf16(filename).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (_file == INVALID_HANDLE_VALUE)
+        {
+            _file = nullptr;
+            throw std::runtime_error("File could not be opened");
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(_file, &size))
+        {
+            CloseHandle(_file);
+            throw std::runtime_error("File size could not be read");
+        }
+        _size = static_cast<std::size_t>(size.QuadPart);
+
+        // Empty files cannot be mapped, but they are valid - they just have no data.
+        if (_size == 0)
+        {
+            return;
+        }
+
+        _mapping = CreateFileMapping(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!_mapping)
+        {
+            CloseHandle(_file);
+            throw std::runtime_error("File could not be mapped");
+        }
+
+        _data = static_cast<const uint8_t*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!_data)
+        {
+            CloseHandle(_mapping);
+            CloseHandle(_file);
+            throw std::runtime_error("File could not be mapped");
+        }
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (_data)
+        {
+            UnmapViewOfFile(_data);
+        }
+        if (_mapping)
+        {
+            CloseHandle(_mapping);
+        }
+        if (_file)
+        {
+            CloseHandle(_file);
+        }
+    }
+#else
+    MappedFile::MappedFile(const std::string& filename)
+    {
+        _file = open(filename.c_str(), O_RDONLY);
+        if (_file == -1)
+        {
+            throw std::runtime_error("File could not be opened");
+        }
+
+        struct stat info;
+        if (fstat(_file, &info) != 0)
+        {
+            close(_file);
+            throw std::runtime_error("File size could not be read");
+        }
+        _size = static_cast<std::size_t>(info.st_size);
+
+        // Empty files cannot be mapped, but they are valid - they just have no data.
+        if (_size == 0)
+        {
+            return;
+        }
+
+        void* mapping = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _file, 0);
+        if (mapping == MAP_FAILED)
+        {
+            close(_file);
+            throw std::runtime_error("File could not be mapped");
+        }
+        _data = static_cast<const uint8_t*>(mapping);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (_data)
+        {
+            munmap(const_cast<uint8_t*>(_data), _size);
+        }
+        close(_file);
+    }
+#endif
+
+    const uint8_t* MappedFile::data() const
+    {
+        return _data;
+    }
+
+    std::size_t MappedFile::size() const
+    {
+        return _size;
+    }
+}
@@ -0,0 +1,45 @@
+/// @file MappedFile.h
+/// @brief Maps the contents of a file into memory for reading.
+///
+/// Read only view of a file that is backed by the operating system page cache, so that
+/// parsers can read from the file without copying it into a buffer first.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace trview
+{
+    /// Read only memory mapping of an entire file.
+    class MappedFile final
+    {
+    public:
+        /// Map the specified file into memory.
+        /// @param filename The UTF-8 path of the file to map.
+        /// @remarks Throws std::runtime_error if the file could not be opened or mapped.
+        explicit MappedFile(const std::string& filename);
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        ~MappedFile();
+
+        /// Get the start of the mapped file.
+        /// @returns The first byte of the file. This will be null if the file is empty.
+        const uint8_t* data() const;
+
+        /// Get the size of the mapped file.
+        /// @returns The size of the file in bytes.
+        std::size_t size() const;
+    private:
+        const uint8_t* _data{ nullptr };
+        std::size_t _size{ 0u };
+#ifdef _WIN32
+        void* _file{ nullptr };
+        void* _mapping{ nullptr };
+#else
+        int _file{ -1 };
+#endif
+    };
+}
@@ -1,7 +1,17 @@
 #include "Strings.h"
 
+#include <bitset>
+#include <sstream>
+#include <vector>
+
+#ifndef _WIN32
+#include <codecvt>
+#include <locale>
+#endif
+
 namespace trview
 {
+#ifdef _WIN32
     std::string to_utf8(const std::wstring& value)
     {
         std::vector<char> output(WideCharToMultiByte(CP_UTF8, 0, value.c_str(), -1, nullptr, 0, nullptr, nullptr), 0);
@@ -21,6 +31,17 @@ namespace trview
         }
         return &output[0];
     }
+#else
+    std::string to_utf8(const std::wstring& value)
+    {
+        return std::wstring_convert<std::codecvt_utf8<wchar_t>>().to_bytes(value);
+    }
+
+    std::wstring to_utf16(const std::string& value)
+    {
+        return std::wstring_convert<std::codecvt_utf8<wchar_t>>().from_bytes(value);
+    }
+#endif
 
     std::wstring format_bool(bool value)
     {
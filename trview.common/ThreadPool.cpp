@@ -0,0 +1,185 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace trview
+{
+    ThreadPool::ThreadPool(std::size_t threads)
+    {
+        threads = std::max<std::size_t>(threads, 1u);
+        for (std::size_t i = 0; i < threads; ++i)
+        {
+            _threads.emplace_back([this]() { worker(); });
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _condition.notify_all();
+        for (auto& thread : _threads)
+        {
+            thread.join();
+        }
+    }
+
+    void ThreadPool::enqueue(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _tasks.push_back(std::move(task));
+        }
+        _condition.notify_one();
+    }
+
+    std::size_t ThreadPool::size() const
+    {
+        return _threads.size();
+    }
+
+    ThreadPool& ThreadPool::shared()
+    {
+        static ThreadPool pool(std::thread::hardware_concurrency());
+        return pool;
+    }
+
+    void ThreadPool::worker()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _condition.wait(lock, [this]() { return _stopping || !_tasks.empty(); });
+                if (_tasks.empty())
+                {
+                    return;
+                }
+                task = std::move(_tasks.front());
+                _tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    void TaskGroup::Task::execute()
+    {
+        if (claimed.exchange(true))
+        {
+            return;
+        }
+
+        try
+        {
+            function();
+        }
+        catch (...)
+        {
+            exception = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished = true;
+        }
+        condition.notify_all();
+    }
+
+    TaskGroup::TaskGroup(ThreadPool& pool)
+        : _pool(pool)
+    {
+    }
+
+    TaskGroup::~TaskGroup()
+    {
+        try
+        {
+            wait();
+        }
+        catch (...)
+        {
+        }
+    }
+
+    void TaskGroup::run(std::function<void()> task)
+    {
+        // Keep the first exception from a finished task so that wait can still rethrow it.
+        const auto finished = std::remove_if(_tasks.begin(), _tasks.end(), [&](const auto& existing)
+        {
+            std::lock_guard<std::mutex> lock(existing->mutex);
+            if (existing->finished && existing->exception && !_exception)
+            {
+                _exception = existing->exception;
+            }
+            return existing->finished;
+        });
+        _tasks.erase(finished, _tasks.end());
+
+        auto entry = std::make_shared<Task>();
+        entry->function = std::move(task);
+        _tasks.push_back(entry);
+        _pool.enqueue([entry]() { entry->execute(); });
+    }
+
+    std::size_t TaskGroup::size() const
+    {
+        return _tasks.size();
+    }
+
+    void TaskGroup::wait()
+    {
+        // Help out with any tasks that haven't been picked up by the pool yet - this means that waiting
+        // from inside a pool thread can't deadlock.
+        for (auto& task : _tasks)
+        {
+            task->execute();
+        }
+
+        std::exception_ptr exception = _exception;
+        _exception = nullptr;
+        for (auto& task : _tasks)
+        {
+            std::unique_lock<std::mutex> lock(task->mutex);
+            task->condition.wait(lock, [&]() { return task->finished; });
+            if (task->exception && !exception)
+            {
+                exception = task->exception;
+            }
+        }
+        _tasks.clear();
+
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+
+    void parallel_for(ThreadPool& pool, std::size_t count, const std::function<void(std::size_t)>& function)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        std::atomic<std::size_t> next{ 0u };
+        auto worker = [&]()
+        {
+            for (auto index = next++; index < count; index = next++)
+            {
+                function(index);
+            }
+        };
+
+        TaskGroup group(pool);
+        const auto workers = std::min<std::size_t>(count, pool.size() + 1) - 1;
+        for (std::size_t i = 0; i < workers; ++i)
+        {
+            group.run(worker);
+        }
+        worker();
+        group.wait();
+    }
+}
@@ -0,0 +1,111 @@
+/// @file ThreadPool.h
+/// @brief Fixed set of worker threads that run queued tasks.
+///
+/// Tasks are grouped with a TaskGroup so that the caller can wait for a set of tasks to finish. A thread that waits
+/// on a group will run any of the group's tasks that have not started yet, so groups can be waited on from inside
+/// other tasks without the pool deadlocking.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace trview
+{
+    /// Fixed set of worker threads that run queued tasks.
+    class ThreadPool final
+    {
+    public:
+        /// Create a thread pool.
+        /// @param threads The number of worker threads to create. At least one thread will be created.
+        explicit ThreadPool(std::size_t threads);
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /// Waits for the worker threads to finish their queued tasks.
+        ~ThreadPool();
+
+        /// Add a task to the queue. The task will be run on one of the worker threads.
+        /// @param task The task to run.
+        void enqueue(std::function<void()> task);
+
+        /// Get the number of worker threads.
+        /// @returns The number of threads.
+        std::size_t size() const;
+
+        /// Get the thread pool shared by the application. This has one thread per hardware thread.
+        /// @returns The shared thread pool.
+        static ThreadPool& shared();
+    private:
+        void worker();
+
+        std::vector<std::thread> _threads;
+        std::deque<std::function<void()>> _tasks;
+        std::mutex _mutex;
+        std::condition_variable _condition;
+        bool _stopping{ false };
+    };
+
+    /// A set of tasks that can be waited on together.
+    class TaskGroup final
+    {
+    public:
+        /// Create a task group that runs tasks on the specified pool.
+        /// @param pool The pool to use.
+        explicit TaskGroup(ThreadPool& pool);
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        /// Waits for all tasks in the group to finish. Any exceptions are discarded - call wait
+        /// to find out whether a task failed.
+        ~TaskGroup();
+
+        /// Add a task to the group. Tasks that have already finished are removed from the group, so a group that is
+        /// only waited on when it is destroyed does not keep every task that it has run.
+        /// @param task The task to run.
+        void run(std::function<void()> task);
+
+        /// Get the number of tasks in the group that have not been removed by run or wait.
+        /// @returns The number of tasks.
+        std::size_t size() const;
+
+        /// Wait for all tasks in the group to finish. Tasks that have not started will be run on this thread.
+        /// If any task threw an exception the first exception will be rethrown once all of the tasks are finished.
+        void wait();
+    private:
+        struct Task
+        {
+            std::function<void()> function;
+            std::atomic<bool> claimed{ false };
+            bool finished{ false };
+            std::exception_ptr exception;
+            std::mutex mutex;
+            std::condition_variable condition;
+
+            /// Run the task if no other thread has started it.
+            void execute();
+        };
+
+        ThreadPool& _pool;
+        std::vector<std::shared_ptr<Task>> _tasks;
+        /// The first exception thrown by a task that was removed before wait was called.
+        std::exception_ptr _exception;
+    };
+
+    /// Call a function for every index in a range, spreading the calls over the thread pool. Returns
+    /// once all of the calls have finished.
+    /// @param pool The pool to use.
+    /// @param count The number of indices.
+    /// @param function The function to call with each index.
+    void parallel_for(ThreadPool& pool, std::size_t count, const std::function<void (std::size_t)>& function);
+}
@@ -0,0 +1,248 @@
+#include "gtest/gtest.h"
+#include <trview.lau/Texture.h>
+#include <trview.lau/drm.h>
+#include <array>
+
+using namespace trview;
+using namespace trview::lau;
+
+namespace
+{
+    void write_uint16(std::vector<uint8_t>& bytes, uint16_t value)
+    {
+        bytes.push_back(static_cast<uint8_t>(value));
+        bytes.push_back(static_cast<uint8_t>(value >> 8));
+    }
+
+    void write_uint32(std::vector<uint8_t>& bytes, uint32_t value)
+    {
+        write_uint16(bytes, static_cast<uint16_t>(value));
+        write_uint16(bytes, static_cast<uint16_t>(value >> 16));
+    }
+
+    /// Build the payload of a texture section - the PCD9 header followed by the pixel data.
+    std::vector<uint8_t> pcd9(uint32_t format, uint16_t width, uint16_t height, const std::vector<uint8_t>& pixels)
+    {
+        std::vector<uint8_t> bytes;
+        write_uint32(bytes, 0x39444350);
+        write_uint32(bytes, format);
+        write_uint32(bytes, static_cast<uint32_t>(pixels.size()));
+        write_uint32(bytes, 0);
+        write_uint16(bytes, width);
+        write_uint16(bytes, height);
+        write_uint32(bytes, 0);
+        bytes.insert(bytes.end(), pixels.begin(), pixels.end());
+        return bytes;
+    }
+
+    /// Create a texture section over the bytes, which must outlive the section.
+    Section texture_section(const std::vector<uint8_t>& bytes)
+    {
+        Section section{};
+        section.index = 7;
+        section.header.length = static_cast<uint32_t>(bytes.size());
+        section.header.type = SectionType::Texture;
+        section.data = trlevel::Span<uint8_t>(bytes);
+        return section;
+    }
+
+    std::vector<uint32_t> decode(uint32_t format, uint16_t width, uint16_t height, const std::vector<uint8_t>& pixels)
+    {
+        const auto bytes = pcd9(format, width, height, pixels);
+        return decode_texture(read_texture(texture_section(bytes)));
+    }
+
+    /// A DXT1 colour block. Each row of indices is one byte with the first pixel in the lowest bits.
+    std::vector<uint8_t> colour_block(uint16_t c0, uint16_t c1, const std::array<uint8_t, 4>& rows)
+    {
+        std::vector<uint8_t> block;
+        write_uint16(block, c0);
+        write_uint16(block, c1);
+        block.insert(block.end(), rows.begin(), rows.end());
+        return block;
+    }
+
+    const uint32_t DXT1 = static_cast<uint32_t>(TextureFormat::DXT1);
+    const uint32_t DXT5 = static_cast<uint32_t>(TextureFormat::DXT5);
+
+    const uint16_t Red565 = 0xf800;
+    const uint16_t Green565 = 0x07e0;
+    const uint16_t Blue565 = 0x001f;
+
+    // Decoded colours are stored as ABGR.
+    const uint32_t Red = 0xff0000ff;
+    const uint32_t Green = 0xff00ff00;
+    const uint32_t Blue = 0xffff0000;
+    const uint32_t White = 0xffffffff;
+
+    /// Row indices 0 1 2 3, 3 2 1 0, all 0 and all 3.
+    const std::array<uint8_t, 4> IndexRows{ 0xe4, 0x1b, 0x00, 0xff };
+    const std::array<uint8_t, 16> IndexPixels{ 0, 1, 2, 3, 3, 2, 1, 0, 0, 0, 0, 0, 3, 3, 3, 3 };
+}
+
+/// Tests that A8R8G8B8 textures have red and blue swapped.
+TEST(Texture, A8R8G8B8SwapsRedAndBlue)
+{
+    const auto output = decode(static_cast<uint32_t>(TextureFormat::A8R8G8B8), 2, 1,
+        { 0x10, 0x20, 0x30, 0x40, 0x01, 0x02, 0x03, 0x04 });
+    ASSERT_EQ(2u, output.size());
+    ASSERT_EQ(0x40102030u, output[0]);
+    ASSERT_EQ(0x04010203u, output[1]);
+}
+
+/// Tests that a DXT1 block with the first colour greater than the second interpolates two colours at thirds.
+TEST(Texture, DXT1FourColourBlock)
+{
+    const auto output = decode(DXT1, 4, 4, colour_block(Red565, Blue565, IndexRows));
+    const std::array<uint32_t, 4> palette{ Red, Blue, 0xff5500aa, 0xffaa0055 };
+    ASSERT_EQ(16u, output.size());
+    for (std::size_t i = 0; i < output.size(); ++i)
+    {
+        ASSERT_EQ(palette[IndexPixels[i]], output[i]) << "Pixel " << i;
+    }
+}
+
+/// Tests that a DXT1 block with the first colour not greater than the second uses the midpoint and transparent black.
+TEST(Texture, DXT1ThreeColourBlock)
+{
+    const auto output = decode(DXT1, 4, 4, colour_block(Blue565, Red565, IndexRows));
+    const std::array<uint32_t, 4> palette{ Blue, Red, 0xff7f007f, 0x00000000 };
+    ASSERT_EQ(16u, output.size());
+    for (std::size_t i = 0; i < output.size(); ++i)
+    {
+        ASSERT_EQ(palette[IndexPixels[i]], output[i]) << "Pixel " << i;
+    }
+}
+
+/// Tests that a DXT1 block with two equal colours is in the three colour mode.
+TEST(Texture, DXT1EqualColoursAreThreeColourBlock)
+{
+    const auto output = decode(DXT1, 4, 4, colour_block(Green565, Green565, IndexRows));
+    const std::array<uint32_t, 4> palette{ Green, Green, Green, 0x00000000 };
+    for (std::size_t i = 0; i < output.size(); ++i)
+    {
+        ASSERT_EQ(palette[IndexPixels[i]], output[i]) << "Pixel " << i;
+    }
+}
+
+/// Tests that DXT5 interpolates eight alpha values when the first alpha is greater than the second and six alpha
+/// values with 0 and 255 when it is not. The colour block never uses the transparent mode.
+TEST(Texture, DXT5AlphaBlocks)
+{
+    // Alpha indices 0 to 7 for the first eight pixels and again for the last eight pixels.
+    const std::vector<uint8_t> alpha_indices{ 0x88, 0xc6, 0xfa, 0x88, 0xc6, 0xfa };
+    const auto colour = colour_block(Blue565, Red565, { 0xe4, 0xe4, 0xe4, 0xe4 });
+
+    std::vector<uint8_t> pixels{ 255, 0 };
+    pixels.insert(pixels.end(), alpha_indices.begin(), alpha_indices.end());
+    pixels.insert(pixels.end(), colour.begin(), colour.end());
+    pixels.push_back(20);
+    pixels.push_back(220);
+    pixels.insert(pixels.end(), alpha_indices.begin(), alpha_indices.end());
+    pixels.insert(pixels.end(), colour.begin(), colour.end());
+
+    const auto output = decode(DXT5, 8, 4, pixels);
+    ASSERT_EQ(32u, output.size());
+
+    const std::array<std::array<uint32_t, 8>, 2> alpha
+    {{
+        { 255, 0, 218, 182, 145, 109, 72, 36 },
+        { 20, 220, 60, 100, 140, 180, 0, 255 }
+    }};
+    const std::array<uint32_t, 4> colours{ 0xff0000, 0x0000ff, 0xaa0055, 0x5500aa };
+    for (uint32_t y = 0; y < 4; ++y)
+    {
+        for (uint32_t x = 0; x < 8; ++x)
+        {
+            const uint32_t i = y * 4 + x % 4;
+            ASSERT_EQ(colours[i % 4] | alpha[x / 4][i % 8] << 24, output[y * 8 + x]) << "Pixel " << x << "," << y;
+        }
+    }
+}
+
+/// Tests that a DXT5 block with two equal alpha values uses the six alpha mode with 0 and 255.
+TEST(Texture, DXT5EqualAlphasAreSixAlphaBlock)
+{
+    std::vector<uint8_t> pixels{ 100, 100, 0x88, 0xc6, 0xfa, 0x88, 0xc6, 0xfa };
+    const auto colour = colour_block(Red565, Red565, { 0, 0, 0, 0 });
+    pixels.insert(pixels.end(), colour.begin(), colour.end());
+
+    const auto output = decode(DXT5, 4, 4, pixels);
+    const std::array<uint32_t, 8> alpha{ 100, 100, 100, 100, 100, 100, 0, 255 };
+    for (std::size_t i = 0; i < output.size(); ++i)
+    {
+        ASSERT_EQ((Red & 0x00ffffff) | alpha[i % 8] << 24, output[i]) << "Pixel " << i;
+    }
+}
+
+/// Tests that blocks on the right and bottom edges of a texture that is not a multiple of 4 are clipped.
+TEST(Texture, EdgeBlocksAreClipped)
+{
+    std::vector<uint8_t> pixels;
+    for (const auto c0 : { Red565, Green565, Blue565, uint16_t(0xffff) })
+    {
+        const auto block = colour_block(c0, 0, { 0, 0, 0, 0 });
+        pixels.insert(pixels.end(), block.begin(), block.end());
+    }
+
+    const auto output = decode(DXT1, 6, 5, pixels);
+    ASSERT_EQ(30u, output.size());
+
+    const std::array<uint32_t, 4> colours{ Red, Green, Blue, White };
+    for (uint32_t y = 0; y < 5; ++y)
+    {
+        for (uint32_t x = 0; x < 6; ++x)
+        {
+            ASSERT_EQ(colours[(y / 4) * 2 + x / 4], output[y * 6 + x]) << "Pixel " << x << "," << y;
+        }
+    }
+}
+
+/// Tests that a texture smaller than one block takes each row from the start of the block row.
+TEST(Texture, TextureSmallerThanBlock)
+{
+    const auto output = decode(DXT1, 2, 2, colour_block(Red565, Blue565, IndexRows));
+    ASSERT_EQ(4u, output.size());
+    ASSERT_EQ(Red, output[0]);
+    ASSERT_EQ(Blue, output[1]);
+    ASSERT_EQ(0xffaa0055u, output[2]);
+    ASSERT_EQ(0xff5500aau, output[3]);
+}
+
+/// Tests that the texture header is read and that the data is limited to the pixel data length.
+TEST(Texture, ReadTexture)
+{
+    auto bytes = pcd9(DXT5, 12, 4, std::vector<uint8_t>(48, 0));
+    bytes.resize(bytes.size() + 16, 0xcd);
+
+    const auto texture = read_texture(texture_section(bytes));
+    ASSERT_EQ(7u, texture.section);
+    ASSERT_EQ(TextureFormat::DXT5, texture.format);
+    ASSERT_EQ(12u, texture.width);
+    ASSERT_EQ(4u, texture.height);
+    ASSERT_EQ(48u, texture.data.size());
+    ASSERT_EQ(bytes.data() + 24, texture.data.data());
+}
+
+/// Tests that sections that are not valid textures are rejected.
+TEST(Texture, ReadTextureRejectsInvalidSections)
+{
+    const auto valid = pcd9(DXT1, 4, 4, std::vector<uint8_t>(8, 0));
+
+    auto not_texture = texture_section(valid);
+    not_texture.header.type = SectionType::WorldMesh;
+    ASSERT_THROW(read_texture(not_texture), std::runtime_error);
+
+    auto bad_magic = valid;
+    bad_magic[3] = '8';
+    ASSERT_THROW(read_texture(texture_section(bad_magic)), std::runtime_error);
+
+    const auto too_short = pcd9(DXT1, 8, 4, std::vector<uint8_t>(8, 0));
+    ASSERT_THROW(read_texture(texture_section(too_short)), std::runtime_error);
+
+    const auto unsupported = pcd9(1234, 4, 4, std::vector<uint8_t>(64, 0));
+    ASSERT_THROW(read_texture(texture_section(unsupported)), std::runtime_error);
+
+    const std::vector<uint8_t> truncated_header(valid.begin(), valid.begin() + 10);
+    ASSERT_THROW(read_texture(texture_section(truncated_header)), std::out_of_range);
+}
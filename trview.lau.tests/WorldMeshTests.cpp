@@ -0,0 +1,161 @@
+#include "gtest/gtest.h"
+#include <trview.lau/WorldMesh.h>
+#include <trview.lau/drm.h>
+
+using namespace trview;
+using namespace trview::lau;
+
+namespace
+{
+    void write_uint16(std::vector<uint8_t>& bytes, uint16_t value)
+    {
+        bytes.push_back(static_cast<uint8_t>(value));
+        bytes.push_back(static_cast<uint8_t>(value >> 8));
+    }
+
+    void write_uint32(std::vector<uint8_t>& bytes, uint32_t value)
+    {
+        write_uint16(bytes, static_cast<uint16_t>(value));
+        write_uint16(bytes, static_cast<uint16_t>(value >> 16));
+    }
+
+    /// Add a mesh header and its indices, padded to four bytes when there is an odd number of indices.
+    void write_mesh(std::vector<uint8_t>& bytes, const std::vector<uint16_t>& indices, uint32_t end_of_mesh)
+    {
+        write_uint32(bytes, static_cast<uint32_t>(indices.size()));
+        write_uint32(bytes, 0xffffffff);
+        for (uint16_t i = 0; i < 16; ++i)
+        {
+            write_uint16(bytes, i);
+        }
+        write_uint32(bytes, end_of_mesh);
+        for (const auto index : indices)
+        {
+            write_uint16(bytes, index);
+        }
+        if (indices.size() % 2)
+        {
+            write_uint16(bytes, 0);
+        }
+    }
+
+    /// Create a section over the bytes, which must outlive the section.
+    Section create_section(SectionType type, const std::vector<uint8_t>& bytes, uint32_t num_links = 0)
+    {
+        Section section{};
+        section.index = 3;
+        section.header.length = static_cast<uint32_t>(bytes.size());
+        section.header.type = type;
+        section.header.preamble = num_links * 8 * 32;
+        section.data = trlevel::Span<uint8_t>(bytes);
+        return section;
+    }
+
+    std::vector<uint16_t> to_vector(const trlevel::Span<uint16_t>& indices)
+    {
+        return std::vector<uint16_t>(indices.begin(), indices.end());
+    }
+}
+
+/// Tests that meshes with odd index counts are padded and that zeroes between meshes are skipped.
+TEST(WorldMesh, ReadMeshesWithPadding)
+{
+    std::vector<uint8_t> bytes;
+    write_mesh(bytes, { 1, 2, 3 }, 100);
+    bytes.resize(bytes.size() + 8, 0);
+    write_mesh(bytes, { 4, 5, 6, 7 }, 200);
+    write_mesh(bytes, { 8, 9, 10, 11, 12 }, 300);
+    bytes.resize(bytes.size() + 12, 0);
+    write_mesh(bytes, { 13 }, 400);
+
+    const auto meshes = read_world_meshes(create_section(SectionType::WorldMesh, bytes));
+    ASSERT_EQ(4u, meshes.size());
+    ASSERT_EQ(std::vector<uint16_t>({ 1, 2, 3 }), to_vector(meshes[0].indices));
+    ASSERT_EQ(std::vector<uint16_t>({ 4, 5, 6, 7 }), to_vector(meshes[1].indices));
+    ASSERT_EQ(std::vector<uint16_t>({ 8, 9, 10, 11, 12 }), to_vector(meshes[2].indices));
+    ASSERT_EQ(std::vector<uint16_t>({ 13 }), to_vector(meshes[3].indices));
+
+    const uint32_t expected_end[] = { 100, 200, 300, 400 };
+    for (std::size_t i = 0; i < meshes.size(); ++i)
+    {
+        ASSERT_EQ(meshes[i].indices.size(), meshes[i].header.num_indices);
+        ASSERT_EQ(0xffffffffu, meshes[i].header.separator);
+        ASSERT_EQ(15u, meshes[i].header.unknown[15]);
+        ASSERT_EQ(expected_end[i], meshes[i].header.end_of_mesh);
+    }
+}
+
+/// Tests that the indices are views of the section data rather than copies.
+TEST(WorldMesh, IndicesAreNotCopied)
+{
+    std::vector<uint8_t> bytes;
+    write_mesh(bytes, { 1, 2, 3 }, 0);
+    write_mesh(bytes, { 4, 5 }, 0);
+
+    const auto meshes = read_world_meshes(create_section(SectionType::WorldMesh, bytes));
+    ASSERT_EQ(2u, meshes.size());
+    ASSERT_EQ(reinterpret_cast<const uint16_t*>(bytes.data() + 44), meshes[0].indices.data());
+    ASSERT_EQ(reinterpret_cast<const uint16_t*>(bytes.data() + 44 + 8 + 44), meshes[1].indices.data());
+}
+
+/// Tests that meshes are read from after the link table of the section.
+TEST(WorldMesh, ReadMeshesAfterLinks)
+{
+    std::vector<uint8_t> bytes;
+    write_uint32(bytes, 5 << 3);
+    write_uint32(bytes, 0);
+    write_uint32(bytes, 6 << 3);
+    write_uint32(bytes, 0);
+    write_mesh(bytes, { 1, 2, 3, 4, 5, 6 }, 0);
+
+    const auto meshes = read_world_meshes(create_section(SectionType::WorldMesh, bytes, 2));
+    ASSERT_EQ(1u, meshes.size());
+    ASSERT_EQ(std::vector<uint16_t>({ 1, 2, 3, 4, 5, 6 }), to_vector(meshes[0].indices));
+}
+
+/// Tests that reading stops at data that does not have the mesh separator or that is too short to be a mesh header.
+TEST(WorldMesh, ReadMeshesStopsAtEnd)
+{
+    std::vector<uint8_t> bytes;
+    write_mesh(bytes, { 1, 2, 3 }, 0);
+    write_uint32(bytes, 3);
+    write_uint32(bytes, 0x12345678);
+    bytes.resize(bytes.size() + 36, 0xcd);
+
+    auto meshes = read_world_meshes(create_section(SectionType::WorldMesh, bytes));
+    ASSERT_EQ(1u, meshes.size());
+
+    std::vector<uint8_t> truncated;
+    write_mesh(truncated, { 1, 2, 3 }, 0);
+    write_uint32(truncated, 3);
+    write_uint32(truncated, 0xffffffff);
+    truncated.resize(truncated.size() + 20, 0);
+
+    meshes = read_world_meshes(create_section(SectionType::WorldMesh, truncated));
+    ASSERT_EQ(1u, meshes.size());
+
+    ASSERT_TRUE(read_world_meshes(create_section(SectionType::WorldMesh, {})).empty());
+}
+
+/// Tests that the world vertices are read from the payload and that a partial vertex at the end is ignored.
+TEST(WorldMesh, ReadWorldVertices)
+{
+    std::vector<uint8_t> bytes;
+    write_uint32(bytes, 1 << 3);
+    write_uint32(bytes, 0);
+    for (uint16_t v = 0; v < 2; ++v)
+    {
+        for (uint16_t i = 0; i < 10; ++i)
+        {
+            write_uint16(bytes, static_cast<uint16_t>(v * 100 + i));
+        }
+    }
+    bytes.resize(bytes.size() + 6, 0);
+
+    const auto vertices = read_world_vertices(create_section(SectionType::Section, bytes, 1));
+    ASSERT_EQ(2u, vertices.size());
+    ASSERT_EQ(0, vertices[0].x);
+    ASSERT_EQ(2, vertices[0].z);
+    ASSERT_EQ(105, vertices[1].nx);
+    ASSERT_EQ(109u, vertices[1].g);
+}
@@ -0,0 +1,134 @@
+#include "SectionGraph.h"
+#include "drm.h"
+
+#include <algorithm>
+#include <trview.common/ThreadPool.h>
+
+namespace trview
+{
+    namespace lau
+    {
+        namespace
+        {
+            trlevel::Span<uint32_t> row(const std::vector<uint32_t>& offsets, const std::vector<uint32_t>& edges, uint32_t index)
+            {
+                if (index + 1 >= offsets.size())
+                {
+                    return trlevel::Span<uint32_t>();
+                }
+                return trlevel::Span<uint32_t>(edges.data() + offsets[index], offsets[index + 1] - offsets[index]);
+            }
+        }
+
+        SectionGraph::SectionGraph(const std::vector<Section>& sections)
+        {
+            const uint32_t count = static_cast<uint32_t>(sections.size());
+
+            // Each section reads and sorts its own links, so the sections can be done at the same time.
+            std::vector<std::vector<uint32_t>> references(count);
+            parallel_for(ThreadPool::shared(), count, [&](std::size_t i)
+            {
+                auto& section_references = references[i];
+                const auto& section = sections[i];
+                section_references.reserve(section.num_links());
+                for (const auto& link : section.links())
+                {
+                    const uint32_t index = std::get<0>(link);
+                    if (index != 0 && index != i && index < count)
+                    {
+                        section_references.push_back(index);
+                    }
+                }
+                std::sort(section_references.begin(), section_references.end());
+                section_references.erase(std::unique(section_references.begin(), section_references.end()), section_references.end());
+            });
+
+            _types.reserve(count);
+            _offsets.reserve(count + 1);
+            _offsets.push_back(0);
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                _types.push_back(sections[i].header.type);
+                _offsets.push_back(_offsets.back() + static_cast<uint32_t>(references[i].size()));
+            }
+
+            _edges.resize(_offsets.back());
+            parallel_for(ThreadPool::shared(), count, [&](std::size_t i)
+            {
+                std::copy(references[i].begin(), references[i].end(), _edges.begin() + _offsets[i]);
+            });
+
+            // Visiting the sources in order means that each row of the reverse table is already sorted.
+            _reverse_offsets.assign(count + 1, 0);
+            for (uint32_t target : _edges)
+            {
+                ++_reverse_offsets[target + 1];
+            }
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                _reverse_offsets[i + 1] += _reverse_offsets[i];
+            }
+
+            _reverse_edges.resize(_edges.size());
+            std::vector<uint32_t> next(_reverse_offsets.begin(), _reverse_offsets.end() - 1);
+            for (uint32_t source = 0; source < count; ++source)
+            {
+                for (uint32_t target : row(_offsets, _edges, source))
+                {
+                    _reverse_edges[next[target]++] = source;
+                }
+            }
+        }
+
+        std::size_t SectionGraph::size() const
+        {
+            return _types.size();
+        }
+
+        trlevel::Span<uint32_t> SectionGraph::dependencies(uint32_t section) const
+        {
+            return row(_offsets, _edges, section);
+        }
+
+        trlevel::Span<uint32_t> SectionGraph::dependents(uint32_t section) const
+        {
+            return row(_reverse_offsets, _reverse_edges, section);
+        }
+
+        std::vector<uint32_t> SectionGraph::reachable(uint32_t section) const
+        {
+            std::vector<uint32_t> found;
+            if (section >= size())
+            {
+                return found;
+            }
+
+            std::vector<bool> visited(size());
+            visited[section] = true;
+            found.push_back(section);
+
+            // The result doubles as the queue - everything after 'next' has not had its dependencies added yet.
+            for (std::size_t next = 0; next < found.size(); ++next)
+            {
+                for (uint32_t dependency : dependencies(found[next]))
+                {
+                    if (!visited[dependency])
+                    {
+                        visited[dependency] = true;
+                        found.push_back(dependency);
+                    }
+                }
+            }
+
+            found.erase(found.begin());
+            return found;
+        }
+
+        std::vector<uint32_t> SectionGraph::reachable(uint32_t section, SectionType type) const
+        {
+            auto found = reachable(section);
+            found.erase(std::remove_if(found.begin(), found.end(), [&](uint32_t index) { return _types[index] != type; }), found.end());
+            return found;
+        }
+    }
+}
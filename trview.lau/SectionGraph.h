@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <trlevel/Span.h>
+
+namespace trview
+{
+    namespace lau
+    {
+        struct Section;
+        enum class SectionType : uint32_t;
+
+        /// The links between the sections of a DRM file. Each section's references are stored once in a
+        /// compressed sparse row table along with the reverse table, so queries do not have to read the links again.
+        class SectionGraph final
+        {
+        public:
+            /// Create an empty graph.
+            SectionGraph() = default;
+
+            /// Build the graph from the link tables of the sections. The sections are read in parallel.
+            /// Links to section 0, to the section itself or to sections that do not exist are ignored.
+            /// @param sections The sections of the DRM file.
+            explicit SectionGraph(const std::vector<Section>& sections);
+
+            /// Get the number of sections in the graph.
+            /// @returns The number of sections.
+            std::size_t size() const;
+
+            /// Get the sections that a section references. Each section appears once, in ascending order.
+            /// @param section The index of the section.
+            /// @returns The referenced sections.
+            trlevel::Span<uint32_t> dependencies(uint32_t section) const;
+
+            /// Get the sections that reference a section. Each section appears once, in ascending order.
+            /// @param section The index of the section.
+            /// @returns The sections that reference the section.
+            trlevel::Span<uint32_t> dependents(uint32_t section) const;
+
+            /// Find every section that a section depends on, directly or indirectly.
+            /// @param section The index of the section.
+            /// @returns The sections in breadth first order. The section itself is not included.
+            std::vector<uint32_t> reachable(uint32_t section) const;
+
+            /// Find every section of a type that a section depends on, directly or indirectly.
+            /// @param section The index of the section.
+            /// @param type The type of section to find.
+            /// @returns The matching sections in breadth first order.
+            std::vector<uint32_t> reachable(uint32_t section, SectionType type) const;
+        private:
+            std::vector<SectionType> _types;
+            std::vector<uint32_t> _offsets;
+            std::vector<uint32_t> _edges;
+            std::vector<uint32_t> _reverse_offsets;
+            std::vector<uint32_t> _reverse_edges;
+        };
+    }
+}
@@ -0,0 +1,229 @@
+#include "Texture.h"
+#include "drm.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <trview.common/ThreadPool.h>
+
+namespace trview
+{
+    namespace lau
+    {
+        namespace
+        {
+            /// 'PCD9' - the start of every texture section payload.
+            const uint32_t TextureMagic = 0x39444350;
+
+#pragma pack(push, 1)
+            struct TextureHeader
+            {
+                uint32_t magic;
+                TextureFormat format;
+                uint32_t pixel_data_length;
+                uint32_t unknown_1;
+                uint16_t width;
+                uint16_t height;
+                uint32_t unknown_2;
+            };
+#pragma pack(pop)
+
+            uint16_t read_uint16(const uint8_t* data)
+            {
+                return static_cast<uint16_t>(data[0] | data[1] << 8);
+            }
+
+            uint32_t read_uint32(const uint8_t* data)
+            {
+                return data[0] | data[1] << 8 | data[2] << 16 | static_cast<uint32_t>(data[3]) << 24;
+            }
+
+            uint32_t colour(uint32_t red, uint32_t green, uint32_t blue, uint32_t alpha)
+            {
+                return alpha << 24 | blue << 16 | green << 8 | red;
+            }
+
+            /// Expand a 565 colour to 8 bits per channel.
+            void expand(uint16_t value, uint32_t& red, uint32_t& green, uint32_t& blue)
+            {
+                red = (value >> 11) * 255 / 31;
+                green = ((value >> 5) & 0x3f) * 255 / 63;
+                blue = (value & 0x1f) * 255 / 31;
+            }
+
+            /// Decode the colour part of a DXT block into 16 pixels.
+            /// @param block The 8 bytes of colour data.
+            /// @param allow_transparent Whether the block can use the three colour mode with transparent black.
+            /// @param pixels The 16 decoded pixels.
+            void decode_colour_block(const uint8_t* block, bool allow_transparent, uint32_t pixels[16])
+            {
+                const uint16_t c0 = read_uint16(block);
+                const uint16_t c1 = read_uint16(block + 2);
+                uint32_t r0, g0, b0, r1, g1, b1;
+                expand(c0, r0, g0, b0);
+                expand(c1, r1, g1, b1);
+
+                uint32_t palette[4];
+                palette[0] = colour(r0, g0, b0, 255);
+                palette[1] = colour(r1, g1, b1, 255);
+                if (c0 > c1 || !allow_transparent)
+                {
+                    palette[2] = colour((2 * r0 + r1) / 3, (2 * g0 + g1) / 3, (2 * b0 + b1) / 3, 255);
+                    palette[3] = colour((r0 + 2 * r1) / 3, (g0 + 2 * g1) / 3, (b0 + 2 * b1) / 3, 255);
+                }
+                else
+                {
+                    palette[2] = colour((r0 + r1) / 2, (g0 + g1) / 2, (b0 + b1) / 2, 255);
+                    palette[3] = 0;
+                }
+
+                const uint32_t indices = read_uint32(block + 4);
+                for (int i = 0; i < 16; ++i)
+                {
+                    pixels[i] = palette[(indices >> (i * 2)) & 0x3];
+                }
+            }
+
+            /// Replace the alpha of 16 pixels with the values from a DXT5 alpha block.
+            void decode_alpha_block(const uint8_t* block, uint32_t pixels[16])
+            {
+                const uint32_t a0 = block[0];
+                const uint32_t a1 = block[1];
+                uint32_t alpha[8] = { a0, a1 };
+                if (a0 > a1)
+                {
+                    for (uint32_t i = 1; i < 7; ++i)
+                    {
+                        alpha[i + 1] = ((7 - i) * a0 + i * a1) / 7;
+                    }
+                }
+                else
+                {
+                    for (uint32_t i = 1; i < 5; ++i)
+                    {
+                        alpha[i + 1] = ((5 - i) * a0 + i * a1) / 5;
+                    }
+                    alpha[6] = 0;
+                    alpha[7] = 255;
+                }
+
+                uint64_t indices = 0;
+                for (int i = 0; i < 6; ++i)
+                {
+                    indices |= static_cast<uint64_t>(block[2 + i]) << (8 * i);
+                }
+
+                for (int i = 0; i < 16; ++i)
+                {
+                    pixels[i] = (pixels[i] & 0x00ffffff) | alpha[(indices >> (i * 3)) & 0x7] << 24;
+                }
+            }
+
+            std::size_t required_bytes(const Texture& texture)
+            {
+                const std::size_t blocks = ((texture.width + 3) / 4) * static_cast<std::size_t>((texture.height + 3) / 4);
+                switch (texture.format)
+                {
+                case TextureFormat::A8R8G8B8:
+                    return static_cast<std::size_t>(texture.width) * texture.height * 4;
+                case TextureFormat::DXT1:
+                    return blocks * 8;
+                case TextureFormat::DXT5:
+                    return blocks * 16;
+                }
+                return 0;
+            }
+
+            void decode_blocks(const Texture& texture, std::vector<uint32_t>& output)
+            {
+                const bool has_alpha = texture.format == TextureFormat::DXT5;
+                const std::size_t block_size = has_alpha ? 16 : 8;
+                const uint32_t blocks_wide = (texture.width + 3) / 4;
+                const uint32_t blocks_high = (texture.height + 3) / 4;
+
+                const uint8_t* block = texture.data.data();
+                uint32_t pixels[16];
+                for (uint32_t by = 0; by < blocks_high; ++by)
+                {
+                    for (uint32_t bx = 0; bx < blocks_wide; ++bx, block += block_size)
+                    {
+                        if (has_alpha)
+                        {
+                            decode_colour_block(block + 8, false, pixels);
+                            decode_alpha_block(block, pixels);
+                        }
+                        else
+                        {
+                            decode_colour_block(block, true, pixels);
+                        }
+
+                        // Blocks on the right and bottom edges can hang over the edge of the texture.
+                        const uint32_t width = std::min<uint32_t>(4, texture.width - bx * 4);
+                        const uint32_t height = std::min<uint32_t>(4, texture.height - by * 4);
+                        for (uint32_t y = 0; y < height; ++y)
+                        {
+                            std::memcpy(&output[(by * 4 + y) * texture.width + bx * 4], &pixels[y * 4], width * sizeof(uint32_t));
+                        }
+                    }
+                }
+            }
+        }
+
+        Texture read_texture(const Section& section)
+        {
+            if (section.header.type != SectionType::Texture)
+            {
+                throw std::runtime_error("Section is not a texture");
+            }
+
+            auto reader = section.reader();
+            const auto header = reader.read<TextureHeader>();
+            if (header.magic != TextureMagic)
+            {
+                throw std::runtime_error("Texture section does not start with PCD9");
+            }
+
+            Texture texture{ section.index, header.format, header.width, header.height };
+            texture.data = trlevel::Span<uint8_t>(reader.current(), std::min<std::size_t>(header.pixel_data_length, reader.size() - reader.position()));
+            const std::size_t required = required_bytes(texture);
+            if (!required && (texture.width && texture.height))
+            {
+                throw std::runtime_error("Texture format is not supported");
+            }
+            if (texture.data.size() < required)
+            {
+                throw std::runtime_error("Texture section is too short for its pixel data");
+            }
+            return texture;
+        }
+
+        std::vector<uint32_t> decode_texture(const Texture& texture)
+        {
+            std::vector<uint32_t> output(static_cast<std::size_t>(texture.width) * texture.height);
+            if (texture.format == TextureFormat::A8R8G8B8)
+            {
+                // Stored as BGRA, so red and blue have to be swapped to match the textiles.
+                for (std::size_t i = 0; i < output.size(); ++i)
+                {
+                    const uint32_t value = read_uint32(texture.data.data() + i * 4);
+                    output[i] = (value & 0xff00ff00) | (value & 0xff) << 16 | (value >> 16 & 0xff);
+                }
+            }
+            else
+            {
+                decode_blocks(texture, output);
+            }
+            return output;
+        }
+
+        std::vector<std::vector<uint32_t>> decode_textures(const Drm& drm, const std::vector<uint32_t>& sections)
+        {
+            std::vector<std::vector<uint32_t>> textures(sections.size());
+            parallel_for(ThreadPool::shared(), sections.size(), [&](std::size_t i)
+            {
+                textures[i] = decode_texture(read_texture(drm.sections.at(sections[i])));
+            });
+            return textures;
+        }
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <trlevel/Span.h>
+
+namespace trview
+{
+    namespace lau
+    {
+        struct Drm;
+        struct Section;
+
+        /// The pixel formats that texture sections can be stored in. The values are the Direct3D formats.
+        enum class TextureFormat : uint32_t
+        {
+            A8R8G8B8 = 21,
+            DXT1 = 0x31545844,
+            DXT5 = 0x35545844
+        };
+
+        /// A texture section. The pixel data is a view of the mapped file.
+        struct Texture
+        {
+            uint32_t section;
+            TextureFormat format;
+            uint16_t width;
+            uint16_t height;
+            trlevel::Span<uint8_t> data;
+        };
+
+        /// Read the header of a texture section. The pixel data is not copied or decoded.
+        /// @param section The texture section.
+        /// @returns The texture.
+        /// @remarks Throws std::runtime_error if the section is not a texture or the format is not supported.
+        Texture read_texture(const Section& section);
+
+        /// Decode the first mip level of a texture to 32 bit colour, in the same layout as the level textiles.
+        /// @param texture The texture to decode.
+        /// @returns The pixels, row by row.
+        std::vector<uint32_t> decode_texture(const Texture& texture);
+
+        /// Read and decode texture sections. The textures are decoded in parallel.
+        /// @param drm The DRM file that contains the sections.
+        /// @param sections The indices of the texture sections.
+        /// @returns The decoded pixels of each texture, in the same order as the sections.
+        std::vector<std::vector<uint32_t>> decode_textures(const Drm& drm, const std::vector<uint32_t>& sections);
+    }
+}
@@ -0,0 +1,99 @@
+#include "WorldMesh.h"
+#include "drm.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace trview
+{
+    namespace lau
+    {
+        namespace
+        {
+            const uint32_t MeshSeparator = 0xffffffff;
+
+            /// Whether there is another mesh at the reader position - each mesh header has the separator after the index count.
+            bool has_mesh(const trlevel::DataReader& reader)
+            {
+                if (reader.size() - reader.position() < sizeof(WorldMeshHeader))
+                {
+                    return false;
+                }
+                uint32_t separator = 0;
+                std::memcpy(&separator, reader.current() + sizeof(uint32_t), sizeof(separator));
+                return separator == MeshSeparator;
+            }
+        }
+
+        trlevel::Span<WorldVertex> read_world_vertices(const Section& section)
+        {
+            const auto payload = section.payload();
+            return trlevel::Span<WorldVertex>(reinterpret_cast<const WorldVertex*>(payload.data()), payload.size() / sizeof(WorldVertex));
+        }
+
+        std::vector<WorldMeshIndices> read_world_meshes(const Section& section)
+        {
+            std::vector<WorldMeshIndices> meshes;
+            auto reader = section.reader();
+            while (has_mesh(reader))
+            {
+                WorldMeshIndices mesh;
+                mesh.header = reader.read<WorldMeshHeader>();
+                const uint8_t* const indices = reader.current();
+                reader.skip(mesh.header.num_indices * sizeof(uint16_t));
+                mesh.indices = trlevel::Span<uint16_t>(reinterpret_cast<const uint16_t*>(indices), mesh.header.num_indices);
+                meshes.push_back(mesh);
+
+                // Index lists are padded to four bytes and then followed by zeroes up to the next mesh.
+                if (mesh.header.num_indices % 2)
+                {
+                    reader.skip(sizeof(uint16_t));
+                }
+                while (reader.size() - reader.position() >= sizeof(uint32_t) && reader.peek<uint32_t>() == 0)
+                {
+                    reader.skip(sizeof(uint32_t));
+                }
+            }
+            return meshes;
+        }
+
+        uint32_t find_world_vertices(const Drm& drm)
+        {
+            // Object models set the second flag and store their vertices in a different layout.
+            if (drm.file_header.flags[1])
+            {
+                throw std::runtime_error("DRM file does not contain a world model");
+            }
+
+            bool found_file_header = false;
+            for (const auto& section : drm.sections)
+            {
+                if (section.header.type != SectionType::Section)
+                {
+                    continue;
+                }
+                if (found_file_header)
+                {
+                    return section.index;
+                }
+                found_file_header = true;
+            }
+            throw std::runtime_error("DRM file does not contain a world vertex section");
+        }
+
+        WorldMesh load_world_mesh(const Drm& drm, const Section& section)
+        {
+            if (section.header.type != SectionType::WorldMesh)
+            {
+                throw std::runtime_error("Section is not a world mesh");
+            }
+
+            WorldMesh mesh;
+            mesh.section = section.index;
+            mesh.vertices = read_world_vertices(drm.sections[find_world_vertices(drm)]);
+            mesh.meshes = read_world_meshes(section);
+            mesh.textures = drm.graph.reachable(section.index, SectionType::Texture);
+            return mesh;
+        }
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <trlevel/Span.h>
+
+namespace trview
+{
+    namespace lau
+    {
+        struct Drm;
+        struct Section;
+
+#pragma pack(push, 1)
+        struct WorldVertex
+        {
+            int16_t x;
+            int16_t y;
+            int16_t z;
+            uint16_t a;
+            uint16_t b;
+            int16_t nx;
+            int16_t ny;
+            int16_t nz;
+            uint16_t f;
+            uint16_t g;
+        };
+
+        struct WorldMeshHeader
+        {
+            uint32_t num_indices;
+            uint32_t separator;
+            uint16_t unknown[16];
+            uint32_t end_of_mesh;
+        };
+#pragma pack(pop)
+
+        /// One of the meshes in a world mesh section. The indices are a view of the mapped file.
+        struct WorldMeshIndices
+        {
+            WorldMeshHeader header;
+            trlevel::Span<uint16_t> indices;
+        };
+
+        /// The geometry of a level. The vertices and indices are views of the mapped file, so the
+        /// mesh is only valid for as long as the Drm that it came from.
+        struct WorldMesh
+        {
+            uint32_t section;
+            trlevel::Span<WorldVertex> vertices;
+            std::vector<WorldMeshIndices> meshes;
+            /// The texture sections that the mesh references, directly or indirectly.
+            std::vector<uint32_t> textures;
+        };
+
+        /// Get the vertices in a world vertex section.
+        /// @param section The section that contains the vertices.
+        /// @returns The vertices. These are not copied.
+        trlevel::Span<WorldVertex> read_world_vertices(const Section& section);
+
+        /// Get the meshes in a world mesh section.
+        /// @param section The world mesh section.
+        /// @returns The meshes. The indices are not copied.
+        std::vector<WorldMeshIndices> read_world_meshes(const Section& section);
+
+        /// Find the section that contains the world vertices. This is the second section of type Section in a file
+        /// that contains a world model rather than an object model.
+        /// @param drm The DRM file to search.
+        /// @returns The index of the section.
+        /// @remarks Throws std::runtime_error if the file does not have world vertices.
+        uint32_t find_world_vertices(const Drm& drm);
+
+        /// Load a world mesh section along with the vertices and textures that it uses.
+        /// @param drm The DRM file that contains the section.
+        /// @param section The world mesh section.
+        /// @returns The world mesh.
+        WorldMesh load_world_mesh(const Drm& drm, const Section& section);
+    }
+}
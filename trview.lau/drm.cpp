@@ -1,6 +1,7 @@
 #include "drm.h"
-#include <fstream>
-#include <unordered_set>
+#include <algorithm>
+
+#include <trview.common/Strings.h>
 
 namespace trview
 {
@@ -8,112 +9,91 @@ namespace trview
     {
         namespace
         {
-            template < typename T >
-            void read(std::istream& file, T& value)
-            {
-                file.read(reinterpret_cast<char*>(&value), sizeof(value));
-            }
-
-            template <typename T>
-            T read(std::istream& file)
-            {
-                T value;
-                read<T>(file, value);
-                return value;
-            }
+            /// The size of an entry in the link table of a section.
+            const uint32_t LinkSize = 8;
 
-            template < typename DataType, typename SizeType >
-            std::vector<DataType> read_vector(std::istream& file, SizeType size)
+            void read_file_header(Drm& drm, const std::vector<Section>& sections)
             {
-                std::vector<DataType> data(size);
-                for (SizeType i = 0; i < size; ++i)
+                auto file_manifest = sections[0].reader();
+                for (int i = 0; i < 4; ++i)
                 {
-                    read<DataType>(file, data[i]);
+                    drm.file_header.flags[i] = file_manifest.read<uint16_t>();
                 }
-                return data;
-            }
-
-            void skip(std::istream& file, uint32_t size)
-            {
-                file.seekg(size, std::ios::cur);
+                drm.file_header.id = file_manifest.read<uint32_t>();
             }
+        }
 
-            std::vector<std::tuple<uint32_t, uint32_t>> get_links(const Section& section, std::istream& stream)
-            {
-                std::vector<std::tuple<uint32_t, uint32_t>> links;
-                for (auto i = 0u; i < section.header.preamble / 32 / 8; ++i)
-                {
-                    uint32_t referenced_section = read<uint32_t>(stream) >> 3;
-                    uint32_t value = read<uint32_t>(stream);
-                    links.push_back({ referenced_section, value });
-                }
-                return links;
-            }
+        uint32_t Section::num_links() const
+        {
+            return header.preamble / 32 / LinkSize;
+        }
 
-            std::vector<uint32_t> get_filtered_links(const Section& section, const std::vector<std::tuple<uint32_t, uint32_t>>& links, std::unordered_set<uint32_t>& visited_sections)
+        std::vector<std::tuple<uint32_t, uint32_t>> Section::links() const
+        {
+            trlevel::DataReader reader(data.data(), data.size());
+            std::vector<std::tuple<uint32_t, uint32_t>> links;
+            const uint32_t count = num_links();
+            links.reserve(count);
+            for (auto i = 0u; i < count; ++i)
             {
-                std::vector<uint32_t> filtered_links;
-                for (const auto& link : links)
-                {
-                    auto index = std::get<0>(link);
-                    if (index == 0 || visited_sections.find(index) != visited_sections.end() ||
-                        std::find(filtered_links.begin(), filtered_links.end(), index) != filtered_links.end())
-                    {
-                        continue;
-                    }
-                    filtered_links.push_back(index);
-                }
-                return filtered_links;
+                uint32_t referenced_section = reader.read<uint32_t>() >> 3;
+                uint32_t value = reader.read<uint32_t>();
+                links.push_back({ referenced_section, value });
             }
+            return links;
+        }
 
-            void read_file_header(Drm& drm, std::vector<Section>& sections)
-            {
-                auto& file_manifest_section = sections[0];
-                auto file_manifest = file_manifest_section.stream();
-                file_manifest_section.links = get_links(file_manifest_section, file_manifest);
+        trlevel::Span<uint8_t> Section::payload() const
+        {
+            const std::size_t link_bytes = std::min<std::size_t>(header.preamble / 32, data.size());
+            return trlevel::Span<uint8_t>(data.data() + link_bytes, data.size() - link_bytes);
+        }
 
-                for (int i = 0; i < 4; ++i)
-                {
-                    drm.file_header.flags[i] = read<uint16_t>(file_manifest);
-                }
-                drm.file_header.id = read<uint32_t>(file_manifest);
-            }
+        trlevel::DataReader Section::reader() const
+        {
+            const auto section_payload = payload();
+            return trlevel::DataReader(section_payload.data(), section_payload.size());
         }
 
         std::unique_ptr<Drm> load_drm(const std::wstring& filename)
         {
-            std::ifstream file(filename, std::ios::binary);
-            if (!file.is_open())
+            try
             {
-                return nullptr;
-            }
+                auto drm = std::make_unique<Drm>();
+                drm->file = std::make_unique<MappedFile>(to_utf8(filename));
 
-            auto drm = std::make_unique<Drm>();
-            drm->version = read<uint32_t>(file);
+                trlevel::DataReader reader(drm->file->data(), drm->file->size());
+                drm->version = reader.read<uint32_t>();
 
-            uint32_t num_sections = read<uint32_t>(file);
-            std::vector<SectionHeader> headers = read_vector<SectionHeader>(file, num_sections);
+                const uint32_t num_sections = reader.read<uint32_t>();
+                const std::vector<SectionHeader> headers = reader.read_vector<SectionHeader>(num_sections);
 
-            uint32_t section_index = 0;
-            for (const auto& header : headers)
-            {
-                const auto section_start = file.tellg();
-                std::vector<uint8_t> section_data(header.preamble / 32 + header.length);
-                file.read(reinterpret_cast<char*>(&section_data[0]), section_data.size());
-                drm->sections.emplace_back(Section{ section_index, header, section_data });
-                file.seekg(section_start);
-                file.seekg(section_data.size(), std::ios::cur);
-                ++section_index;
-            }
+                // Each section is a view of the mapped file, so finding the sections doesn't copy anything.
+                drm->sections.reserve(num_sections);
+                uint32_t section_index = 0;
+                for (const auto& header : headers)
+                {
+                    const std::size_t size = static_cast<std::size_t>(header.preamble / 32) + header.length;
+                    const uint8_t* const start = reader.current();
+                    reader.skip(size);
+                    drm->sections.push_back(Section{ section_index, header, trlevel::Span<uint8_t>(start, size) });
+                    ++section_index;
+                }
 
-            // Hopefully this never happens.
-            if (drm->sections.empty())
-            {
+                // Hopefully this never happens.
+                if (drm->sections.empty())
+                {
+                    return drm;
+                }
+
+                read_file_header(*drm, drm->sections);
+                drm->graph = SectionGraph(drm->sections);
                 return drm;
             }
-
-            read_file_header(*drm, drm->sections);
-            return drm;
+            catch (const std::exception&)
+            {
+                return nullptr;
+            }
         }
     }
 }
@@ -3,9 +3,13 @@
 #include <memory>
 #include <string>
 #include <cstdint>
+#include <tuple>
 #include <vector>
-#include <sstream>
-#include <unordered_map>
+
+#include <trlevel/DataReader.h>
+#include <trlevel/Span.h>
+#include <trview.common/MappedFile.h>
+#include "SectionGraph.h"
 
 namespace trview
 {
@@ -32,25 +36,37 @@ namespace trview
         {
             uint32_t length;
             SectionType type;
-            uint32_t preamble; // extra leading bits 
+            uint32_t preamble; // extra leading bits
             uint32_t id;
             uint32_t separator;
         };
 
 #pragma pack(pop)
 
+        /// A section of a DRM file. The section is a view of the mapped file and does not own any data,
+        /// so it is only valid for as long as the Drm that it came from.
         struct Section
         {
             uint32_t index;
             SectionHeader header;
-            std::vector<uint8_t> data;
-            std::vector<std::tuple<uint32_t, uint32_t>> links;
+            /// The section data, starting with the link table and followed by the payload.
+            trlevel::Span<uint8_t> data;
+
+            /// Get the number of entries in the link table at the start of the section.
+            /// @returns The number of links.
+            uint32_t num_links() const;
+
+            /// Read the link table. The links are read each time this is called rather than when the file is loaded.
+            /// @returns The index of the section referenced by each link and the value stored with it.
+            std::vector<std::tuple<uint32_t, uint32_t>> links() const;
+
+            /// Get the data after the link table.
+            /// @returns The payload of the section.
+            trlevel::Span<uint8_t> payload() const;
 
-            std::istringstream stream() const
-            {
-                std::string data(reinterpret_cast<const char*>(&data[0]), data.size());
-                return std::istringstream(data, std::ios::binary);
-            }
+            /// Create a reader over the payload of the section. No data is copied.
+            /// @returns The reader.
+            trlevel::DataReader reader() const;
         };
 
         struct Drm
@@ -58,8 +74,15 @@ namespace trview
             uint32_t version;
             FileHeader file_header;
             std::vector<Section> sections;
+            /// The links between the sections.
+            SectionGraph graph;
+            /// The mapped file that the sections are views of.
+            std::unique_ptr<MappedFile> file;
         };
 
+        /// Map a DRM file and find the sections in it. The section data is not copied.
+        /// @param filename The DRM file to load.
+        /// @returns The DRM, or null if the file could not be opened or is not a valid DRM file.
         std::unique_ptr<Drm> load_drm(const std::wstring& filename);
     }
 }
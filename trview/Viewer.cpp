@@ -25,6 +25,21 @@ namespace trview
     namespace
     {
         const float _CAMERA_MOVEMENT_SPEED_MULTIPLIER = 23.0f;
+
+        // Identify the build of the viewer by when the executable was written, so that cached levels
+        // are thrown away whenever the viewer is rebuilt or updated.
+        std::string viewer_build()
+        {
+            wchar_t path[MAX_PATH];
+            WIN32_FILE_ATTRIBUTE_DATA attributes;
+            if (!GetModuleFileName(nullptr, path, MAX_PATH) || !GetFileAttributesEx(path, GetFileExInfoStandard, &attributes))
+            {
+                return std::string();
+            }
+            return std::to_string(attributes.ftLastWriteTime.dwHighDateTime) + "." +
+                std::to_string(attributes.ftLastWriteTime.dwLowDateTime) + "." +
+                std::to_string(attributes.nFileSizeLow);
+        }
     }
 
     Viewer::Viewer(const Window& window)
@@ -41,6 +56,13 @@ namespace trview
         Resource type_list = get_resource_memory(IDR_TYPE_NAMES, L"TEXT");
         _type_name_lookup = std::make_unique<TypeNameLookup>(std::string(type_list.data, type_list.data + type_list.size));
 
+        const auto cache_directory = level_cache_directory();
+        const auto build = viewer_build();
+        if (!cache_directory.empty() && !build.empty())
+        {
+            _level_cache = std::make_unique<trlevel::LevelCache>(cache_directory, build);
+        }
+
         _shader_storage = std::make_unique<graphics::ShaderStorage>();
         load_default_shaders(_device, *_shader_storage.get());
 
@@ -558,10 +580,41 @@ namespace trview
 
     void Viewer::open(const std::string& filename)
     {
+        // Opening another level abandons any level that is still loading, which waits for its load to stop.
+        _pending_level.reset();
+
+        auto pending = std::make_unique<PendingLevel>();
+        pending->filename = filename;
+        pending->level = std::make_unique<Level>(_device, *_shader_storage.get());
+
+        // The viewer has no use for the sound samples, so don't spend time decompressing them.
+        trlevel::LoadOptions options;
+        options.sound_samples = false;
+
+        // The entry and the geometry are only written by the load and are read once it has finished.
+        auto loading = pending.get();
+        auto level_cache = _level_cache.get();
+        pending->stream = std::make_unique<trlevel::LevelStream>([=](const trlevel::LoadCallbacks& callbacks)
+        {
+            if (level_cache)
+            {
+                trlevel::LevelCache::Entry entry;
+                auto level = level_cache->load(filename, options, entry, loading->cached_geometry, callbacks);
+                loading->cache_entry = entry;
+                return level;
+            }
+            return trlevel::load_level(filename, options, callbacks);
+        });
+        _pending_level = std::move(pending);
+    }
+
+    void Viewer::open_pending_level()
+    {
+        auto pending = std::move(_pending_level);
         std::unique_ptr<trlevel::ILevel> new_level;
         try
         {
-            new_level = trlevel::load_level(filename);
+            new_level = pending->stream->level();
         }
         catch(...)
         {
@@ -569,12 +622,15 @@ namespace trview
             return;
         }
 
+        const auto& filename = pending->filename;
         on_file_loaded(filename);
         _settings.add_recent_file(filename);
         on_recent_files_changed(_settings.recent_files);
         save_user_settings(_settings);
 
-        _level = std::make_unique<Level>(_device, *_shader_storage.get(), std::move(new_level), *_type_name_lookup);
+        _level = std::move(pending->level);
+        _level->finish_loading(_device, std::move(new_level), *_type_name_lookup, pending->cached_geometry);
+        _level_cache_entry = pending->cache_entry;
         _token_store += _level->on_room_selected += [&](uint16_t room) { select_room(room); };
         _token_store += _level->on_alternate_mode_selected += [&](bool enabled) { set_alternate_mode(enabled); };
         _token_store += _level->on_alternate_group_selected += [&](uint16_t group, bool enabled) { set_alternate_group(group, enabled); };
@@ -648,6 +704,40 @@ namespace trview
         _timer.update();
         update_camera();
 
+        // The rooms of a level that is being opened are created as they are parsed, and the level replaces the
+        // open level once it has finished loading.
+        if (_pending_level)
+        {
+            _pending_level->stream->take_rooms([&](const auto& level, const auto& rooms)
+            {
+                _pending_level->level->load_rooms(level, rooms);
+            });
+
+            if (_pending_level->stream->finished())
+            {
+                open_pending_level();
+            }
+        }
+
+        // Rooms further from Lara get their geometry a few at a time so the level can be viewed while it finishes loading.
+        if (_level && _level->rooms_pending())
+        {
+            _level->generate_pending_rooms(_device, std::chrono::milliseconds(8));
+        }
+
+        // Once every room has been generated the geometry is stored with the level so that the next time the
+        // level is opened only the buffers have to be created. It is taken even without a cache so that it is freed.
+        // This waits while another level is loading, as the load is using the cache.
+        if (_level && !_level->rooms_pending() && !_pending_level)
+        {
+            auto geometry = _level->take_generated_geometry();
+            if (_level_cache_entry && !geometry.empty())
+            {
+                _level_cache->store_geometry(*_level_cache_entry, std::move(geometry));
+            }
+            _level_cache_entry.reset();
+        }
+
         if (_mouse_changed || _scene_changed)
         {
             _picking->pick(_window, current_camera());
@@ -8,6 +8,7 @@
 #include <Windows.h>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 
 #include <trview.common/Timer.h>
@@ -16,6 +17,8 @@
 #include <trview.input/Keyboard.h>
 #include <trview.input/Mouse.h>
 #include <trview.common/TokenStore.h>
+#include <trlevel/LevelCache.h>
+#include <trlevel/LevelStream.h>
 
 #include <trview.app/Camera/FreeCamera.h>
 #include <trview.app/Camera/OrbitCamera.h>
@@ -126,6 +129,7 @@ namespace trview
 
         void register_lua();
         void apply_acceleration_settings();
+        void open_pending_level();
 
         graphics::Device _device;
         Shortcuts _shortcuts;
@@ -134,6 +138,9 @@ namespace trview
         std::unique_ptr<TriggersWindowManager> _triggers_windows;
         std::unique_ptr<RoomsWindowManager> _rooms_windows;
         std::unique_ptr<Level> _level;
+        std::unique_ptr<trlevel::LevelCache> _level_cache;
+        // The cache entry for the open level, until the geometry built for the level has been stored in it.
+        std::optional<trlevel::LevelCache::Entry> _level_cache_entry;
         Window _window;
         Timer _timer;
         OrbitCamera _camera;
@@ -190,6 +197,21 @@ namespace trview
         std::size_t _recent_orbit_index{ 0u };
 
         LuaFunctionRegistry _lua_registry;
+
+        /// A level that is being opened. The level is loaded on the thread pool and its rooms are created as they
+        /// are parsed. It replaces the open level once it has finished loading.
+        struct PendingLevel
+        {
+            std::string filename;
+            std::optional<trlevel::LevelCache::Entry> cache_entry;
+            std::vector<uint8_t> cached_geometry;
+            std::unique_ptr<Level> level;
+            // Declared last so that the load is waited for before anything it writes to is destroyed.
+            std::unique_ptr<trlevel::LevelStream> stream;
+        };
+
+        // Declared last so that a level that is still loading is stopped before the level cache is destroyed.
+        std::unique_ptr<PendingLevel> _pending_level;
     };
 }
 